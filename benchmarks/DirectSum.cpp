@@ -0,0 +1,80 @@
+/**
+ * @file
+ *
+ * @brief Compare the direct sum force calculation using the type erased pair iteration with the tiled, vectorized and multithreaded kernels
+ * of the gravity and the Lennard-Jones calculator.
+ *
+ * Usage: DirectSum [particles] [repetitions]
+ *
+ * The particles of two types are placed on a slightly distorted cubic lattice, such that no two particles share their position.
+ */
+
+#include "physicsCalculator/GravityCalculator.h"
+#include "physicsCalculator/LJCalculator.h"
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <spdlog/spdlog.h>
+#include <string>
+#include <vector>
+
+/**
+ * Measure the average duration of a method in milliseconds.
+ *
+ * @param method The method which should be measured.
+ * @param repetitions The number of repetitions.
+ *
+ * @return The average duration in milliseconds.
+ */
+template <typename F> static double measure(const F& method, const int repetitions) {
+    const auto start_time = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < repetitions; i++) {
+        method();
+    }
+
+    const auto end_time = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time).count() / (1000000.0 * repetitions);
+}
+
+/**
+ * The main entry point for the benchmark.
+ */
+int main(const int argc, const char* argv[]) {
+    const int count = argc > 1 ? std::stoi(argv[1]) : 10000;
+    const int repetitions = argc > 2 ? std::stoi(argv[2]) : 5;
+
+    spdlog::set_level(spdlog::level::off);
+
+    const int edge = static_cast<int>(std::ceil(std::cbrt(count)));
+    std::vector<Particle> particles;
+
+    for (int i = 0; i < count; i++) {
+        const double distortion = 0.1 * std::sin(static_cast<double>(i));
+        particles.emplace_back(
+            Vec<double>(1.5 * (i % edge) + distortion, 1.5 * (i / edge % edge) - distortion, 1.5 * (i / (edge * edge)) + 0.5 * distortion),
+            Vec<double>(0.0, 0.0, 0.0), i % 2);
+    }
+
+    const std::vector<TypeDesc> types { TypeDesc { 1.0, 1.0, 5.0, 0.0005, 0.0 }, TypeDesc { 2.0, 1.2, 1.0, 0.0005, 0.0 } };
+
+    Environment env;
+    env.set_dimensions(3);
+
+    physicsCalculator::GravityCalculator gravity(env, particles, types, false);
+    physicsCalculator::LJCalculator lj(env, particles, types, false, true);
+
+    const double gravity_erased = measure([&gravity]() { gravity.physicsCalculator::Calculator::calculateF(); }, repetitions);
+    const double gravity_tiled = measure([&gravity]() { gravity.calculateF(); }, repetitions);
+    const double lj_erased = measure([&lj]() { lj.physicsCalculator::Calculator::calculateF(); }, repetitions);
+    const double lj_tiled = measure([&lj]() { lj.calculateF(); }, repetitions);
+
+    std::cout << "particles: " << particles.size() << ", repetitions: " << repetitions << std::endl;
+    std::cout << "gravity, std::function pair iteration: " << gravity_erased << " ms" << std::endl;
+    std::cout << "gravity, tiled kernel:                 " << gravity_tiled << " ms (speedup " << gravity_erased / gravity_tiled << ")" << std::endl;
+    std::cout << "LJ, std::function pair iteration:      " << lj_erased << " ms" << std::endl;
+    std::cout << "LJ, tiled kernel:                      " << lj_tiled << " ms (speedup " << lj_erased / lj_tiled << ")" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,136 @@
+/**
+ * @file
+ *
+ * @brief Compare the force calculation using the type erased pair iteration, the templated pair iteration over the particle vector, the
+ * templated pair iteration over the structure of arrays and the vectorized batch kernel of the Lennard-Jones calculator, both with the analytic
+ * and the tabulated Lennard-Jones forces.
+ *
+ * Usage: PairIteration [particles per edge] [repetitions] [skin] [sub cells] [dimensions]
+ *
+ * A two dimensional run uses a planar lattice with roughly the same number of particles as the cubic lattice.
+ */
+
+#include "ParticleGenerator.h"
+#include "container/BoxContainer.h"
+#include "physicsCalculator/LJCalculator.h"
+#include "physicsCalculator/TabulatedCalculator.h"
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <spdlog/spdlog.h>
+#include <string>
+
+/**
+ * Measure the average duration of a method in milliseconds.
+ *
+ * @param method The method which should be measured.
+ * @param repetitions The number of repetitions.
+ *
+ * @return The average duration in milliseconds.
+ */
+template <typename F> static double measure(const F& method, const int repetitions) {
+    const auto start_time = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < repetitions; i++) {
+        method();
+    }
+
+    const auto end_time = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time).count() / (1000000.0 * repetitions);
+}
+
+/**
+ * The main entry point for the benchmark.
+ */
+int main(const int argc, const char* argv[]) {
+    const int edge = argc > 1 ? std::stoi(argv[1]) : 20;
+    const int repetitions = argc > 2 ? std::stoi(argv[2]) : 20;
+    const double skin = argc > 3 ? std::stod(argv[3]) : 0.0;
+    const int sub_cells = argc > 4 ? std::stoi(argv[4]) : 1;
+    const int dimensions = argc > 5 ? std::stoi(argv[5]) : 3;
+
+    spdlog::set_level(spdlog::level::off);
+
+    // Create a lattice of particles in a domain with a margin of one lattice constant
+    const double h = 1.1225;
+    const int edge_xy = dimensions == 2 ? static_cast<int>(std::round(std::sqrt(edge * edge * edge))) : edge;
+    const int edge_z = dimensions == 2 ? 1 : edge;
+    const double size = (edge_xy + 1) * h;
+
+    Environment env;
+    env.set_r_cutoff(3.0);
+    env.set_domain_size({ size, size, (edge_z + 1) * h });
+    env.set_skin(skin);
+    env.set_sub_cells(sub_cells);
+    env.set_dimensions(dimensions);
+
+    physicsCalculator::LJCalculator generator(env, {}, {}, false, true);
+    ParticleGenerator gen;
+    generator.get_container().resize(edge_xy * edge_xy * edge_z);
+    gen.generateCuboid(
+        generator.get_container(), 0, { h / 2.0, h / 2.0, h / 2.0 }, { 0.0, 0.0, 0.0 }, 0, { edge_xy, edge_xy, edge_z }, h, 0.1, dimensions);
+
+    const std::vector<Particle> particles(generator.get_container().begin(), generator.get_container().end());
+    physicsCalculator::LJCalculator calc(env, particles, { TypeDesc { 1.0, 1.0, 5.0, 0.0005, 0.0 } }, false, false);
+    physicsCalculator::TabulatedCalculator tabulated(env, particles, { TypeDesc { 1.0, 1.0, 5.0, 0.0005, 0.0 } }, false, false);
+
+    // Warm up the caches
+    calc.calculateF();
+    tabulated.calculateF();
+
+    BoxContainer& box = dynamic_cast<BoxContainer&>(calc.get_container());
+
+    // Reuse the displacement and the squared distance of the cutoff test, like the type erased iteration of the calculator
+    const auto aos_kernel = [&calc](Particle& i, Particle& j, const Vec<double>& diff, const double dist_squ) {
+        const double force = calc.calculateFDist(dist_squ, i.getType(), j.getType());
+
+        i.setF(-force * diff + i.getF());
+        j.setF(force * diff + j.getF());
+    };
+
+    // Visit single index pairs of the structure of arrays, like the calculator did before the batch kernel
+    const auto soa_pairs = [&calc, &box]() {
+        ParticleSoA& soa = box.load_soa();
+        const double rc_squ = box.getRC() * box.getRC();
+
+        box.for_each_colored_candidate_pair([&soa, &calc, rc_squ](const size_t i, const size_t j) {
+            const double d_x = soa.x[j] - soa.x[i];
+            const double d_y = soa.y[j] - soa.y[i];
+            const double d_z = soa.z[j] - soa.z[i];
+            const double dist_squ = d_x * d_x + d_y * d_y + d_z * d_z;
+
+            if (dist_squ > rc_squ) {
+                return;
+            }
+
+            const double force = calc.physicsCalculator::LJCalculator::calculateFDist(dist_squ, soa.type[i], soa.type[j]);
+
+            soa.f_x[i] += force * d_x;
+            soa.f_y[i] += force * d_y;
+            soa.f_z[i] += force * d_z;
+            soa.f_x[j] -= force * d_x;
+            soa.f_y[j] -= force * d_y;
+            soa.f_z[j] -= force * d_z;
+        });
+
+        box.store_soa_forces();
+    };
+
+    const double erased = measure([&calc]() { calc.physicsCalculator::Calculator::calculateF(); }, repetitions);
+    const double inlined = measure([&box, &aos_kernel]() { box.for_each_pair(aos_kernel); }, repetitions);
+    const double soa = measure(soa_pairs, repetitions);
+    const double batched = measure([&calc]() { calc.calculateF(); }, repetitions);
+    const double spline = measure([&tabulated]() { tabulated.calculateF(); }, repetitions);
+
+    std::cout << "particles: " << particles.size() << ", repetitions: " << repetitions << ", skin: " << skin << ", sub cells: " << sub_cells
+              << ", dimensions: " << dimensions << std::endl;
+    std::cout << "std::function pair iteration (AoS): " << erased << " ms" << std::endl;
+    std::cout << "templated pair iteration (AoS):     " << inlined << " ms (speedup " << erased / inlined << ")" << std::endl;
+    std::cout << "templated pair iteration (SoA):     " << soa << " ms (speedup " << erased / soa << ")" << std::endl;
+    std::cout << "batch kernel (SoA, " << physicsCalculator::LJCalculator::get_simd_target() << "): " << batched << " ms (speedup "
+              << erased / batched << ")" << std::endl;
+    std::cout << "tabulated batch kernel (SoA):       " << spline << " ms (speedup " << erased / spline << ")" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,208 @@
+/**
+ * @file
+ *
+ * @brief Compare the mixed precision force kernels of the Lennard-Jones calculator with the double precision kernels. The report contains the
+ * force errors and the time of the force calculation for the setup of input/Assignment4/rayleigh-taylor-perft.xml and a cubic lattice, as well
+ * as the energy drift of an isolated cluster integrated in both precisions.
+ *
+ * Usage: Precision [steps] [repetitions] [particles per edge]
+ *
+ * The force errors are the largest and the root mean square deviation of the mixed precision forces, both relative to the respective norm of the
+ * double precision forces. The cluster is a cubic lattice with thermal velocities in an infinite domain, such that the direct sum conserves the
+ * sum of its kinetic and Lennard-Jones energy. The relative deviation of the total energy from its initial value is printed ten times.
+ */
+
+#include "ParticleGenerator.h"
+#include "physicsCalculator/LJCalculator.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <spdlog/spdlog.h>
+#include <string>
+#include <vector>
+
+/**
+ * Measure the average duration of a method in milliseconds.
+ *
+ * @param method The method which should be measured.
+ * @param repetitions The number of repetitions.
+ *
+ * @return The average duration in milliseconds.
+ */
+template <typename F> static double measure(const F& method, const int repetitions) {
+    const auto start_time = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < repetitions; i++) {
+        method();
+    }
+
+    const auto end_time = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time).count() / (1000000.0 * repetitions);
+}
+
+/**
+ * Compare the forces of both precisions and the time of their force calculation.
+ *
+ * @param name The name of the setup.
+ * @param env The simulation environment using double precision.
+ * @param particles The particles of the setup.
+ * @param types The particle types of the setup.
+ * @param repetitions The number of repetitions of the force calculation.
+ */
+static void compare_forces(const std::string& name, const Environment& env, const std::vector<Particle>& particles,
+    const std::vector<TypeDesc>& types, const int repetitions) {
+    Environment env_mixed = env;
+    env_mixed.set_precision(MIXED_PRECISION);
+
+    physicsCalculator::LJCalculator calc(env, particles, types, true, false);
+    physicsCalculator::LJCalculator calc_mixed(env_mixed, particles, types, true, false);
+
+    double max_force = 0.0, max_error = 0.0, sum_force = 0.0, sum_error = 0.0;
+
+    for (size_t i = 0; i < particles.size(); i++) {
+        const double force = calc.get_container()[i].getF().len();
+        const double error = (calc.get_container()[i].getF() - calc_mixed.get_container()[i].getF()).len();
+
+        max_force = std::max(max_force, force);
+        max_error = std::max(max_error, error);
+        sum_force += force * force;
+        sum_error += error * error;
+    }
+
+    const double time = measure([&calc]() { calc.calculateF(); }, repetitions);
+    const double time_mixed = measure([&calc_mixed]() { calc_mixed.calculateF(); }, repetitions);
+
+    std::cout << name << " (" << particles.size() << " particles):" << std::endl;
+    std::cout << "    max force error: " << max_error / max_force << ", rms force error: " << std::sqrt(sum_error / sum_force) << std::endl;
+    std::cout << "    double: " << time << " ms, mixed: " << time_mixed << " ms (speedup " << time / time_mixed << ")" << std::endl;
+}
+
+/**
+ * Get the total energy of an isolated cluster of particles of a single type.
+ *
+ * @param calc The calculator storing the particles.
+ * @param type The particle type.
+ *
+ * @return The sum of the kinetic and the Lennard-Jones energy.
+ */
+static double total_energy(physicsCalculator::LJCalculator& calc, const TypeDesc& type) {
+    ParticleContainer& cont = calc.get_container();
+    const double sigma_squ = type.get_sigma() * type.get_sigma();
+    double kinetic = 0.0, potential = 0.0;
+
+    for (size_t i = 0; i < cont.size(); i++) {
+        kinetic += 0.5 * type.get_mass() * cont[i].getV().len_squ();
+
+        for (size_t j = i + 1; j < cont.size(); j++) {
+            const double term_to_2 = sigma_squ / (cont[j].getX() - cont[i].getX()).len_squ();
+            const double term_to_6 = term_to_2 * term_to_2 * term_to_2;
+            potential += 4.0 * type.get_epsilon() * (term_to_6 * term_to_6 - term_to_6);
+        }
+    }
+
+    return kinetic + potential;
+}
+
+/**
+ * The main entry point for the benchmark.
+ */
+int main(const int argc, const char* argv[]) {
+    const int steps = argc > 1 ? std::stoi(argv[1]) : 10000;
+    const int repetitions = argc > 2 ? std::stoi(argv[2]) : 20;
+    const int edge = argc > 3 ? std::stoi(argv[3]) : 8;
+
+    spdlog::set_level(spdlog::level::off);
+
+    // Use the parameters of rayleigh-taylor-perft.xml
+    {
+        const double delta_t = 0.0005;
+        const double gravity = -12.44;
+        const double t_init = 40.0;
+
+        Environment env;
+        env.set_r_cutoff(2.5);
+        env.set_domain_size({ 300.0, 54.0, 7.5 });
+        env.set_delta_t(delta_t);
+        env.set_dimensions(2);
+
+        physicsCalculator::LJCalculator generator(env, {}, {}, false, true);
+        ParticleGenerator gen;
+        generator.get_container().resize(2 * 250 * 20);
+        gen.generateCuboid(generator.get_container(), 0, { 0.6, 2.0, 3.75 }, { 0.0, 0.0, 0.0 }, 0, { 250, 20, 1 }, 1.2, std::sqrt(t_init / 1.0), 2);
+        gen.generateCuboid(
+            generator.get_container(), 250 * 20, { 0.6, 27.0, 3.75 }, { 0.0, 0.0, 0.0 }, 1, { 250, 20, 1 }, 1.2, std::sqrt(t_init / 2.0), 2);
+
+        const std::vector<Particle> particles(generator.get_container().begin(), generator.get_container().end());
+        const std::vector<TypeDesc> types { TypeDesc { 1.0, 1.2, 1.0, delta_t, gravity }, TypeDesc { 2.0, 1.1, 1.0, delta_t, gravity } };
+
+        compare_forces("rayleigh-taylor-perft", env, particles, types, repetitions);
+    }
+
+    // Use a cubic lattice as in the pair iteration benchmark
+    {
+        const double h = 1.1225;
+        const int lattice_edge = 20;
+        const double size = (lattice_edge + 1) * h;
+
+        Environment env;
+        env.set_r_cutoff(3.0);
+        env.set_domain_size({ size, size, size });
+
+        physicsCalculator::LJCalculator generator(env, {}, {}, false, true);
+        ParticleGenerator gen;
+        generator.get_container().resize(lattice_edge * lattice_edge * lattice_edge);
+        gen.generateCuboid(generator.get_container(), 0, { h / 2.0, h / 2.0, h / 2.0 }, { 0.0, 0.0, 0.0 }, 0,
+            { lattice_edge, lattice_edge, lattice_edge }, h, 0.1, 3);
+
+        const std::vector<Particle> particles(generator.get_container().begin(), generator.get_container().end());
+
+        compare_forces("cubic lattice", env, particles, { TypeDesc { 1.0, 1.0, 5.0, 0.0005, 0.0 } }, repetitions);
+    }
+
+    // Integrate an isolated cluster in both precisions, the particles move without boundaries
+    const double delta_t = 0.0005;
+    const TypeDesc type { 1.0, 1.0, 5.0, delta_t, 0.0 };
+
+    Environment env;
+    env.set_delta_t(delta_t);
+
+    physicsCalculator::LJCalculator generator(env, {}, {}, false, true);
+    ParticleGenerator gen;
+    generator.get_container().resize(edge * edge * edge);
+    gen.generateCuboid(generator.get_container(), 0, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 }, 0, { edge, edge, edge }, 1.1225, 0.5, 3);
+
+    const std::vector<Particle> particles(generator.get_container().begin(), generator.get_container().end());
+
+    Environment env_mixed = env;
+    env_mixed.set_precision(MIXED_PRECISION);
+
+    physicsCalculator::LJCalculator calc(env, particles, { type });
+    physicsCalculator::LJCalculator calc_mixed(env_mixed, particles, { type });
+
+    std::cout << "energy drift of an isolated cluster (" << particles.size() << " particles, " << steps << " steps):" << std::endl;
+
+    const double initial_energy = total_energy(calc, type);
+    const double initial_energy_mixed = total_energy(calc_mixed, type);
+
+    for (int step = 1; step <= steps; step++) {
+        for (physicsCalculator::LJCalculator* c : { &calc, &calc_mixed }) {
+            c->integrateX([](Particle&) {});
+            c->calculateF();
+            c->integrateV([](Particle&) {});
+        }
+
+        if (step % std::max(steps / 10, 1) != 0) {
+            continue;
+        }
+
+        const double energy = total_energy(calc, type);
+        const double energy_mixed = total_energy(calc_mixed, type);
+
+        std::cout << "    step " << step << ": double " << (energy - initial_energy) / std::abs(initial_energy) << ", mixed "
+                  << (energy_mixed - initial_energy_mixed) / std::abs(initial_energy_mixed) << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,136 @@
+/**
+ * @file
+ *
+ * @brief Compare the steps of the stepper with the statically dispatched simulation engine for the setup of
+ * input/Assignment4/rayleigh-taylor-perft.xml and for a cubic lattice with periodic boundaries in all directions.
+ *
+ * Usage: Simulation [steps] [periodic ghosts]
+ *
+ * Both setups are integrated by the stepper and the engine, the time per step and the largest deviation of the positions are printed. The engine
+ * shares the floating point kernels with the stepper, such that the deviation is zero in every build mode.
+ */
+
+#include "ParticleGenerator.h"
+#include "Simulation.h"
+#include "boundaries/Stepper.h"
+#include "physicsCalculator/LJCalculator.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <spdlog/spdlog.h>
+#include <string>
+#include <vector>
+
+/**
+ * Measure the average duration of a method in milliseconds.
+ *
+ * @param method The method which should be measured.
+ * @param repetitions The number of repetitions.
+ *
+ * @return The average duration in milliseconds.
+ */
+template <typename F> static double measure(const F& method, const int repetitions) {
+    const auto start_time = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < repetitions; i++) {
+        method();
+    }
+
+    const auto end_time = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time).count() / (1000000.0 * repetitions);
+}
+
+/**
+ * Integrate a setup using the stepper and the engine and compare the time per step.
+ *
+ * @param name The name of the setup.
+ * @param env The simulation environment.
+ * @param particles The particles of the setup.
+ * @param types The particle types of the setup.
+ * @param steps The number of steps.
+ */
+static void compare_steps(
+    const std::string& name, const Environment& env, const std::vector<Particle>& particles, const std::vector<TypeDesc>& types, const int steps) {
+    physicsCalculator::LJCalculator calc_stepper(env, particles, types, true, false);
+    physicsCalculator::LJCalculator calc_engine(env, particles, types, true, false);
+
+    Stepper stepper(env.get_boundary_type(), env.get_domain_size(), env.get_periodic_ghosts());
+    const std::unique_ptr<Engine> engine = Engine::create(env, calc_engine);
+
+    const double time_stepper = measure([&]() { stepper.step(calc_stepper); }, steps);
+    const double time_engine = measure([&]() { engine->step(); }, steps);
+
+    double deviation = 0.0;
+
+    for (size_t i = 0; i < std::min(calc_stepper.get_container().size(), calc_engine.get_container().size()); i++) {
+        deviation = std::max(deviation, (calc_stepper.get_container()[i].getX() - calc_engine.get_container()[i].getX()).len());
+    }
+
+    std::cout << name << " (" << particles.size() << " particles):" << std::endl;
+    std::cout << "    stepper: " << time_stepper << " ms, engine: " << time_engine << " ms (speedup " << time_stepper / time_engine
+              << "), max deviation: " << deviation << std::endl;
+}
+
+/**
+ * The main entry point for the benchmark.
+ */
+int main(const int argc, const char* argv[]) {
+    const int steps = argc > 1 ? std::stoi(argv[1]) : 1000;
+    const bool ghosts = argc > 2 && std::stoi(argv[2]) != 0;
+
+    spdlog::set_level(spdlog::level::off);
+
+    // Use the parameters of rayleigh-taylor-perft.xml
+    {
+        const double delta_t = 0.0005;
+        const double gravity = -12.44;
+        const double t_init = 40.0;
+
+        Environment env;
+        env.set_r_cutoff(2.5);
+        env.set_domain_size({ 300.0, 54.0, 7.5 });
+        env.set_delta_t(delta_t);
+        env.set_dimensions(2);
+        env.set_boundary_type({ PERIODIC, HALO, HALO, PERIODIC, HALO, HALO });
+        env.set_periodic_ghosts(ghosts);
+
+        physicsCalculator::LJCalculator generator(env, {}, {}, false, true);
+        ParticleGenerator gen;
+        generator.get_container().resize(2 * 250 * 20);
+        gen.generateCuboid(generator.get_container(), 0, { 0.6, 2.0, 3.75 }, { 0.0, 0.0, 0.0 }, 0, { 250, 20, 1 }, 1.2, std::sqrt(t_init / 1.0), 2);
+        gen.generateCuboid(
+            generator.get_container(), 250 * 20, { 0.6, 27.0, 3.75 }, { 0.0, 0.0, 0.0 }, 1, { 250, 20, 1 }, 1.2, std::sqrt(t_init / 2.0), 2);
+
+        const std::vector<Particle> particles(generator.get_container().begin(), generator.get_container().end());
+        const std::vector<TypeDesc> types { TypeDesc { 1.0, 1.2, 1.0, delta_t, gravity }, TypeDesc { 2.0, 1.1, 1.0, delta_t, gravity } };
+
+        compare_steps("rayleigh-taylor-perft", env, particles, types, steps);
+    }
+
+    // Use a cubic lattice filling a periodic domain, such that the pairs across all faces, edges and corners interact
+    {
+        const double h = 1.1225;
+        const int edge = 20;
+        const double size = edge * h;
+
+        Environment env;
+        env.set_r_cutoff(3.0);
+        env.set_domain_size({ size, size, size });
+        env.set_delta_t(0.0005);
+        env.set_boundary_type({ PERIODIC, PERIODIC, PERIODIC, PERIODIC, PERIODIC, PERIODIC });
+        env.set_periodic_ghosts(ghosts);
+
+        physicsCalculator::LJCalculator generator(env, {}, {}, false, true);
+        ParticleGenerator gen;
+        generator.get_container().resize(edge * edge * edge);
+        gen.generateCuboid(generator.get_container(), 0, { h / 2.0, h / 2.0, h / 2.0 }, { 0.0, 0.0, 0.0 }, 0, { edge, edge, edge }, h, 0.5, 3);
+
+        const std::vector<Particle> particles(generator.get_container().begin(), generator.get_container().end());
+
+        compare_steps("periodic lattice", env, particles, { TypeDesc { 1.0, 1.0, 5.0, 0.0005, 0.0 } }, steps);
+    }
+
+    return 0;
+}
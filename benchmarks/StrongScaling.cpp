@@ -0,0 +1,120 @@
+/**
+ * @file
+ *
+ * @brief Measure the strong scaling of the simulation steps for the setup of input/Assignment4/rayleigh-taylor-perft.xml.
+ *
+ * Usage: StrongScaling [steps] [max threads] [periodic ghosts] [parallel strategy] [cell tasks] [balance threshold]
+ *
+ * The two cuboids of the input file are generated directly, such that the benchmark does not depend on the XML reader. The number of threads is
+ * doubled from one up to the maximum number of threads, which defaults to the number of threads OpenMP would use. A non zero third argument
+ * handles the periodic boundaries using ghost particles. The parallel strategy is either coloring (default), reduction or atomic. A non zero fifth
+ * argument executes blocks of cells as tasks. A non zero balance threshold partitions the cells by their measured cost for the reduction strategy,
+ * the mean imbalance of the thread times is reported for every number of threads.
+ */
+
+#include "ParticleGenerator.h"
+#include "boundaries/Stepper.h"
+#include "container/BoxContainer.h"
+#include "physicsCalculator/LJCalculator.h"
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <spdlog/spdlog.h>
+#include <string>
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/**
+ * The main entry point for the benchmark.
+ */
+int main(const int argc, const char* argv[]) {
+#ifdef _OPENMP
+    const int default_threads = omp_get_max_threads();
+#else
+    const int default_threads = 1;
+#endif
+
+    const int steps = argc > 1 ? std::stoi(argv[1]) : 1000;
+    const int max_threads = argc > 2 ? std::stoi(argv[2]) : default_threads;
+    const bool ghosts = argc > 3 && std::stoi(argv[3]) != 0;
+    const std::string strategy_name = argc > 4 ? argv[4] : "coloring";
+    const ParallelStrategy strategy = strategy_name == "reduction" ? REDUCTION : (strategy_name == "atomic" ? ATOMIC : COLORING);
+    const bool cell_tasks = argc > 5 && std::stoi(argv[5]) != 0;
+    const double balance = argc > 6 ? std::stod(argv[6]) : 0.0;
+
+    spdlog::set_level(spdlog::level::off);
+
+    // Use the parameters of rayleigh-taylor-perft.xml
+    const double delta_t = 0.0005;
+    const double gravity = -12.44;
+    const double t_init = 40.0;
+    const std::array<BoundaryType, 6> boundaries { PERIODIC, HALO, HALO, PERIODIC, HALO, HALO };
+
+    Environment env;
+    env.set_r_cutoff(2.5);
+    env.set_domain_size({ 300.0, 54.0, 7.5 });
+    env.set_delta_t(delta_t);
+    env.set_dimensions(2);
+    env.set_boundary_type(boundaries);
+    env.set_periodic_ghosts(ghosts);
+    env.set_parallel_strategy(strategy);
+    env.set_cell_tasks(cell_tasks);
+    env.set_balance(balance);
+
+    physicsCalculator::LJCalculator generator(env, {}, {}, false, true);
+    ParticleGenerator gen;
+    generator.get_container().resize(2 * 250 * 20);
+    gen.generateCuboid(generator.get_container(), 0, { 0.6, 2.0, 3.75 }, { 0.0, 0.0, 0.0 }, 0, { 250, 20, 1 }, 1.2, std::sqrt(t_init / 1.0), 2);
+    gen.generateCuboid(generator.get_container(), 250 * 20, { 0.6, 27.0, 3.75 }, { 0.0, 0.0, 0.0 }, 1, { 250, 20, 1 }, 1.2, std::sqrt(t_init / 2.0), 2);
+
+    const std::vector<Particle> particles(generator.get_container().begin(), generator.get_container().end());
+    const std::vector<TypeDesc> types { TypeDesc { 1.0, 1.2, 1.0, delta_t, gravity }, TypeDesc { 2.0, 1.1, 1.0, delta_t, gravity } };
+
+    std::cout << "particles: " << particles.size() << ", steps: " << steps << ", periodic ghosts: " << ghosts
+              << ", parallel strategy: " << strategy_name << ", cell tasks: " << cell_tasks
+              << ", balance threshold: " << balance << std::endl;
+
+    // Double the number of threads up to the maximum number of threads
+    std::vector<int> thread_counts;
+
+    for (int threads = 1; threads < max_threads; threads *= 2) {
+        thread_counts.push_back(threads);
+    }
+
+    thread_counts.push_back(max_threads);
+
+    double serial = 0.0;
+
+    for (const int threads : thread_counts) {
+#ifdef _OPENMP
+        omp_set_num_threads(threads);
+#endif
+
+        physicsCalculator::LJCalculator calc(env, particles, types, true, false);
+        Stepper stepper { boundaries, env.get_domain_size(), ghosts };
+
+        const auto start_time = std::chrono::steady_clock::now();
+
+        for (int i = 0; i < steps; i++) {
+            stepper.step(calc);
+        }
+
+        const auto end_time = std::chrono::steady_clock::now();
+        const double duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time).count() / (1000000.0 * steps);
+
+        if (threads == 1) {
+            serial = duration;
+        }
+
+        const auto& box = dynamic_cast<const BoxContainer&>(calc.get_container());
+
+        std::cout << "threads: " << threads << ", " << duration << " ms per step (speedup " << serial / duration << ", efficiency "
+                  << serial / duration / threads << ", imbalance " << box.get_mean_imbalance() << ", partitions " << box.get_rebalances() << ")"
+                  << std::endl;
+    }
+
+    return 0;
+}
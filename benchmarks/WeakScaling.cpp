@@ -0,0 +1,150 @@
+/**
+ * @file
+ *
+ * @brief Measure the weak scaling of the distributed mode, where every MPI rank simulates a subdomain of the same size.
+ *
+ * Usage: mpirun -np <ranks> WeakScaling [steps] [particles per direction] [dimensions]
+ *
+ * Every rank owns a cuboid of particles per direction ^ dimensions particles of a Lennard-Jones fluid, the global domain grows with the grid of
+ * ranks and is periodic in every simulated direction. Before the distributed run, every rank simulates a periodic domain of the size of a
+ * single subdomain on its own, which serves as the baseline of the weak scaling efficiency. Two dimensional simulations have reflecting z
+ * boundaries. Without MPI only the single rank is measured.
+ */
+
+#include "ParticleGenerator.h"
+#include "boundaries/Stepper.h"
+#include "container/DomainDecomposition.h"
+#include "physicsCalculator/LJCalculator.h"
+
+#include <chrono>
+#include <iostream>
+#include <spdlog/spdlog.h>
+#include <string>
+#include <vector>
+#ifdef MOLSIM_MPI
+#include <mpi.h>
+#endif
+
+/**
+ * Generate a cuboid of particles filling a domain with the given number of particles per direction.
+ *
+ * @param env The simulation environment storing the domain.
+ * @param count The number of particles in every simulated direction.
+ * @param spacing The distance between neighboring particles.
+ *
+ * @return The container storing the particles.
+ */
+static std::shared_ptr<BoxContainer> generate(const Environment& env, const std::array<int, 3>& count, const double spacing) {
+    auto cont = std::make_shared<BoxContainer>(env.get_r_cutoff(), env.get_domain_size());
+    ParticleGenerator gen;
+
+    cont->resize(count[0] * count[1] * count[2]);
+    const double z = env.get_dimensions() == 2 ? 0.5 * env.get_domain_size()[2] : 0.5 * spacing;
+    gen.generateCuboid(*cont, 0, { 0.5 * spacing, 0.5 * spacing, z }, { 0.0, 0.0, 0.0 }, 0, count, spacing, 0.5, env.get_dimensions());
+    cont->build_type_table({ TypeDesc { 1.0, 1.0, 5.0, env.get_delta_t(), 0.0 } });
+
+    return cont;
+}
+
+/**
+ * Run the given number of steps and measure the time per step of the slowest rank.
+ *
+ * @param env The simulation environment storing the global domain.
+ * @param global The container storing all particles of the global domain.
+ * @param decomposition The decomposition of the domain.
+ * @param steps The number of steps.
+ *
+ * @return The time per step in milliseconds.
+ */
+static double run(const Environment& env, ParticleContainer& global, DomainDecomposition& decomposition, const int steps) {
+    const std::shared_ptr<BoxContainer> cont = decomposition.create_container(global, env);
+    physicsCalculator::LJCalculator calc(decomposition.create_environment(env), cont);
+    Stepper stepper(decomposition);
+
+    decomposition.calculate_forces(calc);
+
+#ifdef MOLSIM_MPI
+    MPI_Barrier(MPI_COMM_WORLD);
+#endif
+
+    const auto start_time = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < steps; i++) {
+        stepper.step(calc);
+    }
+
+    const auto end_time = std::chrono::steady_clock::now();
+    double duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time).count() / (1000000.0 * steps);
+
+#ifdef MOLSIM_MPI
+    MPI_Allreduce(MPI_IN_PLACE, &duration, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+#endif
+
+    return duration;
+}
+
+/**
+ * The main entry point for the benchmark.
+ */
+int main(int argc, char* argv[]) {
+#ifdef MOLSIM_MPI
+    MPI_Init(&argc, &argv);
+#endif
+
+    const int steps = argc > 1 ? std::stoi(argv[1]) : 200;
+    const int per_direction = argc > 2 ? std::stoi(argv[2]) : 40;
+    const size_t dimensions = argc > 3 ? std::stoul(argv[3]) : 2;
+
+    spdlog::set_level(spdlog::level::off);
+
+    const double spacing = 1.12;
+    const double width = per_direction * spacing;
+
+    Environment env;
+    env.set_r_cutoff(2.5);
+    env.set_delta_t(0.0005);
+    env.set_dimensions(dimensions);
+    env.set_distributed(true);
+
+    if (dimensions == 2) {
+        env.set_boundary_type({ PERIODIC, PERIODIC, HALO, PERIODIC, PERIODIC, HALO });
+    } else {
+        env.set_boundary_type({ PERIODIC, PERIODIC, PERIODIC, PERIODIC, PERIODIC, PERIODIC });
+    }
+
+    // The baseline simulates a single subdomain on every rank independently
+    const double depth = dimensions == 2 ? 3.0 * env.get_r_cutoff() : width;
+    env.set_domain_size({ width, width, depth });
+    const std::array<int, 3> single_count = { per_direction, per_direction, dimensions == 2 ? 1 : per_direction };
+    const std::shared_ptr<BoxContainer> single = generate(env, single_count, spacing);
+    DomainDecomposition single_decomposition(env, { 1, 1, 1 }, 0);
+    const double baseline = run(env, *single, single_decomposition, steps);
+
+    // Grow the global domain with the grid of ranks
+    int ranks = 1;
+
+#ifdef MOLSIM_MPI
+    MPI_Comm_size(MPI_COMM_WORLD, &ranks);
+#endif
+
+    const std::array<int, 3> grid = DomainDecomposition::create_grid(ranks, dimensions);
+    const std::array<int, 3> global_count = { grid[0] * single_count[0], grid[1] * single_count[1], grid[2] * single_count[2] };
+
+    env.set_domain_size({ grid[0] * width, grid[1] * width, dimensions == 2 ? depth : grid[2] * width });
+    const std::shared_ptr<BoxContainer> global = generate(env, global_count, spacing);
+    DomainDecomposition decomposition(env);
+    const double distributed = run(env, *global, decomposition, steps);
+
+    if (decomposition.get_rank() == 0) {
+        std::cout << "ranks: " << decomposition.get_size() << " (" << grid[0] << " x " << grid[1] << " x " << grid[2]
+                  << "), particles per rank: " << single->size() << ", steps: " << steps << std::endl;
+        std::cout << "single subdomain: " << baseline << " ms per step, distributed: " << distributed << " ms per step (efficiency "
+                  << baseline / distributed << ")" << std::endl;
+    }
+
+#ifdef MOLSIM_MPI
+    MPI_Finalize();
+#endif
+
+    return 0;
+}
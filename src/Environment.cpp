@@ -76,9 +76,94 @@ Environment::Environment(const int argc, const char* argv[]) {
             std::cout << std::endl;
             std::cout << "    -calc=<force model>" << std::endl;
             std::cout << "        Set the force calculation of the program to a force model." << std::endl;
-            std::cout << "        The force model can either be gravity or lj (lenard jones)." << std::endl;
+            std::cout << "        The force model can either be gravity, lj (lenard jones) or tabulated" << std::endl;
+            std::cout << "        (forces interpolated from cubic spline tables of the type pairs)." << std::endl;
             std::cout << "        The default force model is lj." << std::endl;
             std::cout << std::endl;
+            std::cout << "    -table=<table file>" << std::endl;
+            std::cout << "        Read the forces of the tabulated force model from a file, whose lines" << std::endl;
+            std::cout << "        contain a type pair, a distance and the force at this distance. Type" << std::endl;
+            std::cout << "        pairs missing in the file use the lenard jones forces. By default the" << std::endl;
+            std::cout << "        lenard jones forces of all type pairs are tabulated." << std::endl;
+            std::cout << std::endl;
+            std::cout << "    -precision=<precision>" << std::endl;
+            std::cout << "        Set the floating point precision of the lenard jones and tabulated force" << std::endl;
+            std::cout << "        kernels to double or mixed (positions and pair forces in single precision," << std::endl;
+            std::cout << "        forces accumulated in double precision). The default precision is double." << std::endl;
+            std::cout << std::endl;
+            std::cout << "    -skin=<skin>" << std::endl;
+            std::cout << "        Set the skin added to the cutoff radius for the verlet neighbor lists." << std::endl;
+            std::cout << "        The skin must be a positive floating point number. A skin of 0.0" << std::endl;
+            std::cout << "        disables the verlet lists and rebuilds the linked cells every step." << std::endl;
+            std::cout << "        The default skin is 0.0." << std::endl;
+            std::cout << std::endl;
+            std::cout << "    -reorder=<reorder>" << std::endl;
+            std::cout << "        Reorder the particles in the order of the linked cells every time the" << std::endl;
+            std::cout << "        cells are rebuilt, such that the particles of every cell are stored" << std::endl;
+            std::cout << "        contiguously. The reorder option can either be on or off." << std::endl;
+            std::cout << "        The default is off." << std::endl;
+            std::cout << std::endl;
+            std::cout << "    -sort_interval=<sort interval>" << std::endl;
+            std::cout << "        Set after how many steps the particles should be sorted along a Morton" << std::endl;
+            std::cout << "        (Z-order) curve, such that close particles are stored close in memory." << std::endl;
+            std::cout << "        The sort interval must be a positive integer. A sort interval of 0" << std::endl;
+            std::cout << "        disables the sorting. The default sort interval is 0." << std::endl;
+            std::cout << std::endl;
+            std::cout << "    -periodic_ghosts=<periodic ghosts>" << std::endl;
+            std::cout << "        Handle the periodic boundaries by copying the periodic images of the" << std::endl;
+            std::cout << "        boundary particles into the halo cells, such that a single pair" << std::endl;
+            std::cout << "        traversal computes all forces. The option can either be on or off" << std::endl;
+            std::cout << "        and must not be combined with a skin. The default is off." << std::endl;
+            std::cout << std::endl;
+            std::cout << "    -threads=<threads>" << std::endl;
+            std::cout << "        Set the number of threads used for the force calculation. The number" << std::endl;
+            std::cout << "        of threads must be a strictly positive integer. By default OpenMP" << std::endl;
+            std::cout << "        decides the number of threads (e.g. using OMP_NUM_THREADS)." << std::endl;
+            std::cout << std::endl;
+            std::cout << "    -parallel=<parallel strategy>" << std::endl;
+            std::cout << "        Set how the threads avoid races during the force calculation either to" << std::endl;
+            std::cout << "        'coloring' (process cells with disjoint neighborhoods concurrently) or" << std::endl;
+            std::cout << "        'reduction' (accumulate the forces in thread local buffers, which are" << std::endl;
+            std::cout << "        added up afterwards) or 'atomic' (any thread processes any cell pair" << std::endl;
+            std::cout << "        and adds the forces atomically). The default strategy is coloring." << std::endl;
+            std::cout << std::endl;
+            std::cout << "    -cell_tasks=<cell tasks>" << std::endl;
+            std::cout << "        Group the cells into blocks of similar cost, which are executed as" << std::endl;
+            std::cout << "        OpenMP tasks, such that idle threads pick up the remaining blocks. This" << std::endl;
+            std::cout << "        balances inhomogeneous particle distributions. The option can either be" << std::endl;
+            std::cout << "        on or off. The default is off." << std::endl;
+            std::cout << std::endl;
+            std::cout << "    -balance=<threshold>" << std::endl;
+            std::cout << "        Assign a contiguous range of cells along a Morton curve to every thread" << std::endl;
+            std::cout << "        and measure the time of every thread. Whenever the imbalance (maximum" << std::endl;
+            std::cout << "        divided by mean thread time minus one) exceeds the threshold, the" << std::endl;
+            std::cout << "        ranges are cut again using the measured times. The threshold must be a" << std::endl;
+            std::cout << "        positive floating point number and requires the reduction strategy." << std::endl;
+            std::cout << "        A threshold of 0.0 disables the balancing. The default is 0.0." << std::endl;
+            std::cout << std::endl;
+            std::cout << "    -distributed=<distributed>" << std::endl;
+            std::cout << "        Split the domain into one subdomain per MPI rank, which exchange the" << std::endl;
+            std::cout << "        particles close to the subdomain faces every step. Run the program" << std::endl;
+            std::cout << "        using mpirun -np <ranks>. The option can either be on or off and must" << std::endl;
+            std::cout << "        not be combined with a skin. The default is off." << std::endl;
+            std::cout << std::endl;
+            std::cout << "    -numa=<numa>" << std::endl;
+            std::cout << "        Move the pages of the particles and the linked cells to the NUMA nodes" << std::endl;
+            std::cout << "        of the threads using them, by touching them again in parallel after" << std::endl;
+            std::cout << "        reading the input. The option can either be on or off and should be" << std::endl;
+            std::cout << "        combined with the thread pinning. The default is off." << std::endl;
+            std::cout << std::endl;
+            std::cout << "    -pinning=<pinning>" << std::endl;
+            std::cout << "        Pin the threads to the cpus of the NUMA nodes read from /sys. The" << std::endl;
+            std::cout << "        pinning can either be off, compact (fill one node after another) or" << std::endl;
+            std::cout << "        scatter (place consecutive threads on different nodes). The default" << std::endl;
+            std::cout << "        is off." << std::endl;
+            std::cout << std::endl;
+            std::cout << "    -huge_pages=<huge pages>" << std::endl;
+            std::cout << "        Back the arrays placed by the NUMA mode with transparent huge pages." << std::endl;
+            std::cout << "        The option can either be on or off and requires the NUMA mode." << std::endl;
+            std::cout << "        The default is off." << std::endl;
+            std::cout << std::endl;
             std::cout << "Each argument may only be provided once. If no argument is provided the default" << std::endl;
             std::cout << "value is being used. There may not be any blank spaces separating the option" << std::endl;
             std::cout << "and its value. The output files will be placed in the folder, from where the" << std::endl;
@@ -105,6 +190,20 @@ Environment::Environment(const int argc, const char* argv[]) {
     bool default_file_format = true;
     bool default_log_level = true;
     bool default_calculator = true;
+    bool default_table = true;
+    bool default_precision = true;
+    bool default_skin = true;
+    bool default_reorder = true;
+    bool default_sort_interval = true;
+    bool default_periodic_ghosts = true;
+    bool default_threads = true;
+    bool default_parallel = true;
+    bool default_cell_tasks = true;
+    bool default_balance = true;
+    bool default_distributed = true;
+    bool default_numa = true;
+    bool default_pinning = true;
+    bool default_huge_pages = true;
 
     // Parse all arguments but help.
     for (int i = 1; i < argc; i++) {
@@ -360,6 +459,311 @@ Environment::Environment(const int argc, const char* argv[]) {
             calc = LJ_FULL;
 
             default_calculator = false;
+        } else if (std::strcmp(argv[i], "-calc=tabulated") == 0) {
+            // Parse the calculator type
+            if (default_calculator == false) {
+                panic_exit("The option calc was provided multiple times. Options may only be provided once.");
+            }
+
+            calc = TABULATED;
+
+            default_calculator = false;
+        } else if (std::strncmp(argv[i], "-table=", std::strlen("-table=")) == 0) {
+            // Parse the name of the table file
+            if (default_table == false) {
+                panic_exit("The option table was provided multiple times. Options may only be provided once.");
+            }
+
+            if (std::strlen(argv[i] + std::strlen("-table=")) == 0) {
+                panic_exit("The length of the table file name must not be zero.");
+            }
+
+            table_file = argv[i] + std::strlen("-table=");
+
+            default_table = false;
+        } else if (std::strcmp(argv[i], "-precision=double") == 0) {
+            // Parse the precision of the force kernels
+            if (default_precision == false) {
+                panic_exit("The option precision was provided multiple times. Options may only be provided once.");
+            }
+
+            precision = DOUBLE_PRECISION;
+
+            default_precision = false;
+        } else if (std::strcmp(argv[i], "-precision=mixed") == 0) {
+            // Parse the precision of the force kernels
+            if (default_precision == false) {
+                panic_exit("The option precision was provided multiple times. Options may only be provided once.");
+            }
+
+            precision = MIXED_PRECISION;
+
+            default_precision = false;
+        } else if (std::strncmp(argv[i], "-skin=", std::strlen("-skin=")) == 0) {
+            // Parse the verlet list skin
+            if (default_skin == false) {
+                panic_exit("The option skin was provided multiple times. Options may only be provided once.");
+            }
+
+            size_t idx = 0;
+
+            try {
+                skin = std::stod(argv[i] + std::strlen("-skin="), &idx);
+            } catch (const std::exception& e) {
+                panic_exit("The option skin requires a floatingpoint number within the region of a 64 bit float.");
+            }
+
+            if (argv[i][idx + std::strlen("-skin=")] != 0) {
+                panic_exit("The option skin must only have one floating point number as input.");
+            }
+
+            if (skin < 0.0) {
+                panic_exit("The option skin must have a positive value.");
+            }
+
+            if (std::isnan(skin) || std::isinf(skin)) {
+                panic_exit("The option skin must be a valid number, not NAN or INF.");
+            }
+
+            default_skin = false;
+        } else if (std::strcmp(argv[i], "-reorder=on") == 0) {
+            // Parse the particle reordering
+            if (default_reorder == false) {
+                panic_exit("The option reorder was provided multiple times. Options may only be provided once.");
+            }
+
+            reorder = true;
+
+            default_reorder = false;
+        } else if (std::strcmp(argv[i], "-reorder=off") == 0) {
+            // Parse the particle reordering
+            if (default_reorder == false) {
+                panic_exit("The option reorder was provided multiple times. Options may only be provided once.");
+            }
+
+            reorder = false;
+
+            default_reorder = false;
+        } else if (std::strncmp(argv[i], "-sort_interval=", std::strlen("-sort_interval=")) == 0) {
+            // Parse the sort interval
+            if (default_sort_interval == false) {
+                panic_exit("The option sort_interval was provided multiple times. Options may only be provided once.");
+            }
+
+            size_t idx = 0;
+
+            try {
+                sort_interval = std::stoi(argv[i] + std::strlen("-sort_interval="), &idx);
+            } catch (const std::exception& e) {
+                panic_exit("The option sort_interval requires an integer small enough to fit into an int.");
+            }
+
+            if (argv[i][idx + std::strlen("-sort_interval=")] != 0) {
+                panic_exit("The option sort_interval must only have one integer as input.");
+            }
+
+            if (sort_interval < 0) {
+                panic_exit("The option sort_interval must have a positive value.");
+            }
+
+            default_sort_interval = false;
+        } else if (std::strcmp(argv[i], "-periodic_ghosts=on") == 0) {
+            // Parse the periodic ghost particles
+            if (default_periodic_ghosts == false) {
+                panic_exit("The option periodic_ghosts was provided multiple times. Options may only be provided once.");
+            }
+
+            periodic_ghosts = true;
+
+            default_periodic_ghosts = false;
+        } else if (std::strcmp(argv[i], "-periodic_ghosts=off") == 0) {
+            // Parse the periodic ghost particles
+            if (default_periodic_ghosts == false) {
+                panic_exit("The option periodic_ghosts was provided multiple times. Options may only be provided once.");
+            }
+
+            periodic_ghosts = false;
+
+            default_periodic_ghosts = false;
+        } else if (std::strncmp(argv[i], "-threads=", std::strlen("-threads=")) == 0) {
+            // Parse the number of threads
+            if (default_threads == false) {
+                panic_exit("The option threads was provided multiple times. Options may only be provided once.");
+            }
+
+            size_t idx = 0;
+            int new_threads = 0;
+
+            try {
+                new_threads = std::stoi(argv[i] + std::strlen("-threads="), &idx);
+            } catch (const std::exception& e) {
+                panic_exit("The option threads requires an integer small enough to fit into an int.");
+            }
+
+            if (argv[i][idx + std::strlen("-threads=")] != 0) {
+                panic_exit("The option threads must only have one integer as input.");
+            }
+
+            if (new_threads <= 0) {
+                panic_exit("The option threads must have a strictly positive value.");
+            }
+
+            threads = new_threads;
+
+            default_threads = false;
+        } else if (std::strcmp(argv[i], "-parallel=coloring") == 0) {
+            // Parse the parallel strategy
+            if (default_parallel == false) {
+                panic_exit("The option parallel was provided multiple times. Options may only be provided once.");
+            }
+
+            parallel_strategy = COLORING;
+
+            default_parallel = false;
+        } else if (std::strcmp(argv[i], "-parallel=reduction") == 0) {
+            // Parse the parallel strategy
+            if (default_parallel == false) {
+                panic_exit("The option parallel was provided multiple times. Options may only be provided once.");
+            }
+
+            parallel_strategy = REDUCTION;
+
+            default_parallel = false;
+        } else if (std::strcmp(argv[i], "-parallel=atomic") == 0) {
+            // Parse the parallel strategy
+            if (default_parallel == false) {
+                panic_exit("The option parallel was provided multiple times. Options may only be provided once.");
+            }
+
+            parallel_strategy = ATOMIC;
+
+            default_parallel = false;
+        } else if (std::strcmp(argv[i], "-cell_tasks=on") == 0) {
+            // Parse the cell tasks
+            if (default_cell_tasks == false) {
+                panic_exit("The option cell_tasks was provided multiple times. Options may only be provided once.");
+            }
+
+            cell_tasks = true;
+
+            default_cell_tasks = false;
+        } else if (std::strcmp(argv[i], "-cell_tasks=off") == 0) {
+            // Parse the cell tasks
+            if (default_cell_tasks == false) {
+                panic_exit("The option cell_tasks was provided multiple times. Options may only be provided once.");
+            }
+
+            cell_tasks = false;
+
+            default_cell_tasks = false;
+        } else if (std::strncmp(argv[i], "-balance=", std::strlen("-balance=")) == 0) {
+            // Parse the imbalance threshold
+            if (default_balance == false) {
+                panic_exit("The option balance was provided multiple times. Options may only be provided once.");
+            }
+
+            size_t idx = 0;
+
+            try {
+                balance = std::stod(argv[i] + std::strlen("-balance="), &idx);
+            } catch (const std::exception& e) {
+                panic_exit("The option balance requires a floatingpoint number within the region of a 64 bit float.");
+            }
+
+            if (argv[i][idx + std::strlen("-balance=")] != 0) {
+                panic_exit("The option balance must only have one floating point number as input.");
+            }
+
+            if (balance < 0.0) {
+                panic_exit("The option balance must have a positive value.");
+            }
+
+            if (std::isnan(balance) || std::isinf(balance)) {
+                panic_exit("The option balance must be a valid number, not NAN or INF.");
+            }
+
+            default_balance = false;
+        } else if (std::strcmp(argv[i], "-distributed=on") == 0) {
+            // Parse the distributed mode
+            if (default_distributed == false) {
+                panic_exit("The option distributed was provided multiple times. Options may only be provided once.");
+            }
+
+            distributed = true;
+
+            default_distributed = false;
+        } else if (std::strcmp(argv[i], "-distributed=off") == 0) {
+            // Parse the distributed mode
+            if (default_distributed == false) {
+                panic_exit("The option distributed was provided multiple times. Options may only be provided once.");
+            }
+
+            distributed = false;
+
+            default_distributed = false;
+        } else if (std::strcmp(argv[i], "-numa=on") == 0) {
+            // Parse the NUMA mode
+            if (default_numa == false) {
+                panic_exit("The option numa was provided multiple times. Options may only be provided once.");
+            }
+
+            numa = true;
+
+            default_numa = false;
+        } else if (std::strcmp(argv[i], "-numa=off") == 0) {
+            // Parse the NUMA mode
+            if (default_numa == false) {
+                panic_exit("The option numa was provided multiple times. Options may only be provided once.");
+            }
+
+            numa = false;
+
+            default_numa = false;
+        } else if (std::strcmp(argv[i], "-pinning=off") == 0) {
+            // Parse the thread pinning
+            if (default_pinning == false) {
+                panic_exit("The option pinning was provided multiple times. Options may only be provided once.");
+            }
+
+            pinning = NO_PINNING;
+
+            default_pinning = false;
+        } else if (std::strcmp(argv[i], "-pinning=compact") == 0) {
+            // Parse the thread pinning
+            if (default_pinning == false) {
+                panic_exit("The option pinning was provided multiple times. Options may only be provided once.");
+            }
+
+            pinning = COMPACT;
+
+            default_pinning = false;
+        } else if (std::strcmp(argv[i], "-pinning=scatter") == 0) {
+            // Parse the thread pinning
+            if (default_pinning == false) {
+                panic_exit("The option pinning was provided multiple times. Options may only be provided once.");
+            }
+
+            pinning = SCATTER;
+
+            default_pinning = false;
+        } else if (std::strcmp(argv[i], "-huge_pages=on") == 0) {
+            // Parse the huge pages
+            if (default_huge_pages == false) {
+                panic_exit("The option huge_pages was provided multiple times. Options may only be provided once.");
+            }
+
+            huge_pages = true;
+
+            default_huge_pages = false;
+        } else if (std::strcmp(argv[i], "-huge_pages=off") == 0) {
+            // Parse the huge pages
+            if (default_huge_pages == false) {
+                panic_exit("The option huge_pages was provided multiple times. Options may only be provided once.");
+            }
+
+            huge_pages = false;
+
+            default_huge_pages = false;
         } else {
             // Parse the input file
             if (std::strlen(argv[i]) == 0) {
@@ -404,6 +808,20 @@ Environment::Environment(const int argc, const char* argv[]) {
     SPDLOG_DEBUG("    format = {} ({})", static_cast<int>(output_format), btos(default_file_format));
     SPDLOG_DEBUG("    log_level = {} ({})", static_cast<int>(spdlog::get_level()), btos(default_log_level));
     SPDLOG_DEBUG("    calc = {} ({})", static_cast<int>(calc), btos(default_calculator));
+    SPDLOG_DEBUG("    table = {} ({})", table_file, btos(default_table));
+    SPDLOG_DEBUG("    precision = {} ({})", static_cast<int>(precision), btos(default_precision));
+    SPDLOG_DEBUG("    skin = {} ({})", skin, btos(default_skin));
+    SPDLOG_DEBUG("    reorder = {} ({})", btos(reorder), btos(default_reorder));
+    SPDLOG_DEBUG("    sort_interval = {} ({})", sort_interval, btos(default_sort_interval));
+    SPDLOG_DEBUG("    periodic_ghosts = {} ({})", btos(periodic_ghosts), btos(default_periodic_ghosts));
+    SPDLOG_DEBUG("    threads = {} ({})", threads, btos(default_threads));
+    SPDLOG_DEBUG("    parallel = {} ({})", static_cast<int>(parallel_strategy), btos(default_parallel));
+    SPDLOG_DEBUG("    cell_tasks = {} ({})", btos(cell_tasks), btos(default_cell_tasks));
+    SPDLOG_DEBUG("    balance = {} ({})", balance, btos(default_balance));
+    SPDLOG_DEBUG("    distributed = {} ({})", btos(distributed), btos(default_distributed));
+    SPDLOG_DEBUG("    numa = {} ({})", btos(numa), btos(default_numa));
+    SPDLOG_DEBUG("    pinning = {} ({})", static_cast<int>(pinning), btos(default_pinning));
+    SPDLOG_DEBUG("    huge_pages = {} ({})", btos(huge_pages), btos(default_huge_pages));
 }
 
 Environment::~Environment() = default;
@@ -422,6 +840,7 @@ void Environment::assert_boundary_conditions() {
     bool has_inf = false;
     bool has_anti_inf = false;
     bool has_ghost = false;
+    bool has_periodic = false;
 
     for (size_t i = 0; i < 6; i++) {
         if (get_boundary_type()[i] == INF_CONT) {
@@ -435,6 +854,10 @@ void Environment::assert_boundary_conditions() {
         if (get_boundary_type()[i] == HALO) {
             has_ghost = true;
         }
+
+        if (get_boundary_type()[i] == PERIODIC) {
+            has_periodic = true;
+        }
     }
 
     if (has_inf && has_anti_inf) {
@@ -444,6 +867,46 @@ void Environment::assert_boundary_conditions() {
     if (has_ghost && calc == GRAVITY) {
         panic_exit("The gravity calculator must not be combined with a ghost particle boundary.");
     }
+
+    if (has_periodic && sub_cells > 1 && !periodic_ghosts) {
+        panic_exit("The periodic boundary condition must only be combined with sub cells, if the periodic ghost particles are enabled.");
+    }
+
+    if (has_periodic && periodic_ghosts && skin > 0.0) {
+        panic_exit("The periodic ghost particles must not be combined with the verlet lists.");
+    }
+
+    if (distributed && has_inf) {
+        panic_exit("The distributed mode must not be combined with the infinite boundary condition.");
+    }
+
+    if (distributed && skin > 0.0) {
+        panic_exit("The distributed mode must not be combined with the verlet lists.");
+    }
+
+    if (balance > 0.0 && parallel_strategy != REDUCTION) {
+        panic_exit("The balancing must only be combined with the reduction strategy.");
+    }
+
+    if (balance > 0.0 && (cell_tasks || skin > 0.0)) {
+        panic_exit("The balancing must not be combined with the cell tasks or the verlet lists.");
+    }
+
+    if (huge_pages && !numa) {
+        panic_exit("The huge pages must only be combined with the NUMA mode.");
+    }
+
+    if (!table_file.empty() && calc != TABULATED) {
+        panic_exit("The table file must only be combined with the tabulated calculator.");
+    }
+
+    if (precision == MIXED_PRECISION && calc == GRAVITY) {
+        panic_exit("The mixed precision must only be combined with the lenard jones or the tabulated calculator.");
+    }
+
+    if (distributed && pinning != NO_PINNING) {
+        panic_exit("The thread pinning must not be combined with the distributed mode, the ranks of a node would share their cpus.");
+    }
 }
 
 const std::array<BoundaryType, 6> Environment::get_boundary_type() const {
@@ -8,6 +8,7 @@
 
 #include "utils/Vec.h"
 
+#include <array>
 #include <string>
 
 /**
@@ -57,6 +58,30 @@ enum CalculatorType {
      * Define the lenard jones calculation type without range cut-offs.
      */
     LJ_FULL,
+
+    /**
+     * Define the calculation type interpolating the forces of the type pairs from cubic spline tables, either of the Lenard-Jones potential or
+     * read from a table file.
+     */
+    TABULATED,
+};
+
+/**
+ * @enum Precision
+ *
+ * @brief The enum describes the floating point precision of the force kernels.
+ */
+enum Precision {
+    /**
+     * Define that the force kernels compute in double precision.
+     */
+    DOUBLE_PRECISION,
+
+    /**
+     * Define that the force kernels read the positions and compute the pair forces in single precision, while the forces are accumulated in
+     * double precision.
+     */
+    MIXED_PRECISION,
 };
 
 /**
@@ -86,6 +111,50 @@ enum OutputFormat {
     CHECKPOINT,
 };
 
+/**
+ * @enum ParallelStrategy
+ *
+ * @brief The enum describes how the threads avoid races, while they update the forces of both particles of a pair.
+ */
+enum ParallelStrategy {
+    /**
+     * Define the cell coloring, which processes cells with disjoint neighborhoods concurrently.
+     */
+    COLORING,
+
+    /**
+     * Define the thread local force buffers, which are reduced into the forces after the pair traversal.
+     */
+    REDUCTION,
+
+    /**
+     * Define the atomic updates, which let any thread process any cell pair and add the forces of both particles of a pair atomically.
+     */
+    ATOMIC,
+};
+
+/**
+ * @enum PinningStrategy
+ *
+ * @brief The enum describes how the threads are pinned to the cores of the NUMA nodes.
+ */
+enum PinningStrategy {
+    /**
+     * Define that the operating system places the threads.
+     */
+    NO_PINNING,
+
+    /**
+     * Define that the threads fill the cores of one NUMA node before using the next node.
+     */
+    COMPACT,
+
+    /**
+     * Define that consecutive threads are placed on different NUMA nodes in a round robin order.
+     */
+    SCATTER,
+};
+
 /**
  * @enum InputFormat
  *
@@ -140,6 +209,16 @@ private:
      */
     CalculatorType calc = LJ_FULL;
 
+    /**
+     * Store the file the tabulated calculator reads the forces of the type pairs from. An empty file name tabulates the Lenard-Jones forces.
+     */
+    std::string table_file;
+
+    /**
+     * Store the floating point precision of the force kernels.
+     */
+    Precision precision = DOUBLE_PRECISION;
+
     /**
      * Store the condition of the XY boundary at the origin.
      */
@@ -210,6 +289,71 @@ private:
      */
     double gravity = 0.0;
 
+    /**
+     * Store the skin added to the cutoff radius of the verlet neighbor lists. A skin of 0.0 disables the verlet lists.
+     */
+    double skin = 0.0;
+
+    /**
+     * Store if the particles should be reordered in the order of the linked cells, whenever the cells are rebuilt.
+     */
+    bool reorder = false;
+
+    /**
+     * Store after how many steps the particles should be sorted along a space filling curve. An interval of 0 disables the sorting.
+     */
+    int sort_interval = 0;
+
+    /**
+     * Store the number of linked cells per cutoff distance in each direction.
+     */
+    size_t sub_cells = 1;
+
+    /**
+     * Store if the periodic boundaries are handled by replicating ghost particles into the halo cells.
+     */
+    bool periodic_ghosts = false;
+
+    /**
+     * Store the number of threads used for the force calculation. A value of 0 keeps the default of OpenMP.
+     */
+    size_t threads = 0;
+
+    /**
+     * Store how the threads avoid races during the force calculation.
+     */
+    ParallelStrategy parallel_strategy = COLORING;
+
+    /**
+     * Store if the parallel traversals execute blocks of cells as OpenMP tasks.
+     */
+    bool cell_tasks = false;
+
+    /**
+     * Store the imbalance threshold of the thread times, above which the cells are partitioned again. A threshold of 0.0 disables the balancing.
+     */
+    double balance = 0.0;
+
+    /**
+     * Store if the domain is split into one subdomain per MPI rank.
+     */
+    bool distributed = false;
+
+    /**
+     * Store if the pages of the particles are moved to the NUMA nodes of the threads using them.
+     */
+    bool numa = false;
+
+    /**
+     * Store how the threads are pinned to the cpus.
+     */
+    PinningStrategy pinning = NO_PINNING;
+
+    /**
+     * Store if the arrays placed by the NUMA mode are backed by transparent huge pages.
+     */
+    bool huge_pages = false;
+
 public:
     /**
      * Create a standard environment with all arguments being initialized to their default. The input file name will be null.
@@ -355,6 +499,111 @@ public:
      */
     inline const int get_temp_frequency() const { return temp_frequency; }
 
+    /**
+     * Get the skin added to the cutoff radius of the verlet neighbor lists.
+     *
+     * @return The verlet list skin.
+     */
+    inline const double get_skin() const { return skin; }
+
+    /**
+     * Get if the particles should be reordered in the order of the linked cells.
+     *
+     * @return A boolean indicating if the particles are reordered.
+     */
+    inline const bool get_reorder() const { return reorder; }
+
+    /**
+     * Get after how many steps the particles should be sorted along a space filling curve.
+     *
+     * @return The sort interval.
+     */
+    inline const int get_sort_interval() const { return sort_interval; }
+
+    /**
+     * Get the number of linked cells per cutoff distance in each direction.
+     *
+     * @return The number of sub cells.
+     */
+    inline const size_t get_sub_cells() const { return sub_cells; }
+
+    /**
+     * Get if the periodic boundaries are handled by replicating ghost particles into the halo cells.
+     *
+     * @return A boolean indicating if the periodic ghost particles are used.
+     */
+    inline const bool get_periodic_ghosts() const { return periodic_ghosts; }
+
+    /**
+     * Get the number of threads used for the force calculation. A value of 0 indicates the default of OpenMP.
+     *
+     * @return The number of threads.
+     */
+    inline const size_t get_threads() const { return threads; }
+
+    /**
+     * Get how the threads avoid races during the force calculation.
+     *
+     * @return The parallel strategy.
+     */
+    inline const ParallelStrategy get_parallel_strategy() const { return parallel_strategy; }
+
+    /**
+     * Get if the parallel traversals execute blocks of cells as OpenMP tasks.
+     *
+     * @return A boolean indicating if the cell tasks are used.
+     */
+    inline const bool get_cell_tasks() const { return cell_tasks; }
+
+    /**
+     * Get the imbalance threshold of the thread times, above which the cells are partitioned again.
+     *
+     * @return The imbalance threshold, 0.0 if the balancing is disabled.
+     */
+    inline const double get_balance() const { return balance; }
+
+    /**
+     * Get if the domain is split into one subdomain per MPI rank.
+     *
+     * @return A boolean indicating if the distributed mode is used.
+     */
+    inline const bool get_distributed() const { return distributed; }
+
+    /**
+     * Get if the pages of the particles are moved to the NUMA nodes of the threads using them.
+     *
+     * @return A boolean indicating if the NUMA mode is used.
+     */
+    inline const bool get_numa() const { return numa; }
+
+    /**
+     * Get how the threads are pinned to the cpus.
+     *
+     * @return The pinning strategy.
+     */
+    inline const PinningStrategy get_pinning() const { return pinning; }
+
+    /**
+     * Get if the arrays placed by the NUMA mode are backed by transparent huge pages.
+     *
+     * @return A boolean indicating if the huge pages are used.
+     */
+    inline const bool get_huge_pages() const { return huge_pages; }
+
+    /**
+     * Get the file the tabulated calculator reads the forces of the type pairs from.
+     *
+     * @return The name of the table file, an empty string if the Lenard-Jones forces are tabulated.
+     */
+    inline const std::string& get_table_file() const { return table_file; }
+
+    /**
+     * Get the floating point precision of the force kernels.
+     *
+     * @return The precision.
+     */
+    inline const Precision get_precision() const { return precision; }
+
 
     // Setter methods
 
@@ -455,4 +704,109 @@ public:
      * @param g The gravity pulling the atoms down.
      */
     inline void set_gravity(const double gravity) { this->gravity = gravity; }
+
+    /**
+     * Set the skin added to the cutoff radius of the verlet neighbor lists.
+     *
+     * @param skin The verlet list skin.
+     */
+    inline void set_skin(const double skin) { this->skin = skin; }
+
+    /**
+     * Set if the particles should be reordered in the order of the linked cells.
+     *
+     * @param reorder A boolean indicating if the particles are reordered.
+     */
+    inline void set_reorder(const bool reorder) { this->reorder = reorder; }
+
+    /**
+     * Set after how many steps the particles should be sorted along a space filling curve.
+     *
+     * @param sort_interval The sort interval.
+     */
+    inline void set_sort_interval(const int sort_interval) { this->sort_interval = sort_interval; }
+
+    /**
+     * Set the number of linked cells per cutoff distance in each direction.
+     *
+     * @param sub_cells The number of sub cells.
+     */
+    inline void set_sub_cells(const size_t sub_cells) { this->sub_cells = sub_cells; }
+
+    /**
+     * Set if the periodic boundaries are handled by replicating ghost particles into the halo cells.
+     *
+     * @param periodic_ghosts A boolean indicating if the periodic ghost particles are used.
+     */
+    inline void set_periodic_ghosts(const bool periodic_ghosts) { this->periodic_ghosts = periodic_ghosts; }
+
+    /**
+     * Set the number of threads used for the force calculation. A value of 0 keeps the default of OpenMP.
+     *
+     * @param threads The number of threads.
+     */
+    inline void set_threads(const size_t threads) { this->threads = threads; }
+
+    /**
+     * Set how the threads avoid races during the force calculation.
+     *
+     * @param parallel_strategy The parallel strategy.
+     */
+    inline void set_parallel_strategy(const ParallelStrategy parallel_strategy) { this->parallel_strategy = parallel_strategy; }
+
+    /**
+     * Set if the parallel traversals execute blocks of cells as OpenMP tasks.
+     *
+     * @param cell_tasks A boolean indicating if the cell tasks are used.
+     */
+    inline void set_cell_tasks(const bool cell_tasks) { this->cell_tasks = cell_tasks; }
+
+    /**
+     * Set the imbalance threshold of the thread times, above which the cells are partitioned again.
+     *
+     * @param balance The imbalance threshold, 0.0 disables the balancing.
+     */
+    inline void set_balance(const double balance) { this->balance = balance; }
+
+    /**
+     * Set if the domain is split into one subdomain per MPI rank.
+     *
+     * @param distributed A boolean indicating if the distributed mode is used.
+     */
+    inline void set_distributed(const bool distributed) { this->distributed = distributed; }
+
+    /**
+     * Set if the pages of the particles are moved to the NUMA nodes of the threads using them.
+     *
+     * @param numa A boolean indicating if the NUMA mode is used.
+     */
+    inline void set_numa(const bool numa) { this->numa = numa; }
+
+    /**
+     * Set how the threads are pinned to the cpus.
+     *
+     * @param pinning The pinning strategy.
+     */
+    inline void set_pinning(const PinningStrategy pinning) { this->pinning = pinning; }
+
+    /**
+     * Set if the arrays placed by the NUMA mode are backed by transparent huge pages.
+     *
+     * @param huge_pages A boolean indicating if the huge pages are used.
+     */
+    inline void set_huge_pages(const bool huge_pages) { this->huge_pages = huge_pages; }
+
+    /**
+     * Set the file the tabulated calculator reads the forces of the type pairs from.
+     *
+     * @param table_file The name of the table file, an empty string tabulates the Lenard-Jones forces.
+     */
+    inline void set_table_file(const std::string& table_file) { this->table_file = table_file; }
+
+    /**
+     * Set the floating point precision of the force kernels.
+     *
+     * @param precision The precision.
+     */
+    inline void set_precision(const Precision precision) { this->precision = precision; }
 };
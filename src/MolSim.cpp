@@ -1,8 +1,10 @@
 #include "MolSim.h"
+#include "Simulation.h"
 #include "Thermostat.h"
 #include "boundaries/Stepper.h"
 #include "container/BoxContainer.h"
 #include "container/DSContainer.h"
+#include "container/DomainDecomposition.h"
 #include "inputReader/FileReader.h"
 #include "inputReader/XMLTreeReader.h"
 #include "outputWriter/CheckpointWriter.h"
@@ -11,8 +13,16 @@
 #include "outputWriter/XYZWriter.h"
 #include "physicsCalculator/GravityCalculator.h"
 #include "physicsCalculator/LJCalculator.h"
+#include "physicsCalculator/TabulatedCalculator.h"
+#include "utils/Numa.h"
 
 #include <iostream>
+#ifdef MOLSIM_MPI
+#include <mpi.h>
+#endif
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 #include <spdlog/spdlog.h>
 #include <string>
 
@@ -20,6 +30,10 @@
  * The main entry point for the program.
  */
 int main(const int argc, const char* argv[]) {
+#ifdef MOLSIM_MPI
+    MPI_Init(nullptr, nullptr);
+#endif
+
     // Initialize the simulation environment.
     Environment env { argc, argv };
 
@@ -46,18 +60,58 @@ int main(const int argc, const char* argv[]) {
 
     reader->readArguments(env, thermostat);
 
+#ifdef _OPENMP
+    // Set the number of threads of the force calculation, unless the default of OpenMP should be used
+    if (env.get_threads() > 0) {
+        omp_set_num_threads(static_cast<int>(env.get_threads()));
+    }
+
+    SPDLOG_INFO("Using {} threads.", omp_get_max_threads());
+#endif
+
     std::shared_ptr<ParticleContainer> cont { nullptr };
 
     if (env.requires_direct_sum()) {
         cont = std::make_shared<DSContainer>(env.get_domain_size());
     } else {
-        cont = std::make_shared<BoxContainer>(env.get_r_cutoff(), env.get_domain_size());
+        cont = std::make_shared<BoxContainer>(env.get_r_cutoff(), env.get_domain_size(), env.get_skin(), env.get_reorder(), env.get_sub_cells(),
+            env.get_dimensions(), env.get_cell_tasks(), env.get_balance());
     }
 
     reader->readParticle(*cont, env.get_delta_t(), env.get_gravity());
     reader.reset();
     env.assert_boundary_conditions();
 
+    // Split the domain among the MPI ranks, every rank only keeps the particles of its own subdomain
+    std::unique_ptr<DomainDecomposition> decomposition { nullptr };
+    std::string out_name(env.get_output_file_name());
+    const Environment global_env = env;
+
+    if (env.get_distributed()) {
+        decomposition = std::make_unique<DomainDecomposition>(env);
+        cont = decomposition->create_container(*cont, env);
+        env = decomposition->create_environment(env);
+
+        // Every rank writes the particles of its own subdomain, only the first rank logs its progress
+        if (decomposition->get_size() > 1) {
+            out_name += "_rank" + std::to_string(decomposition->get_rank());
+
+            if (decomposition->get_rank() != 0) {
+                spdlog::set_level(spdlog::level::warn);
+            }
+        }
+
+        SPDLOG_INFO("Using {} ranks ({} x {} x {}).", decomposition->get_size(), decomposition->get_grid()[0], decomposition->get_grid()[1],
+            decomposition->get_grid()[2]);
+    }
+
+    // Pin the threads first, such that the pages are placed on the nodes the threads keep running on
+    Numa::pin_threads(env.get_pinning());
+
+    if (env.get_numa()) {
+        cont->first_touch(env.get_huge_pages());
+    }
+
     // Initialize the calculator.
     std::unique_ptr<physicsCalculator::Calculator> calculator { nullptr };
 
@@ -68,6 +122,9 @@ int main(const int argc, const char* argv[]) {
     case LJ_FULL:
         calculator = std::make_unique<physicsCalculator::LJCalculator>(env, cont);
         break;
+    case TABULATED:
+        calculator = std::make_unique<physicsCalculator::TabulatedCalculator>(env, cont);
+        break;
     default:
         SPDLOG_CRITICAL("Error: Illegal force model specifier.");
         std::exit(EXIT_FAILURE);
@@ -96,38 +153,79 @@ int main(const int argc, const char* argv[]) {
         break;
     }
 
-    // Initialize the stepper.
-    Stepper stepper { env.get_boundary_type(), env.get_domain_size() };
+    // Initialize the stepper, the steps of a non distributed simulation are statically dispatched by an engine.
+    std::unique_ptr<Stepper> stepper { nullptr };
+    std::unique_ptr<Engine> engine { nullptr };
+
+    if (decomposition) {
+        stepper = std::make_unique<Stepper>(*decomposition);
+
+        // The initial forces include the particles of the neighboring subdomains
+        for (auto& p : *cont) {
+            p.setF({ 0.0, 0.0, 0.0 });
+        }
+
+        decomposition->calculate_forces(*calculator);
+    } else {
+        engine = Engine::create(env, *calculator);
+    }
 
     // Fully initialise Thermostat
     thermostat.set_particles(cont);
+    thermostat.set_decomposition(decomposition.get());
+
+    // Write the positions within the global domain in the distributed mode
+    const auto plot = [&](const int step) {
+        if (decomposition) {
+            decomposition->with_global_positions(*cont, [&]() { writer->plotParticles(*cont, out_name, step); });
+        } else {
+            writer->plotParticles(*cont, out_name, step);
+        }
+    };
 
     // Initialize the simulation environment.
     double current_time = 0.0;
     int iteration = 0;
 
     // Write step 0
-    const std::string out_name(env.get_output_file_name());
-    writer->plotParticles(*cont, out_name, iteration);
+    plot(iteration);
 
     // Get the start time of the simulation
     const auto start_time = std::chrono::steady_clock::now();
 
     // For this loop, we assume: current x, current f and current v are known
     while (current_time < env.get_t_end()) {
+        // The kinetic energy for the thermostat is summed up within the velocity update of the step
+        const bool regulate = thermostat.get_active() && (iteration + 1) % env.get_temp_frequency() == 0;
+        calculator->set_track_kinetic_energy(regulate);
+
         // Update x, v, f
-        stepper.step(*calculator);
+        if (engine) {
+            engine->step();
+        } else {
+            stepper->step(*calculator);
+        }
 
         iteration++;
         current_time += env.get_delta_t();
 
         // Apply thermostat
-        if (thermostat.get_active() && iteration % env.get_temp_frequency() == 0)
-            thermostat.regulate_Temperature();
+        if (regulate)
+            thermostat.regulate_Temperature(calculator->get_kinetic_energy());
+
+        // Sort the particles along the space filling curve, the sorted particles keep their pages
+        if (env.get_sort_interval() > 0 && iteration % env.get_sort_interval() == 0) {
+            cont->sort_particles(env.get_r_cutoff());
+        }
+
+        // The pages are only moved to the threads again, if a growing number of particles reallocated them (e.g. the ghost particles)
+        if (env.get_numa() && !cont->is_placed()) {
+            cont->first_touch(env.get_huge_pages());
+        }
 
         // Store the particles to an output file
         if (iteration % env.get_print_step() == 0) {
-            writer->plotParticles(*cont, out_name, iteration);
+            plot(iteration);
             SPDLOG_INFO("Iteration {} finished.", iteration);
         }
     }
@@ -135,17 +233,37 @@ int main(const int argc, const char* argv[]) {
     // Get the start time of the simulation (std::cout is used for performance measurements when the log level is off)
     const auto end_time = std::chrono::steady_clock::now();
     const auto ns_duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time).count();
-    std::cout << "The simulation took " << ns_duration / 1000000.0 << " ms. The update time for a single particle was "
-              << (ns_duration / static_cast<double>(iteration * cont->size()) / 1000.0) << " µs." << std::endl;
+    const double particle_count = decomposition ? decomposition->sum(static_cast<double>(cont->size())) : static_cast<double>(cont->size());
+
+    if (!decomposition || decomposition->get_rank() == 0) {
+        std::cout << "The simulation took " << ns_duration / 1000000.0 << " ms. The update time for a single particle was "
+                  << (ns_duration / (iteration * particle_count) / 1000.0) << " µs." << std::endl;
+    }
+
+    // Report how evenly the force calculation was distributed among the threads
+    if (const auto box = std::dynamic_pointer_cast<BoxContainer>(cont); box && env.get_balance() > 0.0) {
+        SPDLOG_INFO("The mean thread imbalance was {:.3f}, the cells were partitioned again {} times.", box->get_mean_imbalance(),
+            box->get_rebalances());
+    }
 
     if (env.get_output_file_format() == CHECKPOINT) {
         SPDLOG_INFO("Checkpoint written.");
         outputWriter::CheckpointWriter checkpoint_writer;
-        const char* filename = env.get_output_file_name();
-        checkpoint_writer.plot(*cont, env, filename);
+
+        if (decomposition) {
+            // Every rank writes the particles of its own subdomain together with the global domain
+            decomposition->with_global_positions(*cont, [&]() { checkpoint_writer.plot(*cont, global_env, out_name.c_str()); });
+        } else {
+            const char* filename = env.get_output_file_name();
+            checkpoint_writer.plot(*cont, env, filename);
+        }
     }
 
     SPDLOG_INFO("Output written. Terminating...");
 
+#ifdef MOLSIM_MPI
+    MPI_Finalize();
+#endif
+
     return 0;
 }
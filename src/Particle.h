@@ -70,9 +70,9 @@ public:
     Particle(const Vec<double>& x_arg, const Vec<double>& v_arg, const int type_arg = 0);
 
     /**
-     * Destroy a particle.
+     * Destroy a particle. The destructor is not virtual, since no class derives from a particle and a vtable pointer would enlarge every particle.
      */
-    virtual ~Particle();
+    ~Particle();
 
     /**
      * Get the constant reference to the particle position.
@@ -0,0 +1,104 @@
+#include "Simulation.h"
+
+#include "container/DSContainer.h"
+#include "physicsCalculator/GravityCalculator.h"
+#include "physicsCalculator/LJCalculator.h"
+#include "physicsCalculator/TabulatedCalculator.h"
+
+#include <spdlog/spdlog.h>
+
+/**
+ * Create the engine for a boundary configuration.
+ *
+ * @tparam Potential The type of the calculator.
+ * @tparam Container The type of the particle container.
+ * @tparam BoundaryConfig The boundary configuration.
+ * @param calc The calculator.
+ * @param cont The container of the calculator.
+ * @param boundaries The boundary configuration.
+ * @param env The simulation environment.
+ *
+ * @return The engine performing the steps of the simulation.
+ */
+template <typename Potential, typename Container, typename BoundaryConfig>
+static std::unique_ptr<Engine> create_simulation(Potential& calc, Container& cont, const BoundaryConfig& boundaries, const Environment& env) {
+    return std::make_unique<Simulation<Potential, Container, BoundaryConfig>>(
+        calc, cont, boundaries, env.get_boundary_type(), env.get_periodic_ghosts());
+}
+
+/**
+ * Resolve the boundary configuration of the simulation environment. The configurations of the example inputs are resolved at compile time,
+ * the periodic configurations only for the linked cells.
+ *
+ * @tparam Potential The type of the calculator.
+ * @tparam Container The type of the particle container.
+ * @param calc The calculator.
+ * @param cont The container of the calculator.
+ * @param env The simulation environment.
+ *
+ * @return The engine performing the steps of the simulation.
+ */
+template <typename Potential, typename Container>
+static std::unique_ptr<Engine> dispatch_boundaries(Potential& calc, Container& cont, const Environment& env) {
+    const std::array<BoundaryType, 6>& bt = env.get_boundary_type();
+    const Vec<double>& domain = env.get_domain_size();
+
+    if (AxisBoundaries<INF_CONT, INF_CONT, INF_CONT>::matches(bt)) {
+        return create_simulation(calc, cont, AxisBoundaries<INF_CONT, INF_CONT, INF_CONT>(domain), env);
+    } else if (AxisBoundaries<HALO, HALO, HALO>::matches(bt)) {
+        return create_simulation(calc, cont, AxisBoundaries<HALO, HALO, HALO>(domain), env);
+    } else if (AxisBoundaries<HARD, HARD, HARD>::matches(bt)) {
+        return create_simulation(calc, cont, AxisBoundaries<HARD, HARD, HARD>(domain), env);
+    }
+
+    if constexpr (std::is_same_v<Container, BoxContainer>) {
+        if (AxisBoundaries<PERIODIC, PERIODIC, PERIODIC>::matches(bt)) {
+            return create_simulation(calc, cont, AxisBoundaries<PERIODIC, PERIODIC, PERIODIC>(domain), env);
+        } else if (AxisBoundaries<PERIODIC, HALO, HALO>::matches(bt)) {
+            return create_simulation(calc, cont, AxisBoundaries<PERIODIC, HALO, HALO>(domain), env);
+        }
+    }
+
+    return create_simulation(calc, cont, FaceBoundaries(bt, domain), env);
+}
+
+/**
+ * Resolve the container of the calculator.
+ *
+ * @tparam Potential The type of the calculator.
+ * @param calc The calculator.
+ * @param env The simulation environment.
+ *
+ * @return The engine performing the steps of the simulation.
+ */
+template <typename Potential> static std::unique_ptr<Engine> dispatch_container(Potential& calc, const Environment& env) {
+    if (auto* box = dynamic_cast<BoxContainer*>(&calc.get_container())) {
+        return dispatch_boundaries(calc, *box, env);
+    } else if (auto* ds = dynamic_cast<DSContainer*>(&calc.get_container())) {
+        for (const BoundaryType t : env.get_boundary_type()) {
+            if (t == PERIODIC) {
+                SPDLOG_CRITICAL("The periodic boundaries require the linked cells.");
+                std::exit(EXIT_FAILURE);
+            }
+        }
+
+        return dispatch_boundaries(calc, *ds, env);
+    }
+
+    SPDLOG_CRITICAL("Unsupported particle container.");
+    std::exit(EXIT_FAILURE);
+}
+
+std::unique_ptr<Engine> Engine::create(const Environment& env, physicsCalculator::Calculator& calc) {
+    // The tabulated calculator derives from the Lenard-Jones calculator, such that it must be resolved first
+    if (auto* tabulated = dynamic_cast<physicsCalculator::TabulatedCalculator*>(&calc)) {
+        return dispatch_container(*tabulated, env);
+    } else if (auto* lj = dynamic_cast<physicsCalculator::LJCalculator*>(&calc)) {
+        return dispatch_container(*lj, env);
+    } else if (auto* gravity = dynamic_cast<physicsCalculator::GravityCalculator*>(&calc)) {
+        return dispatch_container(*gravity, env);
+    }
+
+    SPDLOG_CRITICAL("Unsupported calculator.");
+    std::exit(EXIT_FAILURE);
+}
@@ -0,0 +1,155 @@
+/**
+ * @file
+ *
+ * @brief Define the simulation engines, whose steps are statically dispatched for a potential, a container and a boundary configuration.
+ */
+
+#pragma once
+
+#include "Environment.h"
+#include "boundaries/BoundaryConfig.h"
+#include "container/BoxContainer.h"
+#include "physicsCalculator/Calculator.h"
+
+#include <array>
+#include <memory>
+#include <type_traits>
+
+/**
+ * @class Engine
+ *
+ * @brief Define the interface of the simulation engines of the non distributed simulations. The potential, the container and the boundary
+ * configuration are resolved once when the engine is created, such that a step is a single virtual call.
+ */
+class Engine {
+public:
+    /**
+     * Provide a default destructor for an engine.
+     */
+    virtual ~Engine() = default;
+
+    /**
+     * Perform a single simulation step, which is equal to a step of the stepper bit by bit.
+     */
+    virtual void step() = 0;
+
+    /**
+     * Create the engine for the calculator, its container and the boundaries of the simulation environment. The boundary types, whose faces normal
+     * to every axis match, are resolved at compile time for the common configurations, the other boundary types fall back to a configuration
+     * reading the boundary types at runtime.
+     *
+     * @param env The simulation environment providing the boundary types, the domain size and the periodic ghost particles.
+     * @param calc The calculator, which must outlive the engine.
+     *
+     * @return The engine performing the steps of the simulation.
+     */
+    static std::unique_ptr<Engine> create(const Environment& env, physicsCalculator::Calculator& calc);
+};
+
+/**
+ * @class Simulation
+ *
+ * @brief Define a simulation engine, which performs the same steps as the stepper, but resolves all calls of the step at compile time. The
+ * boundaries are applied without the virtual methods of the boundary classes and the faces without an effect vanish, the calculator and the
+ * container are called without a virtual call. The floating point kernels of the particles, the boundaries and the periodic pairs are shared
+ * with the stepper and compiled exactly once, such that both produce bit identical trajectories in every build mode.
+ *
+ * @tparam Potential The type of the calculator.
+ * @tparam Container The type of the particle container.
+ * @tparam BoundaryConfig The boundary configuration.
+ */
+template <typename Potential, typename Container, typename BoundaryConfig> class Simulation : public Engine {
+private:
+    /**
+     * Store the calculator.
+     */
+    Potential& calc;
+
+    /**
+     * Store the container of the calculator.
+     */
+    Container& cont;
+
+    /**
+     * Store the boundary configuration.
+     */
+    BoundaryConfig boundaries;
+
+    /**
+     * An array storing for every direction if the domain is periodic along it.
+     */
+    std::array<bool, 3> periodic;
+
+    /**
+     * A boolean indicating if the simulation has an outflow boundary.
+     */
+    bool out;
+
+    /**
+     * A boolean indicating if the periodic boundaries are handled by replicating ghost particles into the halo cells.
+     */
+    bool ghosts;
+
+public:
+    /**
+     * Create a simulation engine.
+     *
+     * @param new_calc The calculator, which must outlive the engine.
+     * @param new_cont The container of the calculator.
+     * @param new_boundaries The boundary configuration.
+     * @param bt The boundary types of the six faces.
+     * @param new_ghosts Handle the periodic boundaries by replicating ghost particles into the halo cells.
+     */
+    Simulation(Potential& new_calc, Container& new_cont, const BoundaryConfig& new_boundaries, const std::array<BoundaryType, 6>& bt,
+        const bool new_ghosts)
+        : calc(new_calc)
+        , cont(new_cont)
+        , boundaries(new_boundaries)
+        , periodic({ bt[0] == PERIODIC, bt[1] == PERIODIC, bt[2] == PERIODIC })
+        , out(false)
+        , ghosts(new_ghosts) {
+        for (const BoundaryType t : bt) {
+            out = out || t == OUTFLOW;
+        }
+    }
+
+    /**
+     * Perform a single simulation step.
+     */
+    virtual void step();
+};
+
+template <typename Potential, typename Container, typename BoundaryConfig> inline void Simulation<Potential, Container, BoundaryConfig>::step() {
+    const auto post_x = [this](Particle& p) { boundaries.post_x(p); };
+    const auto post_f = [this](Particle& p) { boundaries.post_f(p, calc); };
+
+    // Update the positions, apply the boundaries and reset the forces in a single pass
+    calc.integrateX(post_x);
+
+    if (out) {
+        cont.remove_particles_out_of_domain();
+    }
+
+    cont.Container::update_positions();
+
+    // The periodic boundaries require the boundary cells of the linked cells
+    if constexpr (std::is_same_v<Container, BoxContainer> && BoundaryConfig::has_periodic) {
+        if (ghosts && (periodic[0] || periodic[1] || periodic[2])) {
+            // A single pair traversal including the ghost particles replaces the periodic pair loops
+            cont.create_ghosts(periodic);
+            calc.Potential::calculateF();
+            cont.fold_ghost_forces();
+
+            calc.integrateV(post_f);
+            return;
+        }
+
+        calc.Potential::calculateF();
+        calc.calculatePeriodicF(periodic);
+    } else {
+        calc.Potential::calculateF();
+    }
+
+    // Apply the boundaries and update the velocities in a single pass
+    calc.integrateV(post_f);
+}
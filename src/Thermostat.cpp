@@ -1,17 +1,38 @@
 #include "Thermostat.h"
+#include "utils/Threads.h"
+
+#include <vector>
 
 void Thermostat::regulate_Temperature() {
+    const std::vector<TypeDesc> types = particles->get_types();
+    std::vector<double> masses(types.size());
+
+    for (size_t t = 0; t < types.size(); t++) {
+        masses[t] = types[t].get_mass();
+    }
+
+    const auto begin = particles->begin();
+    const double E_kin = Threads::deterministic_sum(particles->size(), [&](const size_t i) {
+        const Particle& p = begin[i];
+        return masses[p.getType()] * p.getV().len_squ();
+    });
 
-    double E_kin = 0.0;
-    for (const auto& p : *particles) {
-        double sp = p.getV().len_squ();
-        E_kin += particles->get_type_descriptor(p.getType()).get_mass() * sp;
+    regulate_Temperature(E_kin);
+}
+
+void Thermostat::regulate_Temperature(double E_kin) {
+    double count = static_cast<double>(particles->size());
+
+    // A distributed simulation is regulated by the temperature of the global domain
+    if (decomposition != nullptr) {
+        E_kin = decomposition->sum(E_kin);
+        count = decomposition->sum(count);
     }
 
-    double T_curr = E_kin / static_cast<double>(dimensions * particles->size());
+    double T_curr = E_kin / (dimensions * count);
     double diff = T_target - T_curr;
 
-    if (particles->size() && T_curr == 0.0) {
+    if (count > 0.0 && T_curr == 0.0) {
         SPDLOG_CRITICAL("Congratulations, you broke physics! Temperature off non empty system should never be 0.");
         std::exit(EXIT_FAILURE);
     }
@@ -29,7 +50,12 @@ void Thermostat::regulate_Temperature() {
         beta = std::sqrt((T_curr + max_change) / T_curr);
     }
 
-    for (auto& p : *particles) {
+    const auto begin = particles->begin();
+    const size_t n = particles->size();
+
+#pragma omp parallel for schedule(static)
+    for (size_t i = 0; i < n; i++) {
+        Particle& p = begin[i];
         p.setV(beta * p.getV());
     }
 }
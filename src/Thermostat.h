@@ -7,6 +7,7 @@
 #pragma once
 
 #include "Environment.h"
+#include "container/DomainDecomposition.h"
 #include "container/ParticleContainer.h"
 #include "spdlog/spdlog.h"
 
@@ -45,6 +46,11 @@ private:
      */
     bool active = false;
 
+    /**
+     * The decomposition of the domain, whose ranks sum up the kinetic energy, if the simulation is distributed.
+     */
+    const DomainDecomposition* decomposition = nullptr;
+
 public:
     /**
      * Create a thermostat regulating certain particles.
@@ -99,10 +105,26 @@ public:
     inline void set_active(bool active) { this->active = active; }
 
     /**
-     * Regulates the Temperature of the given particle container.
+     * Set the decomposition of a distributed simulation, such that the temperature of all subdomains is regulated.
+     *
+     * @param decomposition The decomposition of the domain.
+     */
+    inline void set_decomposition(const DomainDecomposition* decomposition) { this->decomposition = decomposition; }
+
+    /**
+     * Regulates the Temperature of the given particle container. The kinetic energy is summed up in parallel and deterministically, before the
+     * velocities are scaled in a second parallel pass.
      */
     void regulate_Temperature();
 
+    /**
+     * Regulates the Temperature of the given particle container using the already known kinetic energy of its particles, e.g. the one summed
+     * up by the last velocity update of the calculator, such that only the parallel scaling pass is left.
+     *
+     * @param E_kin The sum of m * v * v over the particles of the container.
+     */
+    void regulate_Temperature(double E_kin);
+
     /**
      * Converts the string into an easy to read string.
      *
@@ -0,0 +1,195 @@
+/**
+ * @file
+ *
+ * @brief Define the boundary configurations of the statically dispatched simulation.
+ */
+
+#pragma once
+
+#include "Environment.h"
+#include "boundaries/GhostBoundary.h"
+#include "boundaries/HardBoundary.h"
+#include "boundaries/PeriodicBoundary.h"
+
+#include <array>
+
+/**
+ * @class AxisBoundaries
+ *
+ * @brief Define a boundary configuration, whose boundary types are known at compile time, such that the boundary kernels of every particle are
+ * called without a virtual call and the boundaries without an effect on the particles vanish. Both faces normal to an axis share their boundary
+ * type. The infinite boundaries are used for the outflow boundaries as well, the outflowing particles are removed by the simulation.
+ *
+ * @tparam X The boundary type of the faces normal to the x axis.
+ * @tparam Y The boundary type of the faces normal to the y axis.
+ * @tparam Z The boundary type of the faces normal to the z axis.
+ */
+template <BoundaryType X, BoundaryType Y, BoundaryType Z> class AxisBoundaries {
+private:
+    /**
+     * Store the domain size, which is the position of the upper faces.
+     */
+    Vec<double> domain;
+
+    /**
+     * Apply the boundary of a single face after the position update.
+     *
+     * @tparam T The boundary type of the face.
+     * @param particle The particle which should be updated.
+     * @param pos The position of the face.
+     * @param dim The dimension of the face.
+     */
+    template <BoundaryType T> static inline void face_x(Particle& particle, const double pos, const int dim) {
+        if constexpr (T == HARD) {
+            HardBoundary::reflect(particle, pos, dim);
+        } else if constexpr (T == PERIODIC) {
+            PeriodicBoundary::wrap(particle, pos, dim);
+        }
+    }
+
+    /**
+     * Apply the boundary of a single face after the force calculation.
+     *
+     * @tparam T The boundary type of the face.
+     * @param particle The particle which should be updated.
+     * @param pos The position of the face.
+     * @param dim The dimension of the face.
+     * @param calc The calculator providing the forces of the ghost particles.
+     */
+    template <BoundaryType T>
+    static inline void face_f(Particle& particle, const double pos, const int dim, const physicsCalculator::Calculator& calc) {
+        if constexpr (T == HALO) {
+            GhostBoundary::repel(particle, pos, dim, calc);
+        }
+    }
+
+public:
+    /**
+     * Define if any face of the configuration may be periodic.
+     */
+    static constexpr bool has_periodic = X == PERIODIC || Y == PERIODIC || Z == PERIODIC;
+
+    /**
+     * Create the boundary configuration.
+     *
+     * @param new_domain The domain size.
+     */
+    AxisBoundaries(const Vec<double>& new_domain)
+        : domain(new_domain) { }
+
+    /**
+     * Check if the configuration implements the given boundary types.
+     *
+     * @param bt The boundary types of the six faces.
+     *
+     * @return True if the boundary types of both faces normal to every axis match the configuration.
+     */
+    static bool matches(const std::array<BoundaryType, 6>& bt) {
+        const std::array<BoundaryType, 3> types = { X, Y, Z };
+
+        for (size_t i = 0; i < 6; i++) {
+            const BoundaryType t = bt[i] == OUTFLOW ? INF_CONT : bt[i];
+
+            if (t != types[i % 3]) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    /**
+     * Apply the boundaries to a particle after its position update, in the order of the faces of the stepper.
+     *
+     * @param particle The particle which should be updated.
+     */
+    inline void post_x(Particle& particle) const {
+        face_x<X>(particle, 0.0, 0);
+        face_x<Y>(particle, 0.0, 1);
+        face_x<Z>(particle, 0.0, 2);
+        face_x<X>(particle, domain[0], 0);
+        face_x<Y>(particle, domain[1], 1);
+        face_x<Z>(particle, domain[2], 2);
+    }
+
+    /**
+     * Apply the boundaries to a particle after the force calculation, in the order of the faces of the stepper.
+     *
+     * @param particle The particle which should be updated.
+     * @param calc The calculator providing the forces of the ghost particles.
+     */
+    inline void post_f(Particle& particle, const physicsCalculator::Calculator& calc) const {
+        face_f<X>(particle, 0.0, 0, calc);
+        face_f<Y>(particle, 0.0, 1, calc);
+        face_f<Z>(particle, 0.0, 2, calc);
+        face_f<X>(particle, domain[0], 0, calc);
+        face_f<Y>(particle, domain[1], 1, calc);
+        face_f<Z>(particle, domain[2], 2, calc);
+    }
+};
+
+/**
+ * @class FaceBoundaries
+ *
+ * @brief Define a boundary configuration for arbitrary boundary types of the six faces. The boundary types are read at runtime, but the boundaries
+ * are applied without virtual calls.
+ */
+class FaceBoundaries {
+private:
+    /**
+     * Store the boundary types of the six faces.
+     */
+    std::array<BoundaryType, 6> bound_t;
+
+    /**
+     * Store the domain size, which is the position of the upper faces.
+     */
+    Vec<double> domain;
+
+public:
+    /**
+     * Define if any face of the configuration may be periodic.
+     */
+    static constexpr bool has_periodic = true;
+
+    /**
+     * Create the boundary configuration.
+     *
+     * @param bt The boundary types of the six faces.
+     * @param new_domain The domain size.
+     */
+    FaceBoundaries(const std::array<BoundaryType, 6>& bt, const Vec<double>& new_domain)
+        : bound_t(bt)
+        , domain(new_domain) { }
+
+    /**
+     * Apply the boundaries to a particle after its position update, in the order of the faces of the stepper.
+     *
+     * @param particle The particle which should be updated.
+     */
+    inline void post_x(Particle& particle) const {
+        for (int i = 0; i < 6; i++) {
+            const double pos = i < 3 ? 0.0 : domain[i % 3];
+
+            if (bound_t[i] == HARD) {
+                HardBoundary::reflect(particle, pos, i % 3);
+            } else if (bound_t[i] == PERIODIC) {
+                PeriodicBoundary::wrap(particle, pos, i % 3);
+            }
+        }
+    }
+
+    /**
+     * Apply the boundaries to a particle after the force calculation, in the order of the faces of the stepper.
+     *
+     * @param particle The particle which should be updated.
+     * @param calc The calculator providing the forces of the ghost particles.
+     */
+    inline void post_f(Particle& particle, const physicsCalculator::Calculator& calc) const {
+        for (int i = 0; i < 6; i++) {
+            if (bound_t[i] == HALO) {
+                GhostBoundary::repel(particle, i < 3 ? 0.0 : domain[i % 3], i % 3, calc);
+            }
+        }
+    }
+};
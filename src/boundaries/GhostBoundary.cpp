@@ -1,11 +1,17 @@
 #include "GhostBoundary.h"
 
+#include <cmath>
+
 GhostBoundary::GhostBoundary(const double new_pos, const int new_dim)
     : Boundary(new_pos, new_dim) { }
 
 GhostBoundary::~GhostBoundary() = default;
 
-void GhostBoundary::postF(Particle& particle, physicsCalculator::Calculator& calc) {
+void GhostBoundary::postF(Particle& particle, physicsCalculator::Calculator& calc) { repel(particle, pos, dim, calc); }
+
+void GhostBoundary::postX(Particle& container) { }
+
+void GhostBoundary::repel(Particle& particle, const double pos, const int dim, const physicsCalculator::Calculator& calc) {
     const double scale = std::pow(2.0, 1.0 / 6.0);
     const double r = calc.get_env().get_sigma() * scale * 0.5;
 
@@ -26,5 +32,3 @@ void GhostBoundary::postF(Particle& particle, physicsCalculator::Calculator& cal
         }
     }
 }
-
-void GhostBoundary::postX(Particle& container) { }
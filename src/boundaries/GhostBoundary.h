@@ -42,4 +42,15 @@ public:
      * @param particle The particle container of which should be updated.
      */
     virtual void postX(Particle& particle);
+
+    /**
+     * Add the force of the ghost particle mirrored at a boundary to a particle close to the boundary. This is a shared kernel of the stepper and
+     * the statically dispatched simulation.
+     *
+     * @param particle The particle which should be updated.
+     * @param pos The position of the boundary.
+     * @param dim The dimension of the boundary.
+     * @param calc The calculator used for the force calculation.
+     */
+    SHARED_KERNEL static void repel(Particle& particle, const double pos, const int dim, const physicsCalculator::Calculator& calc);
 };
@@ -8,7 +8,9 @@ HardBoundary::~HardBoundary() = default;
 
 void HardBoundary::postF(Particle& particle, physicsCalculator::Calculator& calc) { }
 
-void HardBoundary::postX(Particle& particle) {
+void HardBoundary::postX(Particle& particle) { reflect(particle, pos, dim); }
+
+void HardBoundary::reflect(Particle& particle, const double pos, const int dim) {
     if (pos == 0.0) {
         if (particle.getX()[dim] < pos) {
             Vec<double> v = particle.getV();
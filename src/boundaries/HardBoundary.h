@@ -42,4 +42,14 @@ public:
      * @param particle The particle container of which should be updated.
      */
     virtual void postX(Particle& particle);
+
+    /**
+     * Reflect a particle, which crossed a hard boundary, back into the domain. This is a shared kernel of the stepper and the statically
+     * dispatched simulation.
+     *
+     * @param particle The particle which should be updated.
+     * @param pos The position of the boundary.
+     * @param dim The dimension of the boundary.
+     */
+    SHARED_KERNEL static void reflect(Particle& particle, const double pos, const int dim);
 };
@@ -7,7 +7,9 @@ PeriodicBoundary::PeriodicBoundary(const double new_pos, const int new_dim)
 
 void PeriodicBoundary::postF(Particle& particle, physicsCalculator::Calculator& calc) { }
 
-void PeriodicBoundary::postX(Particle& particle) {
+void PeriodicBoundary::postX(Particle& particle) { wrap(particle, pos, dim); }
+
+void PeriodicBoundary::wrap(Particle& particle, const double pos, const int dim) {
     if (pos == 0.0) {
         return;
     }
@@ -21,4 +23,4 @@ void PeriodicBoundary::postX(Particle& particle) {
     }
 
     particle.setX(arr);
-}
\ No newline at end of file
+}
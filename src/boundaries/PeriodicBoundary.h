@@ -43,4 +43,14 @@ public:
      * @param particle The particle container of which should be updated.
      */
     virtual void postX(Particle& particle);
+
+    /**
+     * Move a particle, which crossed the upper periodic boundary of a dimension, to the opposite side of the domain. This is a shared kernel of the
+     * stepper and the statically dispatched simulation.
+     *
+     * @param particle The particle which should be updated.
+     * @param pos The position of the boundary.
+     * @param dim The dimension of the boundary.
+     */
+    SHARED_KERNEL static void wrap(Particle& particle, const double pos, const int dim);
 };
@@ -7,10 +7,13 @@
 #include "boundaries/NoBoundary.h"
 #include "boundaries/PeriodicBoundary.h"
 #include "container/BoxContainer.h"
+#include "container/DomainDecomposition.h"
 
-Stepper::Stepper(const std::array<BoundaryType, 6>& bt, const Vec<double>& new_domain) {
+Stepper::Stepper(const std::array<BoundaryType, 6>& bt, const Vec<double>& new_domain, const bool new_ghosts) {
     bound_t = bt;
     domain = new_domain;
+    ghosts = new_ghosts;
+    periodic = { bt[0] == PERIODIC, bt[1] == PERIODIC, bt[2] == PERIODIC };
 
     // Initialize the particle container.
     for (size_t i = 0; i < 6; i++) {
@@ -40,177 +43,64 @@ Stepper::Stepper(const std::array<BoundaryType, 6>& bt, const Vec<double>& new_d
     }
 }
 
-void Stepper::step(physicsCalculator::Calculator& calc) {
-    calc.calculateX();
+Stepper::Stepper(DomainDecomposition& new_decomposition)
+    : Stepper(new_decomposition.get_local_boundary_type(), new_decomposition.get_local_domain_size()) {
+    decomposition = &new_decomposition;
+}
 
-    for (Particle& p : calc.get_container()) {
+void Stepper::step(physicsCalculator::Calculator& calc) {
+    // The boundary conditions only modify the particle they are applied to, such that they are fused into the parallel integrator passes
+    const auto post_x = [this](Particle& p) {
         for (size_t i = 0; i < bc.size(); i++) {
             bc[i]->postX(p);
         }
-    }
+    };
 
-    if (out) {
-        calc.get_container().remove_particles_out_of_domain();
-    }
-
-    calc.get_container().update_positions();
-
-    calc.calculateOldF();
-    calc.calculateF();
-
-    for (Particle& p : calc.get_container()) {
+    const auto post_f = [this, &calc](Particle& p) {
         for (size_t i = 0; i < bc.size(); i++) {
             bc[i]->postF(p, calc);
         }
-    }
+    };
 
-    if (bound_t[0] == PERIODIC) {
-        BoxContainer& cont = dynamic_cast<BoxContainer&>(calc.get_container());
+    // Update the positions, apply the boundaries and reset the forces in a single pass
+    calc.integrateX(post_x);
 
-        cont.iterate_yz_pairs([this, &calc](Particle& p1, Particle& p2) {
-            const Vec<double> arr = p1.getX() + Vec(domain[0], 0.0, 0.0) - p2.getX();
-            const double dist = arr.len_squ();
-            const double force = calc.calculateFAbs(p1, p2, dist);
-
-            // Update the forces for both particles
-            p1.setF(-force * arr + p1.getF());
-            p2.setF(force * arr + p2.getF());
-        });
-
-        if (bound_t[1] == PERIODIC) {
-            cont.loop_z_near([this, &calc](Particle& p1, Particle& p2) {
-                const Vec<double> arr = p1.getX() + Vec<double>(domain[0], domain[1], 0.0) - p2.getX();
-                const double dist = arr.len_squ();
-                const double force = calc.calculateFAbs(p1, p2, dist);
-
-                // Update the forces for both particles
-                p1.setF(-force * arr + p1.getF());
-                p2.setF(force * arr + p2.getF());
-            });
-            cont.loop_z_far([this, &calc](Particle& p1, Particle& p2) {
-                const Vec<double> arr = p1.getX() + Vec<double>(-domain[0], domain[1], 0.0) - p2.getX();
-                const double dist = arr.len_squ();
-                const double force = calc.calculateFAbs(p1, p2, dist);
-
-                // Update the forces for both particles
-                p1.setF(-force * arr + p1.getF());
-                p2.setF(force * arr + p2.getF());
-            });
-        }
+    if (decomposition != nullptr) {
+        // Particles crossing a face shared with another rank are handed over before the outflow boundaries remove particles
+        decomposition->migrate_particles(calc.get_container());
+    }
 
-        if (bound_t[2] == PERIODIC) {
-            cont.loop_y_near([this, &calc](Particle& p1, Particle& p2) {
-                const Vec<double> arr = p1.getX() + Vec<double>(domain[0], 0.0, domain[2]) - p2.getX();
-                const double dist = arr.len_squ();
-                const double force = calc.calculateFAbs(p1, p2, dist);
-
-                // Update the forces for both particles
-                p1.setF(-force * arr + p1.getF());
-                p2.setF(force * arr + p2.getF());
-            });
-            cont.loop_y_far([this, &calc](Particle& p1, Particle& p2) {
-                const Vec<double> arr = p1.getX() + Vec<double>(-domain[0], 0.0, domain[2]) - p2.getX();
-                const double dist = arr.len_squ();
-                const double force = calc.calculateFAbs(p1, p2, dist);
-
-                // Update the forces for both particles
-                p1.setF(-force * arr + p1.getF());
-                p2.setF(force * arr + p2.getF());
-            });
-        }
+    if (out) {
+        calc.get_container().remove_particles_out_of_domain();
     }
 
-    if (bound_t[1] == PERIODIC) {
-        BoxContainer& cont = dynamic_cast<BoxContainer&>(calc.get_container());
-        cont.iterate_xz_pairs([this, &calc](Particle& p1, Particle& p2) {
-            const Vec<double> arr = p1.getX() + Vec<double>(0.0, domain[1], 0.0) - p2.getX();
-            const double dist = arr.len_squ();
-            const double force = calc.calculateFAbs(p1, p2, dist);
-
-            // Update the forces for both particles
-            p1.setF(-force * arr + p1.getF());
-            p2.setF(force * arr + p2.getF());
-        });
-
-        if (bound_t[2] == PERIODIC) {
-            cont.loop_x_near([this, &calc](Particle& p1, Particle& p2) {
-                const Vec<double> arr = p1.getX() + Vec<double>(0.0, domain[1], domain[2]) - p2.getX();
-                const double dist = arr.len_squ();
-                const double force = calc.calculateFAbs(p1, p2, dist);
-
-                // Update the forces for both particles
-                p1.setF(-force * arr + p1.getF());
-                p2.setF(force * arr + p2.getF());
-            });
-            cont.loop_x_far([this, &calc](Particle& p1, Particle& p2) {
-                const Vec<double> arr = p1.getX() + Vec<double>(0.0, -domain[1], domain[2]) - p2.getX();
-                const double dist = arr.len_squ();
-                const double force = calc.calculateFAbs(p1, p2, dist);
-
-                // Update the forces for both particles
-                p1.setF(-force * arr + p1.getF());
-                p2.setF(force * arr + p2.getF());
-            });
-        }
+    calc.get_container().update_positions();
+
+    if (decomposition != nullptr) {
+        decomposition->calculate_forces(calc);
+
+        calc.integrateV(post_f);
+        return;
     }
 
-    if (bound_t[2] == PERIODIC) {
+    if (ghosts && (periodic[0] || periodic[1] || periodic[2])) {
+        // A single pair traversal including the ghost particles replaces the periodic pair loops
         BoxContainer& cont = dynamic_cast<BoxContainer&>(calc.get_container());
 
-        cont.iterate_xy_pairs([this, &calc](Particle& p1, Particle& p2) {
-            const Vec<double> arr = p1.getX() + Vec<double>(0.0, 0.0, domain[2]) - p2.getX();
-            const double dist = arr.len_squ();
-            const double force = calc.calculateFAbs(p1, p2, dist);
+        cont.create_ghosts(periodic);
+        calc.calculateF();
+        cont.fold_ghost_forces();
 
-            // Update the forces for both particles
-            p1.setF(-force * arr + p1.getF());
-            p2.setF(force * arr + p2.getF());
-        });
+        calc.integrateV(post_f);
+        return;
     }
 
-    if (bound_t[0] == PERIODIC && bound_t[1] == PERIODIC && bound_t[2] == PERIODIC) {
-        BoxContainer& cont = dynamic_cast<BoxContainer&>(calc.get_container());
+    calc.calculateF();
 
-        cont.loop_origin_corner([this, &calc](Particle& p1, Particle& p2) {
-            const Vec<double> arr = p1.getX() + Vec<double>(domain[0], domain[1], domain[2]) - p2.getX();
-            const double dist = arr.len_squ();
-            const double force = calc.calculateFAbs(p1, p2, dist);
-
-            // Update the forces for both particles
-            p1.setF(-force * arr + p1.getF());
-            p2.setF(force * arr + p2.getF());
-        });
-
-        cont.loop_x_corner([this, &calc](Particle& p1, Particle& p2) {
-            const Vec<double> arr = p1.getX() + Vec<double>(-domain[0], domain[1], domain[2]) - p2.getX();
-            const double dist = arr.len_squ();
-            const double force = calc.calculateFAbs(p1, p2, dist);
-
-            // Update the forces for both particles
-            p1.setF(-force * arr + p1.getF());
-            p2.setF(force * arr + p2.getF());
-        });
-
-        cont.loop_y_corner([this, &calc](Particle& p1, Particle& p2) {
-            const Vec<double> arr = p1.getX() + Vec<double>(domain[0], -domain[1], domain[2]) - p2.getX();
-            const double dist = arr.len_squ();
-            const double force = calc.calculateFAbs(p1, p2, dist);
-
-            // Update the forces for both particles
-            p1.setF(-force * arr + p1.getF());
-            p2.setF(force * arr + p2.getF());
-        });
-
-        cont.loop_xy_corner([this, &calc](Particle& p1, Particle& p2) {
-            const Vec<double> arr = p1.getX() + Vec<double>(-domain[0], -domain[1], domain[2]) - p2.getX();
-            const double dist = arr.len_squ();
-            const double force = calc.calculateFAbs(p1, p2, dist);
-
-            // Update the forces for both particles
-            p1.setF(-force * arr + p1.getF());
-            p2.setF(force * arr + p2.getF());
-        });
+    if (periodic[0] || periodic[1] || periodic[2]) {
+        calc.calculatePeriodicF(periodic);
     }
 
-    calc.calculateV();
+    // Apply the boundaries and update the velocities in a single pass
+    calc.integrateV(post_f);
 }
@@ -11,6 +11,8 @@
 #include "boundaries/Boundary.h"
 #include "physicsCalculator/Calculator.h"
 
+class DomainDecomposition;
+
 /**
  * @class Stepper
  *
@@ -38,14 +40,39 @@ private:
      */
     bool out = false;
 
+    /**
+     * A boolean indicating if the periodic boundaries are handled by replicating ghost particles into the halo cells.
+     */
+    bool ghosts = false;
+
+    /**
+     * An array storing for every direction if the domain is periodic along it.
+     */
+    std::array<bool, 3> periodic = { false, false, false };
+
+    /**
+     * Store the decomposition of the domain among the MPI ranks, if the simulation is distributed.
+     */
+    DomainDecomposition* decomposition = nullptr;
+
 public:
     /**
      * Create a stepper.
      *
      * @param bt The boundary types used for the simulation.
      * @param new_domain The size of the new domain.
+     * @param new_ghosts Optional: Handle the periodic boundaries by replicating ghost particles into the halo cells, instead of looping through
+     * the boundary cell pairs.
+     */
+    Stepper(const std::array<BoundaryType, 6>& bt, const Vec<double>& new_domain, const bool new_ghosts = false);
+
+    /**
+     * Create a stepper for the own subdomain of a distributed simulation. The boundaries are only applied at the faces of the global domain,
+     * the particles are exchanged with the neighboring ranks every step.
+     *
+     * @param new_decomposition The decomposition of the domain, which must outlive the stepper.
      */
-    Stepper(const std::array<BoundaryType, 6>& bt, const Vec<double>& new_domain);
+    explicit Stepper(DomainDecomposition& new_decomposition);
 
     /**
      * Provide a default destructor for a stepper.
@@ -2,22 +2,44 @@
 
 #include "BoxContainer.h"
 
-BoxContainer::BoxContainer(const double rc, const Vec<double>& new_domain)
-    : ParticleContainer(new_domain) {
-    cells = CellList(rc, domain);
+BoxContainer::BoxContainer(const double rc, const Vec<double>& new_domain, const double skin, const bool reorder, const size_t sub_cells,
+    const size_t dimensions, const bool tasks, const double balance)
+    : ParticleContainer(new_domain)
+    , use_verlet { skin > 0.0 }
+    , reorder { reorder } {
+    cells = CellList(rc, domain, skin, sub_cells, dimensions);
+    cells.set_tasks(tasks);
+    cells.set_balance(balance);
+    verlet = VerletList(rc, skin);
     cells.create_list(particles);
 };
 
-BoxContainer::BoxContainer(
-    const std::vector<Particle>& new_particles, const double rc, const Vec<double>& new_domain, const std::vector<TypeDesc>& new_desc)
-    : ParticleContainer(new_particles, new_domain, new_desc) {
-    cells = CellList(rc, domain);
+BoxContainer::BoxContainer(const std::vector<Particle>& new_particles, const double rc, const Vec<double>& new_domain,
+    const std::vector<TypeDesc>& new_desc, const double skin, const bool reorder, const size_t sub_cells, const size_t dimensions, const bool tasks,
+    const double balance)
+    : ParticleContainer(new_particles, new_domain, new_desc)
+    , use_verlet { skin > 0.0 }
+    , reorder { reorder } {
+    cells = CellList(rc, domain, skin, sub_cells, dimensions);
+    cells.set_tasks(tasks);
+    cells.set_balance(balance);
+    verlet = VerletList(rc, skin);
     cells.create_list(particles);
+
+    if (reorder) {
+        cells.reorder_particles(particles);
+    }
+
+    if (use_verlet) {
+        verlet.build(cells, particles);
+    }
 };
 
 BoxContainer::~BoxContainer() = default;
 
-void BoxContainer::iterate_pairs(const std::function<particle_pair_it>& iterator) { cells.loop_cell_pairs(iterator, particles); }
+void BoxContainer::iterate_pairs(const std::function<particle_pair_it>& iterator) { for_each_pair(iterator); }
+
+void BoxContainer::iterate_pairs(const std::function<displacement_pair_it>& iterator) { for_each_pair(iterator); }
 
 void BoxContainer::iterate_xy_pairs(const std::function<particle_pair_it>& iterator) { cells.loop_xy_pairs(iterator, particles); }
 
@@ -45,6 +67,121 @@ void BoxContainer::loop_y_corner(const std::function<particle_pair_it>& iterator
 
 void BoxContainer::loop_xy_corner(const std::function<particle_pair_it>& iterator) { cells.loop_xy_corner(iterator, particles); }
 
-void BoxContainer::update_positions() { cells.create_list(particles); }
+void BoxContainer::update_positions() {
+    if (use_verlet && !verlet.requires_rebuild(particles)) {
+        // The periodic loops still use the cells, which stay valid, because the cells are enlarged by the skin
+        return;
+    }
+
+    const bool moved = cells.update_list(particles);
+
+    // The particles must only be reordered, when the verlet lists are rebuilt, since the lists store the particle indices
+    if (reorder && moved) {
+        cells.reorder_particles(particles);
+    }
+
+    if (use_verlet) {
+        verlet.build(cells, particles);
+    }
+}
+
+void BoxContainer::sort_particles(const double cell_width) {
+    ParticleContainer::sort_particles(cell_width);
+
+    // The cells and the verlet lists store particle indices, which are invalidated by the sorting
+    cells.create_list(particles);
+
+    if (use_verlet) {
+        verlet.build(cells, particles);
+    }
+}
+
+void BoxContainer::first_touch(const bool huge_pages) {
+    ParticleContainer::first_touch(huge_pages);
+    cells.first_touch(huge_pages);
+}
+
+void BoxContainer::create_ghosts(const std::array<bool, 3>& periodic) {
+    begin_ghosts();
+
+    for (size_t d = 0; d < 3; d++) {
+        if (periodic[d]) {
+            replicate_ghosts(d);
+        }
+    }
+
+    finish_ghosts();
+}
+
+void BoxContainer::begin_ghosts() {
+    owned = particles.size();
+    ghost_owner.clear();
+}
+
+void BoxContainer::replicate_ghosts(const size_t d) {
+    const Vec<double> width = cells.get_halo_width();
+
+    // The ghost particles of the previous directions are replicated as well, which covers the edges and corners
+    const size_t end = particles.size();
+
+    for (size_t i = 0; i < end; i++) {
+        const size_t owner = i < owned ? i : ghost_owner[i - owned];
+
+        for (const double shift : { domain[d], -domain[d] }) {
+            Vec<double> image = particles[i].getX();
+            image[d] += shift;
+
+            if (image[d] < -width[d] || image[d] >= domain[d] + width[d]) {
+                continue;
+            }
+
+            Particle ghost = particles[i];
+            ghost.setX(image);
+            ghost.setF({ 0.0, 0.0, 0.0 });
+            particles.push_back(ghost);
+            ghost_owner.push_back(owner);
+        }
+    }
+}
+
+void BoxContainer::add_remote_ghost(const Particle& p) {
+    particles.push_back(p);
+    ghost_owner.push_back(remote_owner);
+}
+
+void BoxContainer::finish_ghosts() {
+    cells.create_list(particles);
+    ghosts_active = true;
+}
+
+void BoxContainer::fold_ghost_forces() {
+    if (!ghosts_active) {
+        return;
+    }
+
+    for (size_t g = 0; g < ghost_owner.size(); g++) {
+        if (ghost_owner[g] == remote_owner) {
+            continue;
+        }
+
+        Particle& p = particles[ghost_owner[g]];
+        p.setF(p.getF() + particles[owned + g].getF());
+    }
+
+    // The cell list still stores the ghost particles, the changed particle count forces a rebuild on the next position update
+    particles.resize(owned);
+    ghost_owner.clear();
+    ghosts_active = false;
+}
+
+size_t BoxContainer::get_ghost_count() const { return ghost_owner.size(); }
+
+Vec<double> BoxContainer::get_halo_width() const { return cells.get_halo_width(); }
+
+size_t BoxContainer::get_verlet_builds() const { return verlet.get_builds(); }
+
+double BoxContainer::get_mean_imbalance() const { return cells.get_mean_imbalance(); }
+
+size_t BoxContainer::get_rebalances() const { return cells.get_rebalances(); }
 
 double BoxContainer::getRC() { return cells.getRC(); }
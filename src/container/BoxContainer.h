@@ -7,8 +7,11 @@
 
 #pragma once
 
+#include <limits>
+
 #include "CellList.h"
 #include "ParticleContainer.h"
+#include "VerletList.h"
 
 /**
  * @class BoxContainer
@@ -25,14 +28,69 @@ private:
      */
     CellList cells;
 
+    /**
+     * Define the verlet neighbor lists.
+     */
+    VerletList verlet;
+
+    /**
+     * Store if the verlet neighbor lists are used instead of rebuilding the cell list every step.
+     */
+    bool use_verlet;
+
+    /**
+     * Store if the particles are reordered in the order of the cells, whenever the cells are rebuilt.
+     */
+    bool reorder;
+
+    /**
+     * Store the number of particles within the domain, while ghost particles are appended to the particle vector.
+     */
+    size_t owned = 0;
+
+    /**
+     * Store for every ghost particle the index of the particle it is an image of. Ghost particles owned by another subdomain store
+     * remote_owner instead.
+     */
+    std::vector<size_t> ghost_owner;
+
+    /**
+     * Store if ghost particles are currently appended to the particle vector.
+     */
+    bool ghosts_active = false;
+
+    /**
+     * Wrap an index pair iterator, such that only the owned pairs and the owned ghost pairs, which must be computed, are passed on. Every
+     * interaction across a periodic boundary is visited twice, once for each particle paired with the image of the other one. Only the pair,
+     * whose particle within the domain has the smaller index than the owner of the ghost particle, is kept. Since remote_owner is larger than
+     * every index, all pairs with ghost particles of other subdomains are kept.
+     *
+     * @param iterator The index pair iteration lambda.
+     *
+     * @return The filtering index pair iteration lambda.
+     */
+    template <typename F> auto ghost_filter(const F& iterator);
+
 public:
+    /**
+     * The owner index of ghost particles, which are copies of particles owned by another subdomain. Their forces are discarded.
+     */
+    static constexpr size_t remote_owner = std::numeric_limits<size_t>::max();
+
     /**
      * Define the box container.
      *
      * @param rc The cutoff distance used for the simulation.
      * @param new_domain Vector of the number of cells in each direction.
+     * @param skin Optional: The verlet list skin. A skin of 0.0 disables the verlet lists.
+     * @param reorder Optional: Reorder the particles in the order of the cells, whenever the cells are rebuilt.
+     * @param sub_cells Optional: The number of linked cells per cutoff distance in each direction.
+     * @param dimensions Optional: The number of simulated dimensions, either 2 or 3.
+     * @param tasks Optional: Execute blocks of cells as OpenMP tasks in the parallel traversals.
+     * @param balance Optional: The imbalance threshold of the balanced distributed traversal, 0.0 disables the balancing.
      */
-    BoxContainer(const double rc, const Vec<double>& new_domain);
+    BoxContainer(const double rc, const Vec<double>& new_domain, const double skin = 0.0, const bool reorder = false, const size_t sub_cells = 1,
+        const size_t dimensions = 3, const bool tasks = false, const double balance = 0.0);
 
     /**
      * Define the box container.
@@ -41,15 +99,58 @@ public:
      * @param rc The cutoff distance used for the simulation.
      * @param new_domain Vector of the number of cells in each direction.
      * @param new_desc The types of the particles to be stored.
+     * @param skin Optional: The verlet list skin. A skin of 0.0 disables the verlet lists.
+     * @param reorder Optional: Reorder the particles in the order of the cells, whenever the cells are rebuilt.
+     * @param sub_cells Optional: The number of linked cells per cutoff distance in each direction.
+     * @param dimensions Optional: The number of simulated dimensions, either 2 or 3.
+     * @param tasks Optional: Execute blocks of cells as OpenMP tasks in the parallel traversals.
+     * @param balance Optional: The imbalance threshold of the balanced distributed traversal, 0.0 disables the balancing.
      */
-    BoxContainer(
-        const std::vector<Particle>& new_particles, const double rc, const Vec<double>& new_domain, const std::vector<TypeDesc>& new_desc);
+    BoxContainer(const std::vector<Particle>& new_particles, const double rc, const Vec<double>& new_domain, const std::vector<TypeDesc>& new_desc,
+        const double skin = 0.0, const bool reorder = false, const size_t sub_cells = 1, const size_t dimensions = 3, const bool tasks = false,
+        const double balance = 0.0);
 
     /**
      * Define the default destructor for a box container.
      */
     ~BoxContainer();
 
+    /**
+     * Iterate through the index pairs of the particles, which may be within the cutoff distance. The iterator must filter the pairs by their
+     * distance itself.
+     *
+     * @param iterator The function used to iterate over the index pairs.
+     */
+    template <typename F> void for_each_candidate_pair(const F& iterator);
+
+    /**
+     * Iterate through the index pairs of the particles, which may be within the cutoff distance, using all OpenMP threads. The linked cells are
+     * traversed by colors, such that the iterator may update both particles of a pair without synchronization. The verlet lists are traversed
+     * sequentially. The iterator must filter the pairs by their distance itself. Batch iterators receive batches of neighbor candidates, except
+     * for the ghost particles.
+     *
+     * @param iterator The function used to iterate over the index pairs or batches.
+     */
+    template <typename F> void for_each_colored_candidate_pair(const F& iterator);
+
+    /**
+     * Iterate through the index pairs of the particles, which may be within the cutoff distance, while the cells or the verlet lists are
+     * distributed among the threads of the enclosing OpenMP parallel region. This method must be called by every thread of the region. The
+     * iterator must only write to thread private data and filter the pairs by their distance itself. Batch iterators receive batches of
+     * neighbor candidates, except for the ghost particles.
+     *
+     * @param iterator The function used to iterate over the index pairs or batches.
+     */
+    template <typename F> void for_each_distributed_candidate_pair(const F& iterator);
+
+    /**
+     * Iterate through the particle pairs. The iterator is a template parameter, such that it can be inlined into the pair traversal. An iterator
+     * accepting a displacement pair receives the displacement from the second to the first particle and the squared distance of the cutoff test.
+     *
+     * @param iterator The function used to iterate over the particle pairs.
+     */
+    template <typename F> void for_each_pair(const F& iterator);
+
     /**
      * Iterate through the particle pairs.
      *
@@ -57,6 +158,23 @@ public:
      */
     virtual void iterate_pairs(const std::function<particle_pair_it>& iterator);
 
+    /**
+     * Iterate through the particle pairs, passing the displacement and the squared distance of the cutoff test.
+     *
+     * @param iterator The function used to iterate over the particle pairs.
+     */
+    virtual void iterate_pairs(const std::function<displacement_pair_it>& iterator);
+
+    /**
+     * Iterate through the particle pairs across the periodic boundaries, in the order of the periodic plane, axis and corner loops. An iterator
+     * accepting a displacement pair receives the displacement from the second particle to the periodic image of the first particle and the squared
+     * distance. The iterator is a template parameter, such that it can be inlined into the traversal.
+     *
+     * @param iterator The function used to iterate over the particle pairs.
+     * @param periodic An array storing for every direction if the domain is periodic along it.
+     */
+    template <typename F> void for_each_periodic_pair(const F& iterator, const std::array<bool, 3>& periodic);
+
     /**
      * Loop through the xy boundary plain pairs.
      *
@@ -156,7 +274,169 @@ public:
     double getRC();
 
     /**
-     * Update the particle positions in their cells.
+     * Get how often the verlet lists have been built.
+     *
+     * @return The number of verlet list builds.
+     */
+    size_t get_verlet_builds() const;
+
+    /**
+     * Get the mean imbalance of the thread times over all balanced traversals of the linked cells.
+     *
+     * @return The mean imbalance.
+     */
+    double get_mean_imbalance() const;
+
+    /**
+     * Get how often the balanced traversal of the linked cells cut a new partition.
+     *
+     * @return The number of new partitions.
+     */
+    size_t get_rebalances() const;
+
+    /**
+     * Update the particle positions in their cells. Only the particles which changed their cell are moved, unless many particles changed their
+     * cell. If the verlet lists are used, the cells and lists are only updated if a particle moved further than half the skin. If the reordering
+     * is enabled, the particles are reordered whenever a particle changed its cell.
      */
     virtual void update_positions();
+
+    /**
+     * Sort the particles along a Morton (Z-order) curve of their cell coordinates and rebuild the cells and the verlet lists afterwards.
+     *
+     * @param cell_width The width of the cells used for the space filling curve.
+     */
+    virtual void sort_particles(const double cell_width);
+
+    /**
+     * Move the pages of the particles and the linked cells to the NUMA nodes of the threads using them.
+     *
+     * @param huge_pages Ask the operating system to back the arrays with transparent huge pages.
+     */
+    virtual void first_touch(const bool huge_pages);
+
+    /**
+     * Append the periodic images of the particles within the boundary layer to the particle vector, such that they are stored in the halo cells
+     * on the opposite side of the domain. Afterwards a single pair traversal computes all interactions across the periodic boundaries. The
+     * images are created one direction after another, such that the edges and corners are covered as well. The cell list is rebuilt including
+     * the ghost particles.
+     *
+     * @param periodic Store for every direction if the domain is periodic along it.
+     */
+    void create_ghosts(const std::array<bool, 3>& periodic);
+
+    /**
+     * Mark all particles currently stored as the particles within the domain, such that ghost particles can be appended.
+     */
+    void begin_ghosts();
+
+    /**
+     * Append the periodic images of the particles and the ghost particles within the boundary layer of the given direction to the particle
+     * vector, such that they are stored in the halo cells on the opposite side of the domain.
+     *
+     * @param d The periodic direction.
+     */
+    void replicate_ghosts(const size_t d);
+
+    /**
+     * Append a copy of a particle owned by another subdomain to the particle vector. The particle must be located in the halo cells.
+     *
+     * @param p The particle copy.
+     */
+    void add_remote_ghost(const Particle& p);
+
+    /**
+     * Rebuild the cell list including the ghost particles appended since begin_ghosts(), such that the pair traversals visit them.
+     */
+    void finish_ghosts();
+
+    /**
+     * Add the forces of the ghost particles to the particles they are images of and remove the ghost particles. The cell list is rebuilt on
+     * the next position update.
+     */
+    void fold_ghost_forces();
+
+    /**
+     * Get the number of ghost particles currently appended to the particle vector.
+     *
+     * @return The number of ghost particles.
+     */
+    size_t get_ghost_count() const;
+
+    /**
+     * Get the width of the halo cells surrounding the domain in every direction.
+     *
+     * @return The width of the halo cells.
+     */
+    Vec<double> get_halo_width() const;
 };
+
+template <typename F> inline void BoxContainer::for_each_pair(const F& iterator) {
+    if (ghosts_active) {
+        const double rc_squ = cells.getRC() * cells.getRC();
+
+        for_each_candidate_pair([this, &iterator, rc_squ](const size_t i, const size_t j) {
+            const Vec<double> diff = particles[i].getX() - particles[j].getX();
+            const double dist_squ = diff.len_squ();
+
+            if (dist_squ <= rc_squ) {
+                visit_pair(iterator, particles[i], particles[j], diff, dist_squ);
+            }
+        });
+    } else if (use_verlet) {
+        verlet.for_each_pair(iterator, particles);
+    } else {
+        cells.for_each_cell_pair(iterator, particles);
+    }
+}
+
+template <typename F> inline void BoxContainer::for_each_periodic_pair(const F& iterator, const std::array<bool, 3>& periodic) {
+    cells.for_each_periodic_pair(iterator, particles, periodic);
+}
+
+template <typename F> inline auto BoxContainer::ghost_filter(const F& iterator) {
+    return [this, &iterator](const size_t i, const size_t j) {
+        if (i < owned && j < owned) {
+            iterator(i, j);
+        } else if (i < owned) {
+            if (i < ghost_owner[j - owned]) {
+                iterator(i, j);
+            }
+        } else if (j < owned) {
+            if (j < ghost_owner[i - owned]) {
+                iterator(i, j);
+            }
+        }
+    };
+}
+
+template <typename F> inline void BoxContainer::for_each_candidate_pair(const F& iterator) {
+    if (ghosts_active) {
+        cells.for_each_ghost_candidate_pair(ghost_filter(iterator));
+    } else if (use_verlet) {
+        verlet.for_each_candidate_pair(iterator);
+    } else {
+        cells.for_each_candidate_pair(iterator);
+    }
+}
+
+template <typename F> inline void BoxContainer::for_each_colored_candidate_pair(const F& iterator) {
+    if (ghosts_active) {
+        cells.for_each_colored_candidate_pair(ghost_filter(iterator), true);
+    } else if (use_verlet) {
+        // The neighbor lists of different particles share their neighbors, such that they cannot be traversed concurrently
+        verlet.for_each_candidate_pair(iterator);
+    } else {
+        cells.for_each_colored_candidate_pair(iterator);
+    }
+}
+
+template <typename F> inline void BoxContainer::for_each_distributed_candidate_pair(const F& iterator) {
+    if (ghosts_active) {
+        cells.for_each_distributed_candidate_pair(ghost_filter(iterator), true);
+    } else if (use_verlet) {
+        verlet.for_each_distributed_candidate_pair(iterator);
+    } else {
+        cells.for_each_distributed_candidate_pair(iterator);
+    }
+}
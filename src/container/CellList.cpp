@@ -1,26 +1,73 @@
 #include "CellList.h"
 
+#include "utils/Morton.h"
+#include "utils/Numa.h"
 #include "utils/Vec.h"
 
 #include <algorithm>
 #include <cmath>
+#include <numeric>
 
 #include <spdlog/spdlog.h>
 
-CellList::CellList(const double rc, const Vec<double>& domain) {
+CellList::CellList(const double rc, const Vec<double>& domain, const double skin, const size_t sub_cells, const size_t dimensions) {
+    if (sub_cells == 0) {
+        SPDLOG_CRITICAL("The linked cells require at least one sub cell per cutoff distance.");
+        std::exit(EXIT_FAILURE);
+    }
+
+    if (dimensions != 2 && dimensions != 3) {
+        SPDLOG_CRITICAL("The linked cells only support two or three dimensions.");
+        std::exit(EXIT_FAILURE);
+    }
+
     this->rc = rc;
+    this->dimensions = dimensions;
     rc_squ = rc * rc;
-    n_x = std::ceil(domain[0] / rc) + 2;
-    n_y = std::ceil(domain[1] / rc) + 2;
-    n_z = std::ceil(domain[2] / rc) + 2;
+    layers = sub_cells;
+
+    // The cells must not be smaller than the cutoff distance divided by the number of sub cells, otherwise the stencil misses pairs
+    n_x = std::max(std::floor(domain[0] * sub_cells / (rc + skin)), 1.0) + 2 * layers;
+    n_y = std::max(std::floor(domain[1] * sub_cells / (rc + skin)), 1.0) + 2 * layers;
+
+    // A two dimensional simulation only uses a single layer of cells along the z axis
+    n_z = dimensions == 2 ? 1 + 2 * layers : std::max(std::floor(domain[2] * sub_cells / (rc + skin)), 1.0) + 2 * layers;
 
     cell_size = {
-        domain[0] / static_cast<double>(n_x - 2),
-        domain[1] / static_cast<double>(n_y - 2),
-        domain[2] / static_cast<double>(n_z - 2),
+        domain[0] / static_cast<double>(n_x - 2 * layers),
+        domain[1] / static_cast<double>(n_y - 2 * layers),
+        domain[2] / static_cast<double>(n_z - 2 * layers),
     };
 
-    cells.resize(this->n_x * this->n_y * this->n_z);
+    cell_start.resize(this->n_x * this->n_y * this->n_z + 1);
+
+    // Collect the half shell of neighbor cells, which are lexicographically larger than the cell itself and may contain particles within the
+    // cutoff distance plus the skin. Together with the cell itself, every neighboring cell pair is covered exactly once.
+    const int reach = static_cast<int>(layers);
+    const int reach_z = dimensions == 2 ? 0 : reach;
+    const double list_squ = (rc + skin) * (rc + skin);
+
+    for (int x = 0; x <= reach; x++) {
+        for (int y = x == 0 ? 0 : -reach; y <= reach; y++) {
+            for (int z = x == 0 && y == 0 ? 1 : -reach_z; z <= reach_z; z++) {
+                // The smallest distance between two points of the cells
+                const Vec<double> gap = {
+                    std::max(std::abs(x) - 1, 0) * cell_size[0],
+                    std::max(std::abs(y) - 1, 0) * cell_size[1],
+                    std::max(std::abs(z) - 1, 0) * cell_size[2],
+                };
+
+                if (gap.len_squ() < list_squ) {
+                    // Compute the flat index offset of the neighbor cell (unsigned overflow is intended for negative offsets)
+                    stencil.push_back(static_cast<size_t>(z) + static_cast<size_t>(y) * n_z + static_cast<size_t>(x) * n_y * n_z);
+                    stencil_offsets.push_back({ x, y, z });
+                }
+            }
+        }
+    }
+
+    // The neighborhood of a cell spans the stencil reach along x and twice the reach along y and z, cells of the same color must be further apart
+    color_stride = { layers + 1, 2 * layers + 1, dimensions == 2 ? 1 : 2 * layers + 1 };
 
     dom = domain;
     domain_x = { domain[0], 0.0, 0.0 };
@@ -31,617 +78,422 @@ CellList::CellList(const double rc, const Vec<double>& domain) {
     domain_yz = { 0.0, domain[1], domain[2] };
 }
 
-void CellList::create_list(const std::vector<Particle>& particles) {
-    for (auto& l : cells) {
-        l.clear();
-    }
-
-    for (size_t i = 0; i < particles.size(); i++) {
-        size_t x = std::floor(particles[i].getX()[0] / cell_size[0]) + 1;
-        size_t y = std::floor(particles[i].getX()[1] / cell_size[1]) + 1;
-        size_t z = std::floor(particles[i].getX()[2] / cell_size[2]) + 1;
-
-        if (x < 0 || x >= n_x) [[unlikely]] {
-            SPDLOG_CRITICAL("Tried to add a particle out of bounds.");
-            std::exit(EXIT_FAILURE);
-        }
-
-        if (y < 0 || y >= n_y) [[unlikely]] {
-            SPDLOG_CRITICAL("Tried to add a particle out of bounds.");
-            std::exit(EXIT_FAILURE);
-        }
+size_t CellList::compute_cell_index(const Vec<double>& pos) const {
+    size_t x = std::floor(pos[0] / cell_size[0]) + layers;
+    size_t y = std::floor(pos[1] / cell_size[1]) + layers;
+    size_t z = std::floor(pos[2] / cell_size[2]) + layers;
 
-        if (z < 0 || z >= n_z) [[unlikely]] {
-            SPDLOG_CRITICAL("Tried to add a particle out of bounds.");
-            std::exit(EXIT_FAILURE);
-        }
+    if (x < 0 || x >= n_x) [[unlikely]] {
+        SPDLOG_CRITICAL("Tried to add a particle out of bounds.");
+        std::exit(EXIT_FAILURE);
+    }
 
-        cells[get_cell_index(x, y, z)].push_back(i);
+    if (y < 0 || y >= n_y) [[unlikely]] {
+        SPDLOG_CRITICAL("Tried to add a particle out of bounds.");
+        std::exit(EXIT_FAILURE);
     }
-}
 
-size_t CellList::get_cell_index(const size_t x, const size_t y, const size_t z) { return z + y * n_z + x * n_y * n_z; }
+    if (z < 0 || z >= n_z) [[unlikely]] {
+        SPDLOG_CRITICAL("Tried to add a particle out of bounds.");
+        std::exit(EXIT_FAILURE);
+    }
 
-Vec<double> CellList::get_corner_vector() {
-    return {
-        rc * (n_x - 2),
-        rc * (n_y - 2),
-        rc * (n_z - 2),
-    };
+    return get_cell_index(x, y, z);
 }
 
-void CellList::loop_cell_pairs(const std::function<particle_pair_it>& iterator, std::vector<Particle>& particles) {
-    // Loop through the cells using the indices, ignore halo cells
-    for (size_t i = 1; i < n_x - 1; i++) {
-        for (size_t j = 1; j < n_y - 1; j++) {
-            for (size_t k = 1; k < n_z - 1; k++) {
-                const size_t idx = get_cell_index(i, j, k);
-
-                for (auto l1_it = cells[idx].begin(); l1_it != cells[idx].end(); l1_it++) {
-                    auto l2_it = l1_it;
-                    l2_it++;
-                    for (; l2_it != cells[idx].end(); l2_it++) {
-                        if ((particles[*l1_it].getX() - particles[*l2_it].getX()).len_squ() <= rc_squ) {
-                            iterator(particles[*l1_it], particles[*l2_it]);
-                        }
-                    }
-                }
-
-                // Loop through the direct neighbors
-                for (size_t l : cells[idx]) {
-                    Particle& self = particles[l];
-                    for (size_t m : cells[get_cell_index(i + 1, j, k)]) {
-                        if ((self.getX() - particles[m].getX()).len_squ() <= rc_squ) {
-                            iterator(self, particles[m]);
-                        }
-                    }
-
-                    for (size_t m : cells[get_cell_index(i, j + 1, k)]) {
-                        if ((self.getX() - particles[m].getX()).len_squ() <= rc_squ) {
-                            iterator(self, particles[m]);
-                        }
-                    }
-
-                    for (size_t m : cells[get_cell_index(i, j, k + 1)]) {
-                        if ((self.getX() - particles[m].getX()).len_squ() <= rc_squ) {
-                            iterator(self, particles[m]);
-                        }
-                    }
+void CellList::create_list(const std::vector<Particle>& particles) {
+    std::fill(cell_start.begin(), cell_start.end(), 0);
+    particle_cell.resize(particles.size());
 
-                    // Loop through the neighbors with shared edge
-                    for (size_t m : cells[get_cell_index(i + 1, j + 1, k)]) {
-                        if ((self.getX() - particles[m].getX()).len_squ() <= rc_squ) {
-                            iterator(self, particles[m]);
-                        }
-                    }
+    // Count the particles per cell
+    for (size_t i = 0; i < particles.size(); i++) {
+        particle_cell[i] = compute_cell_index(particles[i].getX());
+        cell_start[particle_cell[i] + 1]++;
+    }
 
-                    for (size_t m : cells[get_cell_index(i + 1, j, k + 1)]) {
-                        if ((self.getX() - particles[m].getX()).len_squ() <= rc_squ) {
-                            iterator(self, particles[m]);
-                        }
-                    }
+    // Compute the offsets of the cells using the prefix sum of the counts
+    for (size_t i = 1; i < cell_start.size(); i++) {
+        cell_start[i] += cell_start[i - 1];
+    }
 
-                    for (size_t m : cells[get_cell_index(i, j + 1, k + 1)]) {
-                        if ((self.getX() - particles[m].getX()).len_squ() <= rc_squ) {
-                            iterator(self, particles[m]);
-                        }
-                    }
+    // Place the particle indices into their cells, the order within a cell is stable
+    cell_fill.assign(cell_start.begin(), cell_start.end() - 1);
+    cell_particles.resize(particles.size());
+    particle_pos.resize(particles.size());
 
-                    // Loop through the neighbors with shared corners
-                    for (size_t m : cells[get_cell_index(i + 1, j + 1, k + 1)]) {
-                        if ((self.getX() - particles[m].getX()).len_squ() <= rc_squ) {
-                            iterator(self, particles[m]);
-                        }
-                    }
+    for (size_t i = 0; i < particles.size(); i++) {
+        particle_pos[i] = cell_fill[particle_cell[i]]++;
+        cell_particles[particle_pos[i]] = i;
+    }
 
-                    // Loop backwards particles
-                    for (size_t m : cells[get_cell_index(i + 1, j - 1, k)]) {
-                        if ((self.getX() - particles[m].getX()).len_squ() <= rc_squ) {
-                            iterator(self, particles[m]);
-                        }
-                    }
+    full_builds++;
+}
 
-                    for (size_t m : cells[get_cell_index(i + 1, j, k - 1)]) {
-                        if ((self.getX() - particles[m].getX()).len_squ() <= rc_squ) {
-                            iterator(self, particles[m]);
-                        }
-                    }
+bool CellList::update_list(const std::vector<Particle>& particles) {
+    // The particle indices changed, if particles were added or removed
+    if (particles.size() != particle_cell.size()) {
+        create_list(particles);
+        return true;
+    }
 
-                    for (size_t m : cells[get_cell_index(i + 1, j - 1, k - 1)]) {
-                        if ((self.getX() - particles[m].getX()).len_squ() <= rc_squ) {
-                            iterator(self, particles[m]);
-                        }
-                    }
+    movers.clear();
 
-                    // Loop sidewards particles
-                    for (size_t m : cells[get_cell_index(i - 1, j - 1, k + 1)]) {
-                        if ((self.getX() - particles[m].getX()).len_squ() <= rc_squ) {
-                            iterator(self, particles[m]);
-                        }
-                    }
+    // Count the swaps of the incremental update, a mover is swapped through every cell between its old and its new cell
+    size_t swaps = 0;
 
-                    for (size_t m : cells[get_cell_index(i, j - 1, k + 1)]) {
-                        if ((self.getX() - particles[m].getX()).len_squ() <= rc_squ) {
-                            iterator(self, particles[m]);
-                        }
-                    }
+    for (size_t i = 0; i < particles.size(); i++) {
+        const size_t idx = compute_cell_index(particles[i].getX());
 
-                    for (size_t m : cells[get_cell_index(i + 1, j - 1, k + 1)]) {
-                        if ((self.getX() - particles[m].getX()).len_squ() <= rc_squ) {
-                            iterator(self, particles[m]);
-                        }
-                    }
-                }
-            }
+        if (idx != particle_cell[i]) {
+            movers.push_back({ i, idx });
+            swaps += idx > particle_cell[i] ? idx - particle_cell[i] : particle_cell[i] - idx;
         }
     }
-}
 
-void CellList::loop_halo(const std::function<particle_it>& iterator, std::vector<Particle>& particles) {
-    for (size_t i = 0; i < n_x; i++) {
-        for (size_t j = 0; j < n_y; j++) {
-            for (size_t k : cells[get_cell_index(i, j, 0)]) {
-                iterator(particles[k]);
-            }
-
-            for (size_t k : cells[get_cell_index(i, j, n_z - 1)]) {
-                iterator(particles[k]);
-            }
-        }
+    if (movers.empty()) {
+        return false;
     }
 
-    for (size_t i = 0; i < n_x; i++) {
-        for (size_t j = 1; j < n_z - 1; j++) {
-            for (size_t k : cells[get_cell_index(i, 0, j)]) {
-                iterator(particles[k]);
-            }
-
-            for (size_t k : cells[get_cell_index(i, n_y - 1, j)]) {
-                iterator(particles[k]);
-            }
-        }
+    // A full build visits every particle and every cell once, which is cheaper than movers crossing many cells, e.g. along the x axis
+    if (static_cast<double>(movers.size()) > rebuild_fraction * static_cast<double>(particles.size())
+        || swaps > particles.size() + cell_start.size()) {
+        create_list(particles);
+        return true;
     }
 
-    for (size_t i = 1; i < n_y - 1; i++) {
-        for (size_t j = 1; j < n_z - 1; j++) {
-            for (size_t k : cells[get_cell_index(0, i, j)]) {
-                iterator(particles[k]);
-            }
-
-            for (size_t k : cells[get_cell_index(n_x - 1, i, j)]) {
-                iterator(particles[k]);
-            }
-        }
+    for (const auto& [i, idx] : movers) {
+        move_particle(i, idx);
     }
+
+    return true;
 }
 
-void CellList::loop_boundary(const std::function<particle_it>& iterator, std::vector<Particle>& particles) {
-    for (size_t i = 1; i < n_x - 1; i++) {
-        for (size_t j = 1; j < n_y - 1; j++) {
-            for (size_t k : cells[get_cell_index(i, j, 1)]) {
-                iterator(particles[k]);
-            }
+void CellList::move_particle(const size_t i, const size_t idx) {
+    size_t pos = particle_pos[i];
 
-            for (size_t k : cells[get_cell_index(i, j, n_z - 2)]) {
-                iterator(particles[k]);
-            }
-        }
+    // Move the particle through the cells in between by swapping it with the boundary element of every cell and moving the cell boundary
+    for (size_t c = particle_cell[i]; c < idx; c++) {
+        const size_t last = cell_start[c + 1] - 1;
+        std::swap(cell_particles[pos], cell_particles[last]);
+        particle_pos[cell_particles[pos]] = pos;
+        pos = last;
+        cell_start[c + 1]--;
     }
 
-    for (size_t i = 1; i < n_x - 1; i++) {
-        for (size_t j = 2; j < n_z - 2; j++) {
-            for (size_t k : cells[get_cell_index(i, 1, j)]) {
-                iterator(particles[k]);
-            }
-
-            for (size_t k : cells[get_cell_index(i, n_y - 2, j)]) {
-                iterator(particles[k]);
-            }
-        }
+    for (size_t c = particle_cell[i]; c > idx; c--) {
+        const size_t first = cell_start[c];
+        std::swap(cell_particles[pos], cell_particles[first]);
+        particle_pos[cell_particles[pos]] = pos;
+        pos = first;
+        cell_start[c]++;
     }
 
-    for (size_t i = 2; i < n_y - 2; i++) {
-        for (size_t j = 2; j < n_z - 2; j++) {
-            for (size_t k : cells[get_cell_index(1, i, j)]) {
-                iterator(particles[k]);
-            }
-
-            for (size_t k : cells[get_cell_index(n_x - 2, i, j)]) {
-                iterator(particles[k]);
-            }
-        }
-    }
+    particle_pos[i] = pos;
+    particle_cell[i] = idx;
 }
 
-void CellList::loop_inner(const std::function<particle_it>& iterator, std::vector<Particle>& particles) {
-    for (size_t i = 1; i < n_x - 1; i++) {
-        for (size_t j = 1; j < n_y - 1; j++) {
-            for (size_t k = 1; k < n_z - 1; k++) {
-                for (size_t l : cells[get_cell_index(i, j, k)]) {
-                    iterator(particles[l]);
-                }
-            }
-        }
+void CellList::reorder_particles(std::vector<Particle>& particles) {
+    // Write the reordered arrays into the existing allocations, whose pages were placed by the first touch
+    const std::vector<Particle> unsorted = particles;
+    const std::vector<size_t> unsorted_cell = particle_cell;
+
+    for (size_t i = 0; i < cell_particles.size(); i++) {
+        particles[i] = unsorted[cell_particles[i]];
+        particle_cell[i] = unsorted_cell[cell_particles[i]];
     }
-}
 
-void CellList::loop_xy_pairs(const std::function<particle_pair_it>& iterator, std::vector<Particle>& particles) {
-    for (size_t i = 1; i < n_x - 1; i++) {
-        for (size_t j = 1; j < n_y - 1; j++) {
-            for (size_t k : cells[get_cell_index(i, j, 1)]) {
-                // Loop over the cells using the newton optimization
-                for (size_t l : cells[get_cell_index(i - 1, j - 1, n_z - 2)]) {
-                    if ((particles[k].getX() - particles[l].getX() + domain_z).len_squ() <= rc_squ) {
-                        iterator(particles[k], particles[l]);
-                    }
-                }
+    // The particles are stored in cell order, therefore every cell stores a contiguous index range
+    std::iota(cell_particles.begin(), cell_particles.end(), 0);
+    std::iota(particle_pos.begin(), particle_pos.end(), 0);
+}
 
-                for (size_t l : cells[get_cell_index(i, j - 1, n_z - 2)]) {
-                    if ((particles[k].getX() - particles[l].getX() + domain_z).len_squ() <= rc_squ) {
-                        iterator(particles[k], particles[l]);
-                    }
-                }
+size_t CellList::get_full_builds() const { return full_builds; }
 
-                for (size_t l : cells[get_cell_index(i + 1, j - 1, n_z - 2)]) {
-                    if ((particles[k].getX() - particles[l].getX() + domain_z).len_squ() <= rc_squ) {
-                        iterator(particles[k], particles[l]);
-                    }
-                }
+Vec<double> CellList::get_corner_vector() {
+    return {
+        rc * (n_x - 2 * layers) / layers,
+        rc * (n_y - 2 * layers) / layers,
+        rc * (n_z - 2 * layers) / layers,
+    };
+}
 
-                for (size_t l : cells[get_cell_index(i - 1, j, n_z - 2)]) {
-                    if ((particles[k].getX() - particles[l].getX() + domain_z).len_squ() <= rc_squ) {
-                        iterator(particles[k], particles[l]);
-                    }
-                }
+void CellList::loop_cell_pairs(const std::function<particle_pair_it>& iterator, std::vector<Particle>& particles) {
+    for_each_cell_pair(iterator, particles);
+}
 
-                for (size_t l : cells[get_cell_index(i, j, n_z - 2)]) {
-                    if ((particles[k].getX() - particles[l].getX() + domain_z).len_squ() <= rc_squ) {
-                        iterator(particles[k], particles[l]);
-                    }
-                }
+void CellList::loop_cell_index_pairs(const std::function<index_pair_it>& iterator, const std::vector<Particle>& particles, const double dist_squ) {
+    for_each_index_pair(iterator, particles, dist_squ);
+}
 
-                for (size_t l : cells[get_cell_index(i + 1, j, n_z - 2)]) {
-                    if ((particles[k].getX() - particles[l].getX() + domain_z).len_squ() <= rc_squ) {
-                        iterator(particles[k], particles[l]);
+void CellList::build_tasks(const bool ghosts, const bool colored) {
+    // The ghost traversal includes the halo cells
+    const size_t first = ghosts ? 0 : layers;
+    const size_t x_end = ghosts ? n_x : n_x - layers;
+    const size_t y_end = ghosts ? n_y : n_y - layers;
+    const size_t z_end = ghosts ? n_z : (dimensions == 2 ? layers + 1 : n_z - layers);
+    const std::array<size_t, 3> stride = colored ? color_stride : std::array<size_t, 3> { 1, 1, 1 };
+    const size_t groups = stride[0] * stride[1] * stride[2];
+    // Inside a parallel region, the maximum number of threads refers to the next nesting level instead of the team
+    const size_t threads = Threads::get_num_threads() > 1 ? Threads::get_num_threads() : Threads::get_max_threads();
+    const double blocks = static_cast<double>(threads * blocks_per_thread);
+
+    task_cells.clear();
+    task_costs.clear();
+    task_blocks.clear();
+    task_groups.assign(1, 0);
+
+    for (size_t c = 0; c < groups; c++) {
+        const size_t c_x = first + c / (stride[1] * stride[2]);
+        const size_t c_y = first + c / stride[2] % stride[1];
+        const size_t c_z = first + c % stride[2];
+        const size_t group_first = task_cells.size();
+        double group_cost = 0.0;
+
+        for (size_t i = c_x; i < x_end; i += stride[0]) {
+            for (size_t j = c_y; j < y_end; j += stride[1]) {
+                for (size_t k = c_z; k < z_end; k += stride[2]) {
+                    const double cost = estimate_cost(i, j, k);
+
+                    if (cost > 0.0) {
+                        task_cells.push_back(get_cell_index(i, j, k));
+                        task_costs.push_back(cost);
+                        group_cost += cost;
                     }
                 }
+            }
+        }
 
-                for (size_t l : cells[get_cell_index(i - 1, j + 1, n_z - 2)]) {
-                    if ((particles[k].getX() - particles[l].getX() + domain_z).len_squ() <= rc_squ) {
-                        iterator(particles[k], particles[l]);
-                    }
-                }
+        // Split the cells of the group into consecutive blocks of roughly equal cost, which keeps neighboring cells within the same task
+        const double target = group_cost / blocks;
+        const size_t group_blocks = task_blocks.size();
+        CellBlock block { group_first, group_first, 0.0 };
 
-                for (size_t l : cells[get_cell_index(i, j + 1, n_z - 2)]) {
-                    if ((particles[k].getX() - particles[l].getX() + domain_z).len_squ() <= rc_squ) {
-                        iterator(particles[k], particles[l]);
-                    }
-                }
+        for (size_t t = group_first; t < task_cells.size(); t++) {
+            block.last = t + 1;
+            block.cost += task_costs[t];
 
-                for (size_t l : cells[get_cell_index(i + 1, j + 1, n_z - 2)]) {
-                    if ((particles[k].getX() - particles[l].getX() + domain_z).len_squ() <= rc_squ) {
-                        iterator(particles[k], particles[l]);
-                    }
-                }
+            if (block.cost >= target) {
+                task_blocks.push_back(block);
+                block = { t + 1, t + 1, 0.0 };
             }
         }
+
+        if (block.first != block.last) {
+            task_blocks.push_back(block);
+        }
+
+        // Queue the expensive blocks first, such that the cheap blocks fill the gaps at the end
+        std::sort(task_blocks.begin() + group_blocks, task_blocks.end(), [](const CellBlock& a, const CellBlock& b) { return a.cost > b.cost; });
+        task_groups.push_back(task_blocks.size());
     }
 }
 
-void CellList::loop_xz_pairs(const std::function<particle_pair_it>& iterator, std::vector<Particle>& particles) {
-    for (size_t i = 1; i < n_x - 1; i++) {
-        for (size_t j = 1; j < n_z - 1; j++) {
-            for (size_t k : cells[get_cell_index(i, 1, j)]) {
-                // Loop over the cells using the newton optimization
-                for (size_t l : cells[get_cell_index(i - 1, n_y - 2, j - 1)]) {
-                    if ((particles[k].getX() - particles[l].getX() + domain_y).len_squ() <= rc_squ) {
-                        iterator(particles[k], particles[l]);
-                    }
-                }
+double CellList::estimate_cost(const size_t x, const size_t y, const size_t z) const {
+    const size_t idx = get_cell_index(x, y, z);
+    const double self = static_cast<double>(cell(idx).size());
 
-                for (size_t l : cells[get_cell_index(i, n_y - 2, j - 1)]) {
-                    if ((particles[k].getX() - particles[l].getX() + domain_y).len_squ() <= rc_squ) {
-                        iterator(particles[k], particles[l]);
-                    }
-                }
-
-                for (size_t l : cells[get_cell_index(i + 1, n_y - 2, j - 1)]) {
-                    if ((particles[k].getX() - particles[l].getX() + domain_y).len_squ() <= rc_squ) {
-                        iterator(particles[k], particles[l]);
-                    }
-                }
+    if (self == 0.0) {
+        return 0.0;
+    }
 
-                for (size_t l : cells[get_cell_index(i - 1, n_y - 2, j)]) {
-                    if ((particles[k].getX() - particles[l].getX() + domain_y).len_squ() <= rc_squ) {
-                        iterator(particles[k], particles[l]);
-                    }
-                }
+    // Every particle of the cell is paired with the later particles of the cell and all particles of the half shell neighbors
+    double partners = (self - 1.0) / 2.0;
 
-                for (size_t l : cells[get_cell_index(i, n_y - 2, j)]) {
-                    if ((particles[k].getX() - particles[l].getX() + domain_y).len_squ() <= rc_squ) {
-                        iterator(particles[k], particles[l]);
-                    }
-                }
+    for (size_t s = 0; s < stencil.size(); s++) {
+        // Skip the neighbors outside of the cell grid (unsigned overflow is intended for negative coordinates)
+        if (x + stencil_offsets[s][0] < n_x && y + stencil_offsets[s][1] < n_y && z + stencil_offsets[s][2] < n_z) {
+            partners += static_cast<double>(cell(idx + stencil[s]).size());
+        }
+    }
 
-                for (size_t l : cells[get_cell_index(i + 1, n_y - 2, j)]) {
-                    if ((particles[k].getX() - particles[l].getX() + domain_y).len_squ() <= rc_squ) {
-                        iterator(particles[k], particles[l]);
-                    }
-                }
+    return self * partners;
+}
 
-                for (size_t l : cells[get_cell_index(i - 1, n_y - 2, j + 1)]) {
-                    if ((particles[k].getX() - particles[l].getX() + domain_y).len_squ() <= rc_squ) {
-                        iterator(particles[k], particles[l]);
-                    }
-                }
+void CellList::build_balance_cells(const bool ghosts) {
+    // The ghost traversal includes the halo cells
+    const size_t first = ghosts ? 0 : layers;
+    const size_t x_end = ghosts ? n_x : n_x - layers;
+    const size_t y_end = ghosts ? n_y : n_y - layers;
+    const size_t z_end = ghosts ? n_z : (dimensions == 2 ? layers + 1 : n_z - layers);
 
-                for (size_t l : cells[get_cell_index(i, n_y - 2, j + 1)]) {
-                    if ((particles[k].getX() - particles[l].getX() + domain_y).len_squ() <= rc_squ) {
-                        iterator(particles[k], particles[l]);
-                    }
-                }
+    balance_ghosts = ghosts;
+    balance_cells.clear();
 
-                for (size_t l : cells[get_cell_index(i + 1, n_y - 2, j + 1)]) {
-                    if ((particles[k].getX() - particles[l].getX() + domain_y).len_squ() <= rc_squ) {
-                        iterator(particles[k], particles[l]);
-                    }
-                }
+    for (size_t i = first; i < x_end; i++) {
+        for (size_t j = first; j < y_end; j++) {
+            for (size_t k = first; k < z_end; k++) {
+                balance_cells.push_back({ i, j, k });
             }
         }
     }
-}
-
-void CellList::loop_yz_pairs(const std::function<particle_pair_it>& iterator, std::vector<Particle>& particles) {
-    for (size_t i = 1; i < n_y - 1; i++) {
-        for (size_t j = 1; j < n_z - 1; j++) {
-            for (size_t k : cells[get_cell_index(1, i, j)]) {
-                // Loop over the cells using the newton optimization
-                for (size_t l : cells[get_cell_index(n_x - 2, i - 1, j - 1)]) {
-                    if ((particles[k].getX() - particles[l].getX() + domain_x).len_squ() <= rc_squ) {
-                        iterator(particles[k], particles[l]);
-                    }
-                }
 
-                for (size_t l : cells[get_cell_index(n_x - 2, i, j - 1)]) {
-                    if ((particles[k].getX() - particles[l].getX() + domain_x).len_squ() <= rc_squ) {
-                        iterator(particles[k], particles[l]);
-                    }
-                }
+    std::sort(balance_cells.begin(), balance_cells.end(), [](const std::array<size_t, 3>& a, const std::array<size_t, 3>& b) {
+        return Morton::key(a[0], a[1], a[2]) < Morton::key(b[0], b[1], b[2]);
+    });
+}
 
-                for (size_t l : cells[get_cell_index(n_x - 2, i + 1, j - 1)]) {
-                    if ((particles[k].getX() - particles[l].getX() + domain_x).len_squ() <= rc_squ) {
-                        iterator(particles[k], particles[l]);
-                    }
-                }
+void CellList::cut_partition(const size_t threads, const bool measured) {
+    std::vector<double> costs(balance_cells.size());
 
-                for (size_t l : cells[get_cell_index(n_x - 2, i - 1, j)]) {
-                    if ((particles[k].getX() - particles[l].getX() + domain_x).len_squ() <= rc_squ) {
-                        iterator(particles[k], particles[l]);
-                    }
-                }
+    // Every cell costs at least the visit itself, such that empty regions are split among the threads as well
+    for (size_t c = 0; c < balance_cells.size(); c++) {
+        costs[c] = 1.0 + estimate_cost(balance_cells[c][0], balance_cells[c][1], balance_cells[c][2]);
+    }
 
-                for (size_t l : cells[get_cell_index(n_x - 2, i, j)]) {
-                    if ((particles[k].getX() - particles[l].getX() + domain_x).len_squ() <= rc_squ) {
-                        iterator(particles[k], particles[l]);
-                    }
-                }
+    if (measured) {
+        for (size_t t = 0; t < threads; t++) {
+            const double estimated = std::accumulate(costs.begin() + balance_bounds[t], costs.begin() + balance_bounds[t + 1], 0.0);
 
-                for (size_t l : cells[get_cell_index(n_x - 2, i + 1, j)]) {
-                    if ((particles[k].getX() - particles[l].getX() + domain_x).len_squ() <= rc_squ) {
-                        iterator(particles[k], particles[l]);
-                    }
-                }
+            for (size_t c = balance_bounds[t]; c < balance_bounds[t + 1]; c++) {
+                costs[c] *= balance_times[t] / estimated;
+            }
+        }
+    }
 
-                for (size_t l : cells[get_cell_index(n_x - 2, i - 1, j + 1)]) {
-                    if ((particles[k].getX() - particles[l].getX() + domain_x).len_squ() <= rc_squ) {
-                        iterator(particles[k], particles[l]);
-                    }
-                }
+    const double total = std::accumulate(costs.begin(), costs.end(), 0.0);
+    double prefix = 0.0;
+    size_t t = 1;
 
-                for (size_t l : cells[get_cell_index(n_x - 2, i, j + 1)]) {
-                    if ((particles[k].getX() - particles[l].getX() + domain_x).len_squ() <= rc_squ) {
-                        iterator(particles[k], particles[l]);
-                    }
-                }
+    balance_bounds.assign(threads + 1, balance_cells.size());
+    balance_bounds[0] = 0;
+    balance_times.assign(threads, 0.0);
 
-                for (size_t l : cells[get_cell_index(n_x - 2, i + 1, j + 1)]) {
-                    if ((particles[k].getX() - particles[l].getX() + domain_x).len_squ() <= rc_squ) {
-                        iterator(particles[k], particles[l]);
-                    }
-                }
-            }
+    // The range of the next thread starts, as soon as the previous ranges reached their share of the total cost
+    for (size_t c = 0; c < balance_cells.size() && t < threads; c++) {
+        while (t < threads && prefix >= total * static_cast<double>(t) / static_cast<double>(threads)) {
+            balance_bounds[t++] = c;
         }
+
+        prefix += costs[c];
     }
 }
 
-void CellList::loop_x_near(const std::function<particle_pair_it>& iterator, std::vector<Particle>& particles) {
-    for (size_t i = 1; i < n_x - 1; i++) {
-        for (size_t l : cells[get_cell_index(i, 1, 1)]) {
-            // Loop over x axis
-            for (size_t m : cells[get_cell_index(i - 1, n_y - 2, n_z - 2)]) {
-                if ((particles[l].getX() - particles[m].getX() + domain_yz).len_squ() <= rc_squ) {
-                    iterator(particles[l], particles[m]);
-                }
-            }
+void CellList::finish_balanced_traversal(const size_t threads) {
+    const double max = *std::max_element(balance_times.begin(), balance_times.end());
+    const double mean = std::accumulate(balance_times.begin(), balance_times.end(), 0.0) / static_cast<double>(threads);
 
-            for (size_t m : cells[get_cell_index(i, n_y - 2, n_z - 2)]) {
-                if ((particles[l].getX() - particles[m].getX() + domain_yz).len_squ() <= rc_squ) {
-                    iterator(particles[l], particles[m]);
-                }
-            }
+    imbalance = mean > 0.0 ? max / mean - 1.0 : 0.0;
+    imbalance_sum += imbalance;
+    balanced_traversals++;
 
-            for (size_t m : cells[get_cell_index(i + 1, n_y - 2, n_z - 2)]) {
-                if ((particles[l].getX() - particles[m].getX() + domain_yz).len_squ() <= rc_squ) {
-                    iterator(particles[l], particles[m]);
-                }
-            }
-        }
+    if (imbalance > balance) {
+        cut_partition(threads, true);
+        rebalances++;
     }
 }
 
-void CellList::loop_x_far(const std::function<particle_pair_it>& iterator, std::vector<Particle>& particles) {
-    for (size_t i = 1; i < n_x - 1; i++) {
-        for (size_t l : cells[get_cell_index(i, n_y - 2, 1)]) {
-            // Loop over shifted x axis
-            for (size_t m : cells[get_cell_index(i - 1, 1, n_z - 2)]) {
-                if ((particles[l].getX() - particles[m].getX() - domain_y + domain_z).len_squ() <= rc_squ) {
-                    iterator(particles[l], particles[m]);
-                }
-            }
+size_t CellList::get_layer(const size_t x, const size_t y, const size_t z) const {
+    return std::min({ x, y, z, n_x - 1 - x, n_y - 1 - y, n_z - 1 - z }) / layers;
+}
+
+void CellList::loop_layer(const std::function<particle_it>& iterator, std::vector<Particle>& particles, const size_t first, const size_t last) {
+    for (size_t i = 0; i < n_x; i++) {
+        for (size_t j = 0; j < n_y; j++) {
+            for (size_t k = 0; k < n_z; k++) {
+                const size_t layer = get_layer(i, j, k);
 
-            for (size_t m : cells[get_cell_index(i, 1, n_z - 2)]) {
-                if ((particles[l].getX() - particles[m].getX() - domain_y + domain_z).len_squ() <= rc_squ) {
-                    iterator(particles[l], particles[m]);
+                if (layer < first || layer > last) {
+                    continue;
                 }
-            }
 
-            for (size_t m : cells[get_cell_index(i + 1, 1, n_z - 2)]) {
-                if ((particles[l].getX() - particles[m].getX() - domain_y + domain_z).len_squ() <= rc_squ) {
-                    iterator(particles[l], particles[m]);
+                for (size_t l : cell(get_cell_index(i, j, k))) {
+                    iterator(particles[l]);
                 }
             }
         }
     }
 }
 
-void CellList::loop_y_near(const std::function<particle_pair_it>& iterator, std::vector<Particle>& particles) {
-    for (size_t i = 1; i < n_y - 1; i++) {
-        for (size_t l : cells[get_cell_index(1, i, 1)]) {
-            // Loop over y axis
-            for (size_t m : cells[get_cell_index(n_x - 2, i - 1, n_z - 2)]) {
-                if ((particles[l].getX() - particles[m].getX() + domain_xz).len_squ() <= rc_squ) {
-                    iterator(particles[l], particles[m]);
-                }
-            }
+void CellList::loop_halo(const std::function<particle_it>& iterator, std::vector<Particle>& particles) { loop_layer(iterator, particles, 0, 0); }
 
-            for (size_t m : cells[get_cell_index(n_x - 2, i, n_z - 2)]) {
-                if ((particles[l].getX() - particles[m].getX() + domain_xz).len_squ() <= rc_squ) {
-                    iterator(particles[l], particles[m]);
-                }
-            }
+void CellList::loop_boundary(const std::function<particle_it>& iterator, std::vector<Particle>& particles) { loop_layer(iterator, particles, 1, 1); }
 
-            for (size_t m : cells[get_cell_index(n_x - 2, i + 1, n_z - 2)]) {
-                if ((particles[l].getX() - particles[m].getX() + domain_xz).len_squ() <= rc_squ) {
-                    iterator(particles[l], particles[m]);
-                }
-            }
-        }
-    }
+void CellList::loop_inner(const std::function<particle_it>& iterator, std::vector<Particle>& particles) {
+    loop_layer(iterator, particles, 1, std::max({ n_x, n_y, n_z }));
 }
 
-void CellList::loop_y_far(const std::function<particle_pair_it>& iterator, std::vector<Particle>& particles) {
-    for (size_t i = 1; i < n_y - 1; i++) {
-        for (size_t l : cells[get_cell_index(n_x - 2, i, 1)]) {
-            // Loop over shifted y axis
-            for (size_t m : cells[get_cell_index(1, i - 1, n_z - 2)]) {
-                if ((particles[l].getX() - particles[m].getX() - domain_x + domain_z).len_squ() <= rc_squ) {
-                    iterator(particles[l], particles[m]);
-                }
-            }
+void CellList::loop_xy_pairs(const std::function<particle_pair_it>& iterator, std::vector<Particle>& particles) {
+    visit_plane_pairs(2, domain_z, iterator, particles);
+}
 
-            for (size_t m : cells[get_cell_index(1, i, n_z - 2)]) {
-                if ((particles[l].getX() - particles[m].getX() - domain_x + domain_z).len_squ() <= rc_squ) {
-                    iterator(particles[l], particles[m]);
-                }
-            }
+void CellList::loop_xz_pairs(const std::function<particle_pair_it>& iterator, std::vector<Particle>& particles) {
+    visit_plane_pairs(1, domain_y, iterator, particles);
+}
 
-            for (size_t m : cells[get_cell_index(1, i + 1, n_z - 2)]) {
-                if ((particles[l].getX() - particles[m].getX() - domain_x + domain_z).len_squ() <= rc_squ) {
-                    iterator(particles[l], particles[m]);
-                }
-            }
-        }
-    }
+void CellList::loop_yz_pairs(const std::function<particle_pair_it>& iterator, std::vector<Particle>& particles) {
+    visit_plane_pairs(0, domain_x, iterator, particles);
 }
 
-void CellList::loop_z_near(const std::function<particle_pair_it>& iterator, std::vector<Particle>& particles) {
-    for (size_t i = 1; i < n_z - 1; i++) {
-        for (size_t l : cells[get_cell_index(1, 1, i)]) {
-            // Loop over z axis
-            for (size_t m : cells[get_cell_index(n_x - 2, n_y - 2, i - 1)]) {
-                if ((particles[l].getX() - particles[m].getX() + domain_xy).len_squ() <= rc_squ) {
-                    iterator(particles[l], particles[m]);
-                }
-            }
+void CellList::loop_x_near(const std::function<particle_pair_it>& iterator, std::vector<Particle>& particles) {
+    visit_edge_pairs(0, { 0, 1, 1 }, { 0, n_y - 2, n_z - 2 }, domain_yz, iterator, particles);
+}
 
-            for (size_t m : cells[get_cell_index(n_x - 2, n_y - 2, i)]) {
-                if ((particles[l].getX() - particles[m].getX() + domain_xy).len_squ() <= rc_squ) {
-                    iterator(particles[l], particles[m]);
-                }
-            }
+void CellList::loop_x_far(const std::function<particle_pair_it>& iterator, std::vector<Particle>& particles) {
+    visit_edge_pairs(0, { 0, n_y - 2, 1 }, { 0, 1, n_z - 2 }, { 0.0, -dom[1], dom[2] }, iterator, particles);
+}
 
-            for (size_t m : cells[get_cell_index(n_x - 2, n_y - 2, i + 1)]) {
-                if ((particles[l].getX() - particles[m].getX() + domain_xy).len_squ() <= rc_squ) {
-                    iterator(particles[l], particles[m]);
-                }
-            }
-        }
-    }
+void CellList::loop_y_near(const std::function<particle_pair_it>& iterator, std::vector<Particle>& particles) {
+    visit_edge_pairs(1, { 1, 0, 1 }, { n_x - 2, 0, n_z - 2 }, domain_xz, iterator, particles);
 }
 
-void CellList::loop_z_far(const std::function<particle_pair_it>& iterator, std::vector<Particle>& particles) {
-    for (size_t i = 1; i < n_z - 1; i++) {
-        for (size_t l : cells[get_cell_index(n_x - 2, 1, i)]) {
-            // Loop over shifted z axis
-            for (size_t m : cells[get_cell_index(1, n_y - 2, i - 1)]) {
-                if ((particles[l].getX() - particles[m].getX() - domain_x + domain_y).len_squ() <= rc_squ) {
-                    iterator(particles[l], particles[m]);
-                }
-            }
+void CellList::loop_y_far(const std::function<particle_pair_it>& iterator, std::vector<Particle>& particles) {
+    visit_edge_pairs(1, { n_x - 2, 0, 1 }, { 1, 0, n_z - 2 }, { -dom[0], 0.0, dom[2] }, iterator, particles);
+}
 
-            for (size_t m : cells[get_cell_index(1, n_y - 2, i)]) {
-                if ((particles[l].getX() - particles[m].getX() - domain_x + domain_y).len_squ() <= rc_squ) {
-                    iterator(particles[l], particles[m]);
-                }
-            }
+void CellList::loop_z_near(const std::function<particle_pair_it>& iterator, std::vector<Particle>& particles) {
+    visit_edge_pairs(2, { 1, 1, 0 }, { n_x - 2, n_y - 2, 0 }, domain_xy, iterator, particles);
+}
 
-            for (size_t m : cells[get_cell_index(1, n_y - 2, i + 1)]) {
-                if ((particles[l].getX() - particles[m].getX() - domain_x + domain_y).len_squ() <= rc_squ) {
-                    iterator(particles[l], particles[m]);
-                }
-            }
-        }
-    }
+void CellList::loop_z_far(const std::function<particle_pair_it>& iterator, std::vector<Particle>& particles) {
+    visit_edge_pairs(2, { n_x - 2, 1, 0 }, { 1, n_y - 2, 0 }, { -dom[0], dom[1], 0.0 }, iterator, particles);
 }
 
 void CellList::loop_origin_corner(const std::function<particle_pair_it>& iterator, std::vector<Particle>& particles) {
-    for (size_t l : cells[get_cell_index(1, 1, 1)]) {
-        for (size_t m : cells[get_cell_index(n_x - 2, n_y - 2, n_z - 2)]) {
-            if ((particles[l].getX() - particles[m].getX() + dom).len_squ() <= rc_squ) {
-                iterator(particles[l], particles[m]);
-            }
-        }
-    }
+    visit_corner_pairs(get_cell_index(1, 1, 1), get_cell_index(n_x - 2, n_y - 2, n_z - 2), dom, iterator, particles);
 }
 
 void CellList::loop_x_corner(const std::function<particle_pair_it>& iterator, std::vector<Particle>& particles) {
-    for (size_t l : cells[get_cell_index(n_x - 2, 1, 1)]) {
-        for (size_t m : cells[get_cell_index(1, n_y - 2, n_z - 2)]) {
-            if ((particles[l].getX() - particles[m].getX() - domain_x + domain_yz).len_squ() <= rc_squ) {
-                iterator(particles[l], particles[m]);
-            }
-        }
-    }
+    visit_corner_pairs(
+        get_cell_index(n_x - 2, 1, 1), get_cell_index(1, n_y - 2, n_z - 2), { -dom[0], dom[1], dom[2] }, iterator, particles);
 }
 
 void CellList::loop_y_corner(const std::function<particle_pair_it>& iterator, std::vector<Particle>& particles) {
-    for (size_t l : cells[get_cell_index(1, n_y - 2, 1)]) {
-        for (size_t m : cells[get_cell_index(n_x - 2, 1, n_z - 2)]) {
-            if ((particles[l].getX() - particles[m].getX() - domain_y + domain_xz).len_squ() <= rc_squ) {
-                iterator(particles[l], particles[m]);
-            }
-        }
-    }
+    visit_corner_pairs(
+        get_cell_index(1, n_y - 2, 1), get_cell_index(n_x - 2, 1, n_z - 2), { dom[0], -dom[1], dom[2] }, iterator, particles);
 }
 
 void CellList::loop_xy_corner(const std::function<particle_pair_it>& iterator, std::vector<Particle>& particles) {
-    for (size_t l : cells[get_cell_index(n_x - 2, n_y - 2, 1)]) {
-        for (size_t m : cells[get_cell_index(1, 1, n_z - 2)]) {
-            if ((particles[l].getX() - particles[m].getX() - domain_xy + domain_z).len_squ() <= rc_squ) {
-                iterator(particles[l], particles[m]);
-            }
-        }
-    }
+    visit_corner_pairs(
+        get_cell_index(n_x - 2, n_y - 2, 1), get_cell_index(1, 1, n_z - 2), { -dom[0], -dom[1], dom[2] }, iterator, particles);
 }
 
 double CellList::getRC() { return rc; }
+
+size_t CellList::get_sub_cells() const { return layers; }
+
+Vec<double> CellList::get_cell_size() const { return cell_size; }
+
+size_t CellList::get_dimensions() const { return dimensions; }
+
+size_t CellList::get_colors() const { return color_stride[0] * color_stride[1] * color_stride[2]; }
+
+void CellList::set_tasks(const bool tasks) { this->tasks = tasks; }
+
+size_t CellList::get_task_blocks() const { return task_blocks.size(); }
+
+void CellList::first_touch(const bool huge_pages) {
+    Numa::first_touch(cell_start, huge_pages);
+    Numa::first_touch(cell_particles, huge_pages);
+    Numa::first_touch(particle_cell, huge_pages);
+    Numa::first_touch(particle_pos, huge_pages);
+}
+
+void CellList::set_balance(const double threshold) { balance = threshold; }
+
+double CellList::get_imbalance() const { return imbalance; }
+
+double CellList::get_mean_imbalance() const { return balanced_traversals > 0 ? imbalance_sum / static_cast<double>(balanced_traversals) : 0.0; }
+
+size_t CellList::get_rebalances() const { return rebalances; }
+
+Vec<double> CellList::get_halo_width() const { return static_cast<double>(layers) * cell_size; }
@@ -7,9 +7,13 @@
 #pragma once
 
 #include "Particle.h"
+#include "utils/Threads.h"
 
+#include <array>
 #include <functional>
 #include <list>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 /**
@@ -19,6 +23,14 @@
  */
 typedef void(particle_pair_it)(Particle&, Particle&);
 
+/**
+ * @typedef displacement_pair_it
+ *
+ * The displacement pair iterator type is a method taking two particle references, the displacement from the second to the first particle and
+ * the squared distance between them.
+ */
+typedef void(displacement_pair_it)(Particle&, Particle&, const Vec<double>&, const double);
+
 /**
  * @typedef particle_it
  *
@@ -26,6 +38,106 @@ typedef void(particle_pair_it)(Particle&, Particle&);
  */
 typedef void(particle_it)(Particle&);
 
+/**
+ * @typedef index_pair_it
+ *
+ * The index pair iterator type is a method taking the indices of two particles.
+ */
+typedef void(index_pair_it)(const size_t, const size_t);
+
+/**
+ * Check if an iterator accepts a batch, which consists of a particle index and a range of particle indices the particle interacts with, instead of
+ * a single index pair. A batch iterator must accept single index pairs as well, since the ghost traversal still passes pairs.
+ *
+ * @tparam F The type of the iterator.
+ */
+template <typename F> constexpr bool is_batch_iterator = std::is_invocable_v<const F&, const size_t, const size_t*, const size_t*>;
+
+/**
+ * Check if a particle pair iterator accepts the displacement and the squared distance of the pair, which the traversal already computed for the
+ * cutoff test, in addition to the particles.
+ *
+ * @tparam F The type of the iterator.
+ */
+template <typename F> constexpr bool is_displacement_iterator = std::is_invocable_v<const F&, Particle&, Particle&, const Vec<double>&, const double>;
+
+/**
+ * Pass a particle pair to an iterator, which receives the displacement and the squared distance if it accepts them.
+ *
+ * @param iterator The particle pair iteration lambda.
+ * @param p1 The first particle.
+ * @param p2 The second particle.
+ * @param diff The displacement from the second to the first particle.
+ * @param dist_squ The squared distance between the particles.
+ */
+template <typename F> inline void visit_pair(const F& iterator, Particle& p1, Particle& p2, const Vec<double>& diff, const double dist_squ) {
+    if constexpr (is_displacement_iterator<F>) {
+        iterator(p1, p2, diff, dist_squ);
+    } else {
+        iterator(p1, p2);
+    }
+}
+
+/**
+ * @struct CellRange
+ *
+ * @brief Define a view on the contiguous range of particle indices stored within a single cell.
+ */
+struct CellRange {
+    /**
+     * Define the first particle index of the cell.
+     */
+    const size_t* first;
+
+    /**
+     * Define the end of the particle indices of the cell.
+     */
+    const size_t* last;
+
+    /**
+     * Get the first particle index of the cell.
+     *
+     * @return The pointer to the first particle index.
+     */
+    inline const size_t* begin() const { return first; }
+
+    /**
+     * Get the end of the particle indices of the cell.
+     *
+     * @return The pointer behind the last particle index.
+     */
+    inline const size_t* end() const { return last; }
+
+    /**
+     * Get the number of particles within the cell.
+     *
+     * @return The number of particles.
+     */
+    inline size_t size() const { return last - first; }
+};
+
+/**
+ * @struct CellBlock
+ *
+ * @brief Define a block of cells, which is executed as a single task by the task based traversals.
+ */
+struct CellBlock {
+    /**
+     * Define the position of the first cell of the block within the task cells.
+     */
+    size_t first;
+
+    /**
+     * Define the position behind the last cell of the block within the task cells.
+     */
+    size_t last;
+
+    /**
+     * Define the estimated cost of the block, which is the number of candidate pairs visited.
+     */
+    double cost;
+};
+
 /**
  * @class CellList
  *
@@ -34,9 +146,44 @@ typedef void(particle_it)(Particle&);
 class CellList {
 private:
     /**
-     * Store the cells in a flat out vector.
+     * Store the offsets of the cells within the particle index vector. The cell i contains the indices from cell_start[i] to cell_start[i + 1].
+     */
+    std::vector<size_t> cell_start;
+
+    /**
+     * Store the particle indices sorted by their cells in a flat out vector.
+     */
+    std::vector<size_t> cell_particles;
+
+    /**
+     * Store the cell index of every particle.
+     */
+    std::vector<size_t> particle_cell;
+
+    /**
+     * Store the insertion positions of the cells used by the counting sort.
+     */
+    std::vector<size_t> cell_fill;
+
+    /**
+     * Store the position of every particle index within the particle index vector.
+     */
+    std::vector<size_t> particle_pos;
+
+    /**
+     * Store the particles, which changed their cell, together with their new cell index.
+     */
+    std::vector<std::pair<size_t, size_t>> movers;
+
+    /**
+     * Define the fraction of particles changing their cell, above which the cells are rebuilt instead of updated incrementally.
+     */
+    static constexpr double rebuild_fraction = 0.05;
+
+    /**
+     * Count how often the cells have been built from scratch.
      */
-    std::vector<std::vector<size_t>> cells;
+    size_t full_builds = 0;
 
     /**
      * Define the dimensions of the domain.
@@ -48,16 +195,327 @@ private:
      */
     double rc, rc_squ;
 
+    /**
+     * Define the number of sub cells per cutoff distance, which is also the thickness of the halo and boundary layers in cells.
+     */
+    size_t layers = 1;
+
+    /**
+     * Define the number of simulated dimensions. In two dimensions, only a single layer of cells is used along the z axis.
+     */
+    size_t dimensions = 3;
+
     /**
      * Define the cell sizes
      */
     Vec<double> cell_size;
 
+    /**
+     * Store the flat index offsets of the neighbor cells, which are visited from every cell (half shell for the newton optimization).
+     */
+    std::vector<size_t> stencil;
+
+    /**
+     * Store the coordinate offsets of the neighbor cells in the same order as the flat index offsets.
+     */
+    std::vector<std::array<int, 3>> stencil_offsets;
+
+    /**
+     * Define the distance between two cells of the same color along each axis. Cells of the same color are further apart than the reach of the
+     * half shell stencil, such that their neighborhoods never overlap.
+     */
+    std::array<size_t, 3> color_stride = { 1, 1, 1 };
+
+    /**
+     * Store if the parallel traversals execute blocks of cells as OpenMP tasks, instead of distributing the cells in a fixed order.
+     */
+    bool tasks = false;
+
+    /**
+     * Define the number of blocks created per thread, such that idle threads can pick up the remaining blocks of busy threads.
+     */
+    static constexpr size_t blocks_per_thread = 8;
+
+    /**
+     * Store the indices of the base cells of the task based traversal, which visit at least one candidate pair, ordered by their blocks.
+     */
+    std::vector<size_t> task_cells;
+
+    /**
+     * Store the estimated costs of the task cells.
+     */
+    std::vector<double> task_costs;
+
+    /**
+     * Store the blocks of cells executed as tasks. The blocks of every color are sorted by their estimated cost in descending order.
+     */
+    std::vector<CellBlock> task_blocks;
+
+    /**
+     * Store the offsets of the colors within the blocks. Without colors, all blocks belong to a single group.
+     */
+    std::vector<size_t> task_groups;
+
+    /**
+     * Store the iterators of the threads during the distributed task based traversal, such that every task uses the iterator of its thread.
+     */
+    std::vector<const void*> task_iterators;
+
+    /**
+     * Store the imbalance of the thread times, above which the balanced traversal cuts a new partition. A threshold of 0.0 disables the
+     * balanced traversal.
+     */
+    double balance = 0.0;
+
+    /**
+     * Store the coordinates of the base cells of the balanced traversal ordered along a Morton curve, such that every thread works on a
+     * compact region of the domain.
+     */
+    std::vector<std::array<size_t, 3>> balance_cells;
+
+    /**
+     * Store if the balanced cells include the halo cells like the ghost traversal.
+     */
+    bool balance_ghosts = false;
+
+    /**
+     * Store the offsets of the ranges of the threads within the balanced cells. The range of thread t ends at the offset t + 1.
+     */
+    std::vector<size_t> balance_bounds;
+
+    /**
+     * Store the time every thread spent on its range during the last balanced traversal.
+     */
+    std::vector<double> balance_times;
+
+    /**
+     * Store the imbalance of the last balanced traversal and the sum of the imbalances of all balanced traversals.
+     */
+    double imbalance = 0.0, imbalance_sum = 0.0;
+
+    /**
+     * Store the number of balanced traversals and how often the partition was cut again because of the imbalance.
+     */
+    size_t balanced_traversals = 0, rebalances = 0;
+
     /**
      * Define the domain size and sub dimensions.
      */
     Vec<double> dom, domain_x, domain_y, domain_z, domain_xy, domain_xz, domain_yz;
 
+    /**
+     * Compute the index of the cell containing the given position.
+     *
+     * @param pos The position of the particle.
+     *
+     * @return The index of the cell within the flat out cell list.
+     */
+    size_t compute_cell_index(const Vec<double>& pos) const;
+
+    /**
+     * Move a particle into a new cell, by swapping it through the cells in between.
+     *
+     * @param i The index of the particle.
+     * @param idx The index of the new cell.
+     */
+    void move_particle(const size_t i, const size_t idx);
+
+    /**
+     * Get the layer of a cell, counted in multiples of the sub cells from the outside of the halo. The halo is layer 0, the boundary layer 1.
+     *
+     * @param x The x coordinate.
+     * @param y The y coordinate.
+     * @param z The z coordinate.
+     *
+     * @return The layer of the cell.
+     */
+    size_t get_layer(const size_t x, const size_t y, const size_t z) const;
+
+    /**
+     * Loop through the particles of all cells within a range of layers.
+     *
+     * @param iterator The particle iteration lambda.
+     * @param particles The particles vector.
+     * @param first The first layer.
+     * @param last The last layer.
+     */
+    void loop_layer(const std::function<particle_it>& iterator, std::vector<Particle>& particles, const size_t first, const size_t last);
+
+    /**
+     * Loop through the index pairs of all cells and their half shell neighbors without testing their distance. The number of dimensions is a
+     * template parameter, such that the traversal of the z axis is removed at compile time for two dimensional simulations.
+     *
+     * @tparam Dim The number of simulated dimensions.
+     * @param iterator The index pair iteration lambda.
+     */
+    template <size_t Dim, typename F> void traverse_candidate_pairs(const F& iterator);
+
+    /**
+     * Loop through the index pairs of all cells and their half shell neighbors in parallel without testing their distance. The cells are
+     * processed one color after another, while the cells of a single color are distributed among the threads.
+     *
+     * @tparam Dim The number of simulated dimensions.
+     * @tparam Ghosts Include the halo cells like the ghost traversal.
+     * @param iterator The index pair iteration lambda.
+     */
+    template <size_t Dim, bool Ghosts, typename F> void traverse_colored_candidate_pairs(const F& iterator);
+
+    /**
+     * Loop through the index pairs of all cells and their half shell neighbors without testing their distance, while the cells are distributed
+     * among the threads of the enclosing parallel region.
+     *
+     * @tparam Dim The number of simulated dimensions.
+     * @tparam Ghosts Include the halo cells like the ghost traversal.
+     * @param iterator The index pair iteration lambda.
+     */
+    template <size_t Dim, bool Ghosts, typename F> void traverse_distributed_candidate_pairs(const F& iterator);
+
+    /**
+     * Partition the base cells into blocks of roughly equal estimated cost, which can be executed as tasks. The cost of a cell is estimated from
+     * the occupancy of the cell and its half shell neighbors. Cells without any candidate pair are skipped entirely.
+     *
+     * @param ghosts Include the halo cells like the ghost traversal.
+     * @param colored Group the blocks by the colors of their cells, such that the blocks of a single color can be executed concurrently.
+     */
+    void build_tasks(const bool ghosts, const bool colored);
+
+    /**
+     * Visit the index pairs of all base cells within a block of cells.
+     *
+     * @tparam Ghosts Visit the cells like the ghost traversal.
+     * @param block The block of cells.
+     * @param iterator The index pair iteration lambda.
+     */
+    template <bool Ghosts, typename F> void visit_block(const CellBlock& block, const F& iterator);
+
+    /**
+     * Execute the blocks of cells as OpenMP tasks one color after another.
+     *
+     * @tparam Ghosts Include the halo cells like the ghost traversal.
+     * @param iterator The index pair iteration lambda.
+     */
+    template <bool Ghosts, typename F> void traverse_colored_tasks(const F& iterator);
+
+    /**
+     * Execute the blocks of cells as OpenMP tasks within the enclosing parallel region.
+     *
+     * @tparam Ghosts Include the halo cells like the ghost traversal.
+     * @param iterator The index pair iteration lambda.
+     */
+    template <bool Ghosts, typename F> void traverse_distributed_tasks(const F& iterator);
+
+    /**
+     * Estimate the number of candidate pairs visited by a base cell from the occupancy of the cell and its half shell neighbors.
+     *
+     * @param x The x index of the cell.
+     * @param y The y index of the cell.
+     * @param z The z index of the cell.
+     *
+     * @return The estimated cost of the cell.
+     */
+    double estimate_cost(const size_t x, const size_t y, const size_t z) const;
+
+    /**
+     * Collect the base cells of the balanced traversal and order them along a Morton curve of their cell coordinates.
+     *
+     * @param ghosts Include the halo cells like the ghost traversal.
+     */
+    void build_balance_cells(const bool ghosts);
+
+    /**
+     * Cut the balanced cells into one contiguous range per thread, such that the ranges have the same cost. The cost of a cell is estimated
+     * from its occupancy. If the time of the last traversal is used, the estimates of every range are scaled to the time its thread spent
+     * on the range, which accounts for the costs the occupancy does not capture.
+     *
+     * @param threads The number of threads.
+     * @param measured Scale the estimates to the measured times of the last traversal.
+     */
+    void cut_partition(const size_t threads, const bool measured);
+
+    /**
+     * Compute the imbalance of the thread times of the last balanced traversal and cut a new partition, if it exceeds the threshold.
+     *
+     * @param threads The number of threads.
+     */
+    void finish_balanced_traversal(const size_t threads);
+
+    /**
+     * Visit the cells of the own range of the balanced partition and measure the time of every thread.
+     *
+     * @tparam Ghosts Include the halo cells like the ghost traversal.
+     * @param iterator The index pair iteration lambda.
+     */
+    template <bool Ghosts, typename F> void traverse_balanced_candidate_pairs(const F& iterator);
+
+    /**
+     * Visit the index pairs within a cell of the domain and between the cell and its half shell neighbors. If the iterator accepts a particle
+     * index together with a range of particle indices, every particle is passed with the following particles of its cell and with the
+     * particles of all half shell neighbors as two batches instead, such that the iterator can process the batches with vector instructions.
+     *
+     * @param idx The index of the cell within the flat out cell list.
+     * @param iterator The index pair or batch iteration lambda.
+     */
+    template <typename F> void visit_cell(const size_t idx, const F& iterator);
+
+    /**
+     * Visit the index pairs within a cell of the whole grid and between the cell and its half shell neighbors. Neighbors outside of the grid and
+     * pairs of two halo cells are skipped.
+     *
+     * @param x The x coordinate.
+     * @param y The y coordinate.
+     * @param z The z coordinate.
+     * @param iterator The index pair iteration lambda.
+     */
+    template <typename F> void visit_ghost_cell(const size_t x, const size_t y, const size_t z, const F& iterator);
+
+    /**
+     * Visit the pairs of a particle within a boundary cell and the particles of a boundary cell at the opposite side of the domain, which are
+     * closer than the cutoff distance once the first particle is shifted to its periodic image.
+     *
+     * @param k The index of the particle within the boundary cell.
+     * @param idx The index of the boundary cell at the opposite side of the domain.
+     * @param shift The shift of the first particle to its periodic image.
+     * @param iterator The particle pair iteration lambda.
+     * @param particles The particles vector.
+     */
+    template <typename F>
+    void visit_image_cell(const size_t k, const size_t idx, const Vec<double>& shift, const F& iterator, std::vector<Particle>& particles);
+
+    /**
+     * Visit the periodic pairs between the boundary cells of the lower face normal to an axis and the boundary cells of the opposite upper face.
+     *
+     * @param dim The axis normal to the faces.
+     * @param shift The shift of the particles of the lower face to their periodic image.
+     * @param iterator The particle pair iteration lambda.
+     * @param particles The particles vector.
+     */
+    template <typename F> void visit_plane_pairs(const size_t dim, const Vec<double>& shift, const F& iterator, std::vector<Particle>& particles);
+
+    /**
+     * Visit the periodic pairs between the boundary cells along an edge of the domain and the boundary cells along the diagonally opposite edge.
+     *
+     * @param dim The axis parallel to the edges.
+     * @param first The coordinates of the cells along the first edge, the coordinate along the axis is ignored.
+     * @param second The coordinates of the cells along the opposite edge, the coordinate along the axis is ignored.
+     * @param shift The shift of the particles along the first edge to their periodic image.
+     * @param iterator The particle pair iteration lambda.
+     * @param particles The particles vector.
+     */
+    template <typename F>
+    void visit_edge_pairs(const size_t dim, std::array<size_t, 3> first, std::array<size_t, 3> second, const Vec<double>& shift, const F& iterator,
+        std::vector<Particle>& particles);
+
+    /**
+     * Visit the periodic pairs between two corner cells of the domain.
+     *
+     * @param first The index of the first corner cell.
+     * @param second The index of the opposite corner cell.
+     * @param shift The shift of the particles within the first corner cell to their periodic image.
+     * @param iterator The particle pair iteration lambda.
+     * @param particles The particles vector.
+     */
+    template <typename F>
+    void visit_corner_pairs(const size_t first, const size_t second, const Vec<double>& shift, const F& iterator, std::vector<Particle>& particles);
 
 public:
     /**
@@ -70,8 +528,13 @@ public:
      *
      * @param rc The new cutoff distance.
      * @param domain The domain size.
+     * @param skin Optional: The skin added to the cutoff distance for the size of the cells.
+     * @param sub_cells Optional: The number of cells per cutoff distance (plus skin) in each direction. Smaller cells visit fewer particle pairs
+     * outside the cutoff distance, but require a larger stencil of neighbor cells.
+     * @param dimensions Optional: The number of simulated dimensions, either 2 or 3. Two dimensional simulations use a single layer of cells along
+     * the z axis and a stencil without neighbors along the z axis.
      */
-    CellList(const double rc, const Vec<double>& domain);
+    CellList(const double rc, const Vec<double>& domain, const double skin = 0.0, const size_t sub_cells = 1, const size_t dimensions = 3);
 
     /**
      * Define the default destructor.
@@ -87,7 +550,21 @@ public:
      * 
      * @return The index of the cell within the cell list.
      */
-    size_t get_cell_index(const size_t x, const size_t y, const size_t z);
+    inline size_t get_cell_index(const size_t x, const size_t y, const size_t z) const { return z + y * n_z + x * n_y * n_z; }
+
+    /**
+     * Get the particle indices stored within a cell.
+     *
+     * @param idx The index of the cell within the flat out cell list.
+     *
+     * @return The range of particle indices.
+     */
+    inline CellRange cell(const size_t idx) const {
+        return {
+            cell_particles.data() + cell_start[idx],
+            cell_particles.data() + cell_start[idx + 1],
+        };
+    }
 
     /**
      * Get the corner vector of the front up right corner.
@@ -97,12 +574,94 @@ public:
     Vec<double> get_corner_vector();
 
     /**
-     * Create the cell list using the particle vector. This method must only be called if the cell list was initialized with the detailed constructor.
+     * Create the cell list using the particle vector by sorting the particle indices into the cells using a counting sort. This method must only
+     * be called if the cell list was initialized with the detailed constructor.
      *
      * @param particles The vector of particles, that should be used for the simulation.
      */
     void create_list(const std::vector<Particle>& particles);
 
+    /**
+     * Update the cell list incrementally, by only moving the particles which changed their cell. If the number of particles changed, too many
+     * particles changed their cell or the movers would be swapped through more cells than a full build visits, the cell list is created from
+     * scratch. The cell list must have been created before.
+     *
+     * @param particles The vector of particles, that should be used for the simulation.
+     *
+     * @return A boolean indicating if any particle changed its cell.
+     */
+    bool update_list(const std::vector<Particle>& particles);
+
+    /**
+     * Reorder the particles, such that they are stored in the order of their cells. Afterwards the particles of every cell are stored contiguously
+     * within the particle vector. The cell list must be up to date.
+     *
+     * @param particles The vector of particles, that should be reordered.
+     */
+    void reorder_particles(std::vector<Particle>& particles);
+
+    /**
+     * Loop through the index pairs of all cells and their half shell neighbors without testing their distance. The iterator must filter the pairs
+     * by their distance itself. This allows kernels operating on separate position arrays to skip the particle vector entirely.
+     *
+     * @param iterator The index pair iteration lambda.
+     */
+    template <typename F> void for_each_candidate_pair(const F& iterator);
+
+    /**
+     * Loop through the index pairs of all cells, including the halo cells, and their half shell neighbors without testing their distance. Pairs
+     * of two halo cells are skipped. This traversal visits every pair of a particle within the domain and a ghost particle within the halo
+     * exactly once. The iterator must filter the pairs by their distance itself.
+     *
+     * @param iterator The index pair iteration lambda.
+     */
+    template <typename F> void for_each_ghost_candidate_pair(const F& iterator);
+
+    /**
+     * Loop through the index pairs of all cells and their half shell neighbors in parallel without testing their distance. The cells are
+     * partitioned into colors (18 colors in three dimensions, 6 in two dimensions without sub cells), such that the neighborhoods of two cells of
+     * the same color never overlap. The colors are processed one after another, while the cells of a color are distributed among the OpenMP
+     * threads. The iterator may therefore update both particles of a pair without synchronization, but must not write to any other shared state.
+     * If the tasks are enabled, the cells of every color are grouped into blocks, which are executed as tasks.
+     *
+     * @param iterator The index pair iteration lambda.
+     * @param ghosts Optional: Include the halo cells and skip the pairs of two halo cells like the ghost traversal.
+     */
+    template <typename F> void for_each_colored_candidate_pair(const F& iterator, const bool ghosts = false);
+
+    /**
+     * Loop through the index pairs of all cells and their half shell neighbors without testing their distance, while the cells are distributed
+     * among the threads of the enclosing OpenMP parallel region. This method must be called by every thread of the region and returns after all
+     * threads finished their cells. Every thread may visit pairs sharing a particle with the pairs of another thread, such that the iterator must
+     * only write to thread private data (e.g. a thread local force buffer). If the tasks are enabled, the cells are grouped into blocks, which are
+     * executed as tasks. Otherwise, if the balancing is enabled, every thread visits a contiguous range of cells along a Morton curve, which is
+     * cut again whenever the measured thread times are imbalanced.
+     *
+     * @param iterator The index pair iteration lambda.
+     * @param ghosts Optional: Include the halo cells and skip the pairs of two halo cells like the ghost traversal.
+     */
+    template <typename F> void for_each_distributed_candidate_pair(const F& iterator, const bool ghosts = false);
+
+    /**
+     * Loop through the index pairs of all cells and their half shell neighbors, which are closer than the given distance. The iterator is a
+     * template parameter, such that it can be inlined into the cell traversal.
+     *
+     * @param iterator The index pair iteration lambda.
+     * @param particles The particles vector.
+     * @param dist_squ The squared distance up to which the pairs are visited. The distance must not exceed the cell size.
+     */
+    template <typename F> void for_each_index_pair(const F& iterator, const std::vector<Particle>& particles, const double dist_squ);
+
+    /**
+     * Loop through the particle pairs within the domain. The iterator is a template parameter, such that it can be inlined into the cell traversal.
+     * An iterator accepting a displacement pair receives the displacement from the second to the first particle and the squared distance of the
+     * cutoff test.
+     *
+     * @param iterator The particle iteration lambda.
+     * @param particles The particles vector.
+     */
+    template <typename F> void for_each_cell_pair(const F& iterator, std::vector<Particle>& particles);
+
     /**
      * Loop through the particle pairs within the domain.
      *
@@ -111,6 +670,27 @@ public:
      */
     void loop_cell_pairs(const std::function<particle_pair_it>& iterator, std::vector<Particle>& particles);
 
+    /**
+     * Loop through the particle pairs across the periodic boundaries, in the same order as the periodic plane, axis and corner loops below. An
+     * iterator accepting a displacement pair receives the displacement from the second particle to the periodic image of the first particle, in
+     * which it interacts with the second particle, and the squared distance of the cutoff test. It is a template parameter, such that it can be
+     * inlined into the cell traversal.
+     *
+     * @param iterator The particle pair iteration lambda.
+     * @param particles The particles vector.
+     * @param periodic An array storing for every direction if the domain is periodic along it.
+     */
+    template <typename F> void for_each_periodic_pair(const F& iterator, std::vector<Particle>& particles, const std::array<bool, 3>& periodic);
+
+    /**
+     * Loop through the index pairs within the domain, which are closer than the given distance. The distance must not exceed the cell size.
+     *
+     * @param iterator The index pair iteration lambda.
+     * @param particles The particles vector.
+     * @param dist_squ The squared distance up to which the pairs are visited.
+     */
+    void loop_cell_index_pairs(const std::function<index_pair_it>& iterator, const std::vector<Particle>& particles, const double dist_squ);
+
     /**
      * Loop through the particles within the halo.
      *
@@ -245,4 +825,502 @@ public:
      * @return The cutoff distance.
      */
     double getRC();
+
+    /**
+     * Get the number of sub cells per cutoff distance.
+     *
+     * @return The number of sub cells.
+     */
+    size_t get_sub_cells() const;
+
+    /**
+     * Get the size of a single cell.
+     *
+     * @return The size of a cell along every axis.
+     */
+    Vec<double> get_cell_size() const;
+
+    /**
+     * Get the number of simulated dimensions.
+     *
+     * @return The number of dimensions.
+     */
+    size_t get_dimensions() const;
+
+    /**
+     * Get the number of colors used by the parallel traversal.
+     *
+     * @return The number of colors.
+     */
+    size_t get_colors() const;
+
+    /**
+     * Set if the parallel traversals execute blocks of cells as OpenMP tasks. Idle threads then pick up the remaining blocks, which balances the
+     * load of inhomogeneous particle distributions.
+     *
+     * @param tasks A boolean indicating if the task based traversals are used.
+     */
+    void set_tasks(const bool tasks);
+
+    /**
+     * Get the number of blocks created by the last task based traversal.
+     *
+     * @return The number of blocks.
+     */
+    size_t get_task_blocks() const;
+
+    /**
+     * Move the pages of the cell arrays to the NUMA nodes of the threads, which touch them first in a statically scheduled loop.
+     *
+     * @param huge_pages Ask the operating system to back the arrays with transparent huge pages.
+     */
+    void first_touch(const bool huge_pages);
+
+    /**
+     * Set the imbalance threshold of the balanced traversal. The distributed traversal then assigns a contiguous range of cells of equal cost
+     * to every thread and measures the time of every thread. Whenever the imbalance, the maximum thread time divided by the mean thread time
+     * minus one, exceeds the threshold, the ranges are cut again using the measured times. A threshold of 0.0 disables the balanced traversal.
+     *
+     * @param threshold The imbalance threshold.
+     */
+    void set_balance(const double threshold);
+
+    /**
+     * Get the imbalance of the thread times of the last balanced traversal.
+     *
+     * @return The imbalance, which is 0.0 for perfectly balanced threads.
+     */
+    double get_imbalance() const;
+
+    /**
+     * Get the mean imbalance of the thread times over all balanced traversals.
+     *
+     * @return The mean imbalance.
+     */
+    double get_mean_imbalance() const;
+
+    /**
+     * Get how often the balanced traversal cut a new partition, because the imbalance exceeded the threshold.
+     *
+     * @return The number of new partitions.
+     */
+    size_t get_rebalances() const;
+
+    /**
+     * Get the width of the halo in each direction. Ghost particles within this distance outside of the domain can be stored in the halo cells.
+     *
+     * @return The width of the halo.
+     */
+    Vec<double> get_halo_width() const;
+
+    /**
+     * Get how often the cell list was created from scratch.
+     *
+     * @return The number of full builds.
+     */
+    size_t get_full_builds() const;
 };
+
+template <typename F> inline void CellList::visit_cell(const size_t idx, const F& iterator) {
+    const CellRange self_cell = cell(idx);
+
+    if constexpr (is_batch_iterator<F>) {
+        // Every particle is passed with all particles of the half shell neighbors at once, such that the batches are long enough for the vector
+        // instructions. The buffer is reused by all cells visited by the same thread
+        thread_local std::vector<size_t> neighbors;
+        neighbors.clear();
+
+        for (size_t offset : stencil) {
+            const CellRange other = cell(idx + offset);
+            neighbors.insert(neighbors.end(), other.begin(), other.end());
+        }
+
+        for (auto l_it = self_cell.begin(); l_it != self_cell.end(); l_it++) {
+            if (l_it + 1 != self_cell.end()) {
+                iterator(*l_it, l_it + 1, self_cell.end());
+            }
+
+            if (!neighbors.empty()) {
+                iterator(*l_it, neighbors.data(), neighbors.data() + neighbors.size());
+            }
+        }
+
+        return;
+    }
+
+    for (auto l1_it = self_cell.begin(); l1_it != self_cell.end(); l1_it++) {
+        for (auto l2_it = l1_it + 1; l2_it != self_cell.end(); l2_it++) {
+            iterator(*l1_it, *l2_it);
+        }
+    }
+
+    // Loop through the neighbors in the half shell
+    for (size_t l : self_cell) {
+        for (size_t offset : stencil) {
+            for (size_t m : cell(idx + offset)) {
+                iterator(l, m);
+            }
+        }
+    }
+}
+
+template <typename F> inline void CellList::visit_ghost_cell(const size_t x, const size_t y, const size_t z, const F& iterator) {
+    const size_t idx = get_cell_index(x, y, z);
+    const bool halo = get_layer(x, y, z) == 0;
+    const CellRange self_cell = cell(idx);
+
+    // The halo cells only store ghost particles, which do not interact with each other
+    if (!halo) {
+        for (auto l1_it = self_cell.begin(); l1_it != self_cell.end(); l1_it++) {
+            for (auto l2_it = l1_it + 1; l2_it != self_cell.end(); l2_it++) {
+                iterator(*l1_it, *l2_it);
+            }
+        }
+    }
+
+    for (size_t s = 0; s < stencil.size(); s++) {
+        // Skip the neighbors outside of the cell grid (unsigned overflow is intended for negative coordinates)
+        const size_t n_x_pos = x + stencil_offsets[s][0];
+        const size_t n_y_pos = y + stencil_offsets[s][1];
+        const size_t n_z_pos = z + stencil_offsets[s][2];
+
+        if (n_x_pos >= n_x || n_y_pos >= n_y || n_z_pos >= n_z || (halo && get_layer(n_x_pos, n_y_pos, n_z_pos) == 0)) {
+            continue;
+        }
+
+        for (size_t l : self_cell) {
+            for (size_t m : cell(idx + stencil[s])) {
+                iterator(l, m);
+            }
+        }
+    }
+}
+
+template <bool Ghosts, typename F> inline void CellList::visit_block(const CellBlock& block, const F& iterator) {
+    for (size_t c = block.first; c < block.last; c++) {
+        const size_t idx = task_cells[c];
+
+        if constexpr (Ghosts) {
+            visit_ghost_cell(idx / (n_y * n_z), idx / n_z % n_y, idx % n_z, iterator);
+        } else {
+            visit_cell(idx, iterator);
+        }
+    }
+}
+
+template <bool Ghosts, typename F> inline void CellList::traverse_colored_tasks(const F& iterator) {
+    build_tasks(Ghosts, true);
+
+#pragma omp parallel
+#pragma omp single
+    for (size_t c = 0; c + 1 < task_groups.size(); c++) {
+        for (size_t b = task_groups[c]; b < task_groups[c + 1]; b++) {
+#pragma omp task
+            visit_block<Ghosts>(task_blocks[b], iterator);
+        }
+
+        // The blocks of the next color may only start after all blocks of this color are finished
+#pragma omp taskwait
+    }
+}
+
+template <bool Ghosts, typename F> inline void CellList::traverse_distributed_tasks(const F& iterator) {
+#pragma omp single
+    {
+        build_tasks(Ghosts, false);
+        task_iterators.assign(Threads::get_num_threads(), nullptr);
+    }
+
+    // Every thread passes its own iterator, such that a task must use the iterator of the thread executing it
+    task_iterators[Threads::get_thread_num()] = &iterator;
+
+#pragma omp barrier
+
+    // The implicit barrier at the end of the single construct waits for all tasks
+#pragma omp single
+    for (size_t b = 0; b < task_blocks.size(); b++) {
+#pragma omp task
+        visit_block<Ghosts>(task_blocks[b], *static_cast<const F*>(task_iterators[Threads::get_thread_num()]));
+    }
+}
+
+template <size_t Dim, typename F> inline void CellList::traverse_candidate_pairs(const F& iterator) {
+    // In two dimensions, the only inner layer along the z axis is known at compile time
+    const size_t z_end = Dim == 2 ? layers + 1 : n_z - layers;
+
+    // Loop through the cells using the indices, ignore halo cells
+    for (size_t i = layers; i < n_x - layers; i++) {
+        for (size_t j = layers; j < n_y - layers; j++) {
+            for (size_t k = layers; k < z_end; k++) {
+                visit_cell(get_cell_index(i, j, k), iterator);
+            }
+        }
+    }
+}
+
+template <size_t Dim, bool Ghosts, typename F> inline void CellList::traverse_colored_candidate_pairs(const F& iterator) {
+    // The ghost traversal includes the halo cells
+    const size_t first = Ghosts ? 0 : layers;
+    const size_t x_end = Ghosts ? n_x : n_x - layers;
+    const size_t y_end = Ghosts ? n_y : n_y - layers;
+    const size_t z_end = Ghosts ? n_z : (Dim == 2 ? layers + 1 : n_z - layers);
+    const size_t colors = get_colors();
+
+#pragma omp parallel
+    for (size_t c = 0; c < colors; c++) {
+        const size_t c_x = first + c / (color_stride[1] * color_stride[2]);
+        const size_t c_y = first + c / color_stride[2] % color_stride[1];
+        const size_t c_z = first + c % color_stride[2];
+
+        // The implicit barrier at the end of the loop ensures, that the next color is only started after all cells of this color are finished
+#pragma omp for collapse(3) schedule(dynamic)
+        for (size_t i = c_x; i < x_end; i += color_stride[0]) {
+            for (size_t j = c_y; j < y_end; j += color_stride[1]) {
+                for (size_t k = c_z; k < z_end; k += color_stride[2]) {
+                    if constexpr (Ghosts) {
+                        visit_ghost_cell(i, j, k, iterator);
+                    } else {
+                        visit_cell(get_cell_index(i, j, k), iterator);
+                    }
+                }
+            }
+        }
+    }
+}
+
+template <size_t Dim, bool Ghosts, typename F> inline void CellList::traverse_distributed_candidate_pairs(const F& iterator) {
+    // The ghost traversal includes the halo cells
+    const size_t first = Ghosts ? 0 : layers;
+    const size_t x_end = Ghosts ? n_x : n_x - layers;
+    const size_t y_end = Ghosts ? n_y : n_y - layers;
+    const size_t z_end = Ghosts ? n_z : (Dim == 2 ? layers + 1 : n_z - layers);
+
+    // The cells are handed out in small chunks, such that threads finishing early take over the cells of busy threads
+#pragma omp for collapse(3) schedule(dynamic, 4)
+    for (size_t i = first; i < x_end; i++) {
+        for (size_t j = first; j < y_end; j++) {
+            for (size_t k = first; k < z_end; k++) {
+                if constexpr (Ghosts) {
+                    visit_ghost_cell(i, j, k, iterator);
+                } else {
+                    visit_cell(get_cell_index(i, j, k), iterator);
+                }
+            }
+        }
+    }
+}
+
+template <bool Ghosts, typename F> inline void CellList::traverse_balanced_candidate_pairs(const F& iterator) {
+    const size_t threads = Threads::get_num_threads();
+    const size_t t = Threads::get_thread_num();
+
+    // The partition is cut from the estimated costs, whenever the traversed cells or the number of threads changed
+#pragma omp single
+    if (balance_ghosts != Ghosts || balance_cells.empty() || balance_bounds.size() != threads + 1) {
+        build_balance_cells(Ghosts);
+        cut_partition(threads, false);
+    }
+
+    const double start = Threads::get_time();
+
+    for (size_t c = balance_bounds[t]; c < balance_bounds[t + 1]; c++) {
+        const std::array<size_t, 3>& pos = balance_cells[c];
+
+        if constexpr (Ghosts) {
+            visit_ghost_cell(pos[0], pos[1], pos[2], iterator);
+        } else {
+            visit_cell(get_cell_index(pos[0], pos[1], pos[2]), iterator);
+        }
+    }
+
+    balance_times[t] = Threads::get_time() - start;
+
+#pragma omp barrier
+#pragma omp single
+    finish_balanced_traversal(threads);
+}
+
+template <typename F> inline void CellList::for_each_candidate_pair(const F& iterator) {
+    if (dimensions == 2) {
+        traverse_candidate_pairs<2>(iterator);
+    } else {
+        traverse_candidate_pairs<3>(iterator);
+    }
+}
+
+template <typename F> inline void CellList::for_each_ghost_candidate_pair(const F& iterator) {
+    for (size_t i = 0; i < n_x; i++) {
+        for (size_t j = 0; j < n_y; j++) {
+            for (size_t k = 0; k < n_z; k++) {
+                visit_ghost_cell(i, j, k, iterator);
+            }
+        }
+    }
+}
+
+template <typename F> inline void CellList::for_each_colored_candidate_pair(const F& iterator, const bool ghosts) {
+    if (tasks && ghosts) {
+        traverse_colored_tasks<true>(iterator);
+        return;
+    } else if (tasks) {
+        traverse_colored_tasks<false>(iterator);
+        return;
+    }
+
+    if (ghosts) {
+        traverse_colored_candidate_pairs<3, true>(iterator);
+    } else if (dimensions == 2) {
+        traverse_colored_candidate_pairs<2, false>(iterator);
+    } else {
+        traverse_colored_candidate_pairs<3, false>(iterator);
+    }
+}
+
+template <typename F> inline void CellList::for_each_index_pair(const F& iterator, const std::vector<Particle>& particles, const double dist_squ) {
+    for_each_candidate_pair([&iterator, &particles, dist_squ](const size_t l, const size_t m) {
+        if ((particles[l].getX() - particles[m].getX()).len_squ() <= dist_squ) {
+            iterator(l, m);
+        }
+    });
+}
+
+template <typename F> inline void CellList::for_each_cell_pair(const F& iterator, std::vector<Particle>& particles) {
+    for_each_candidate_pair([this, &iterator, &particles](const size_t l, const size_t m) {
+        const Vec<double> diff = particles[l].getX() - particles[m].getX();
+        const double dist_squ = diff.len_squ();
+
+        if (dist_squ <= rc_squ) {
+            visit_pair(iterator, particles[l], particles[m], diff, dist_squ);
+        }
+    });
+}
+
+template <typename F> inline void CellList::for_each_distributed_candidate_pair(const F& iterator, const bool ghosts) {
+    if (tasks && ghosts) {
+        traverse_distributed_tasks<true>(iterator);
+        return;
+    } else if (tasks) {
+        traverse_distributed_tasks<false>(iterator);
+        return;
+    }
+
+    if (balance > 0.0 && ghosts) {
+        traverse_balanced_candidate_pairs<true>(iterator);
+        return;
+    } else if (balance > 0.0) {
+        traverse_balanced_candidate_pairs<false>(iterator);
+        return;
+    }
+
+    if (ghosts) {
+        traverse_distributed_candidate_pairs<3, true>(iterator);
+    } else if (dimensions == 2) {
+        traverse_distributed_candidate_pairs<2, false>(iterator);
+    } else {
+        traverse_distributed_candidate_pairs<3, false>(iterator);
+    }
+}
+
+template <typename F>
+inline void CellList::visit_image_cell(
+    const size_t k, const size_t idx, const Vec<double>& shift, const F& iterator, std::vector<Particle>& particles) {
+    for (size_t l : cell(idx)) {
+        const Vec<double> diff = particles[k].getX() - particles[l].getX() + shift;
+        const double dist_squ = diff.len_squ();
+
+        if (dist_squ <= rc_squ) {
+            visit_pair(iterator, particles[k], particles[l], diff, dist_squ);
+        }
+    }
+}
+
+template <typename F>
+inline void CellList::visit_plane_pairs(const size_t dim, const Vec<double>& shift, const F& iterator, std::vector<Particle>& particles) {
+    // The face is traversed along the two remaining axes in ascending order
+    const size_t a = dim == 0 ? 1 : 0;
+    const size_t b = dim == 2 ? 1 : 2;
+    const std::array<size_t, 3> n = { n_x, n_y, n_z };
+    std::array<size_t, 3> first, second;
+    first[dim] = 1;
+    second[dim] = n[dim] - 2;
+
+    for (size_t i = 1; i < n[a] - 1; i++) {
+        for (size_t j = 1; j < n[b] - 1; j++) {
+            first[a] = i;
+            first[b] = j;
+
+            for (size_t k : cell(get_cell_index(first[0], first[1], first[2]))) {
+                // Loop over the cells using the newton optimization
+                for (size_t l = j - 1; l <= j + 1; l++) {
+                    for (size_t m = i - 1; m <= i + 1; m++) {
+                        second[a] = m;
+                        second[b] = l;
+                        visit_image_cell(k, get_cell_index(second[0], second[1], second[2]), shift, iterator, particles);
+                    }
+                }
+            }
+        }
+    }
+}
+
+template <typename F>
+inline void CellList::visit_edge_pairs(const size_t dim, std::array<size_t, 3> first, std::array<size_t, 3> second, const Vec<double>& shift,
+    const F& iterator, std::vector<Particle>& particles) {
+    const std::array<size_t, 3> n = { n_x, n_y, n_z };
+
+    for (size_t i = 1; i < n[dim] - 1; i++) {
+        first[dim] = i;
+
+        for (size_t k : cell(get_cell_index(first[0], first[1], first[2]))) {
+            for (size_t m = i - 1; m <= i + 1; m++) {
+                second[dim] = m;
+                visit_image_cell(k, get_cell_index(second[0], second[1], second[2]), shift, iterator, particles);
+            }
+        }
+    }
+}
+
+template <typename F>
+inline void CellList::visit_corner_pairs(
+    const size_t first, const size_t second, const Vec<double>& shift, const F& iterator, std::vector<Particle>& particles) {
+    for (size_t k : cell(first)) {
+        visit_image_cell(k, second, shift, iterator, particles);
+    }
+}
+
+template <typename F>
+inline void CellList::for_each_periodic_pair(const F& iterator, std::vector<Particle>& particles, const std::array<bool, 3>& periodic) {
+    if (periodic[0]) {
+        visit_plane_pairs(0, domain_x, iterator, particles);
+
+        if (periodic[1]) {
+            visit_edge_pairs(2, { 1, 1, 0 }, { n_x - 2, n_y - 2, 0 }, domain_xy, iterator, particles);
+            visit_edge_pairs(2, { n_x - 2, 1, 0 }, { 1, n_y - 2, 0 }, { -dom[0], dom[1], 0.0 }, iterator, particles);
+        }
+
+        if (periodic[2]) {
+            visit_edge_pairs(1, { 1, 0, 1 }, { n_x - 2, 0, n_z - 2 }, domain_xz, iterator, particles);
+            visit_edge_pairs(1, { n_x - 2, 0, 1 }, { 1, 0, n_z - 2 }, { -dom[0], 0.0, dom[2] }, iterator, particles);
+        }
+    }
+
+    if (periodic[1]) {
+        visit_plane_pairs(1, domain_y, iterator, particles);
+
+        if (periodic[2]) {
+            visit_edge_pairs(0, { 0, 1, 1 }, { 0, n_y - 2, n_z - 2 }, domain_yz, iterator, particles);
+            visit_edge_pairs(0, { 0, n_y - 2, 1 }, { 0, 1, n_z - 2 }, { 0.0, -dom[1], dom[2] }, iterator, particles);
+        }
+    }
+
+    if (periodic[2]) {
+        visit_plane_pairs(2, domain_z, iterator, particles);
+    }
+
+    if (periodic[0] && periodic[1] && periodic[2]) {
+        visit_corner_pairs(get_cell_index(1, 1, 1), get_cell_index(n_x - 2, n_y - 2, n_z - 2), dom, iterator, particles);
+        visit_corner_pairs(get_cell_index(n_x - 2, 1, 1), get_cell_index(1, n_y - 2, n_z - 2), { -dom[0], dom[1], dom[2] }, iterator, particles);
+        visit_corner_pairs(get_cell_index(1, n_y - 2, 1), get_cell_index(n_x - 2, 1, n_z - 2), { dom[0], -dom[1], dom[2] }, iterator, particles);
+        visit_corner_pairs(get_cell_index(n_x - 2, n_y - 2, 1), get_cell_index(1, 1, n_z - 2), { -dom[0], -dom[1], dom[2] }, iterator, particles);
+    }
+}
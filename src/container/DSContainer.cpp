@@ -14,12 +14,8 @@ DSContainer::DSContainer(const std::vector<Particle>& new_particles, const Vec<d
 
 DSContainer::~DSContainer() = default;
 
-void DSContainer::iterate_pairs(const std::function<particle_pair_it>& iterator) {
-    for (auto i = begin(); i < end(); i++) {
-        for (auto j = i + 1; j < end(); j++) {
-            iterator(*i, *j);
-        }
-    }
-}
+void DSContainer::iterate_pairs(const std::function<particle_pair_it>& iterator) { for_each_pair(iterator); }
+
+void DSContainer::iterate_pairs(const std::function<displacement_pair_it>& iterator) { for_each_pair(iterator); }
 
 void DSContainer::update_positions() { }
@@ -8,6 +8,8 @@
 
 #include "ParticleContainer.h"
 
+#include <algorithm>
+
 /**
  * @class DSContainer
  *
@@ -15,6 +17,11 @@
  */
 class DSContainer : public ParticleContainer {
 private:
+    /**
+     * Define the number of consecutive particles forming a tile of the tiled traversal, such that the data of two tiles fits into the L1 cache.
+     */
+    static constexpr size_t tile_size = 256;
+
 public:
     /**
      * Define the default infinity container constructor.
@@ -50,6 +57,33 @@ public:
      */
     ~DSContainer();
 
+    /**
+     * Iterate through the index pairs of all particles O(n^2).
+     *
+     * @param iterator The index pair iterator.
+     */
+    template <typename F> void for_each_candidate_pair(const F& iterator);
+
+    /**
+     * Iterate through the index pairs of all particles O(n^2), while the pairs of tiles of consecutive particles are distributed among the
+     * threads of the enclosing OpenMP parallel region. The iterator is called for every particle i of a tile with a range of particles j of the
+     * other tile, which are all larger than i. The inner loop over the range can therefore be vectorized, while the particle data of both tiles
+     * stays in the cache. This method must be called by every thread of the region and returns after all threads finished their tiles. Every
+     * thread may visit pairs sharing a particle with the pairs of another thread, such that the iterator must only write to thread private
+     * data (e.g. a thread local force buffer).
+     *
+     * @param iterator The iterator taking the index i and the first and the last (exclusive) index of the range of particles j.
+     */
+    template <typename F> void for_each_tile_pair(const F& iterator);
+
+    /**
+     * Iterate through the particle pairs O(n^2). The iterator is a template parameter, such that it can be inlined into the pair traversal. The
+     * displacement of a pair is only computed for an iterator accepting a displacement pair, since the direct sum has no cutoff test.
+     *
+     * @param iterator The particle pair iterator.
+     */
+    template <typename F> void for_each_pair(const F& iterator);
+
     /**
      * Iterate through the particle pairs O(n^2).
      *
@@ -57,8 +91,58 @@ public:
      */
     virtual void iterate_pairs(const std::function<particle_pair_it>& iterator);
 
+    /**
+     * Iterate through the particle pairs O(n^2), passing the displacement from the second to the first particle and the squared distance.
+     *
+     * @param iterator The particle pair iterator.
+     */
+    virtual void iterate_pairs(const std::function<displacement_pair_it>& iterator);
+
     /**
      * Update the particle positions in their cells.
      */
     virtual void update_positions();
 };
+
+template <typename F> inline void DSContainer::for_each_pair(const F& iterator) {
+    for (auto i = begin(); i < end(); i++) {
+        for (auto j = i + 1; j < end(); j++) {
+            if constexpr (is_displacement_iterator<F>) {
+                const Vec<double> diff = i->getX() - j->getX();
+                iterator(*i, *j, diff, diff.len_squ());
+            } else {
+                iterator(*i, *j);
+            }
+        }
+    }
+}
+
+template <typename F> inline void DSContainer::for_each_candidate_pair(const F& iterator) {
+    for (size_t i = 0; i < particles.size(); i++) {
+        for (size_t j = i + 1; j < particles.size(); j++) {
+            iterator(i, j);
+        }
+    }
+}
+
+template <typename F> inline void DSContainer::for_each_tile_pair(const F& iterator) {
+    const size_t n = particles.size();
+    const size_t tiles = (n + tile_size - 1) / tile_size;
+
+    // Only the tile pairs of the upper triangle are visited, the pairs below the diagonal are skipped
+#pragma omp for collapse(2) schedule(dynamic)
+    for (size_t a = 0; a < tiles; a++) {
+        for (size_t b = 0; b < tiles; b++) {
+            if (b < a) {
+                continue;
+            }
+
+            const size_t b_last = std::min((b + 1) * tile_size, n);
+
+            for (size_t i = a * tile_size; i < std::min((a + 1) * tile_size, n); i++) {
+                // A tile paired with itself only visits the pairs above the diagonal
+                iterator(i, a == b ? i + 1 : b * tile_size, b_last);
+            }
+        }
+    }
+}
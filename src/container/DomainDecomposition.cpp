@@ -0,0 +1,293 @@
+#include "DomainDecomposition.h"
+
+#include <spdlog/spdlog.h>
+
+#ifdef MOLSIM_MPI
+#include <mpi.h>
+#endif
+
+DomainDecomposition::DomainDecomposition(const Environment& env)
+    : domain { env.get_domain_size() }
+    , boundaries { env.get_boundary_type() } {
+#ifdef MOLSIM_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+#endif
+
+    grid = create_grid(size, env.get_dimensions());
+    setup();
+}
+
+DomainDecomposition::DomainDecomposition(const Environment& env, const std::array<int, 3>& new_grid, const int new_rank)
+    : grid { new_grid }
+    , rank { new_rank }
+    , size { new_grid[0] * new_grid[1] * new_grid[2] }
+    , domain { env.get_domain_size() }
+    , boundaries { env.get_boundary_type() } {
+    setup();
+}
+
+std::array<int, 3> DomainDecomposition::create_grid(const int ranks, const size_t dimensions) {
+    // A fixed entry of 1 prevents the z direction of two dimensional simulations from being split
+    std::array<int, 3> new_grid = { 0, 0, dimensions == 2 ? 1 : 0 };
+
+#ifdef MOLSIM_MPI
+    MPI_Dims_create(ranks, 3, new_grid.data());
+#else
+    new_grid = { ranks, 1, 1 };
+#endif
+
+    return new_grid;
+}
+
+void DomainDecomposition::setup() {
+    // The ranks are numbered with x being the fastest changing direction
+    coords = { rank % grid[0], (rank / grid[0]) % grid[1], rank / (grid[0] * grid[1]) };
+
+    for (size_t d = 0; d < 3; d++) {
+        const double width = domain[d] / grid[d];
+        lower[d] = coords[d] * width;
+        upper[d] = coords[d] + 1 == grid[d] ? domain[d] : (coords[d] + 1) * width;
+
+        for (const int dir : { -1, 1 }) {
+            const size_t face = dir < 0 ? d : d + 3;
+            std::array<int, 3> c = coords;
+            c[d] += dir;
+
+            if (c[d] < 0 || c[d] >= grid[d]) {
+                if (boundaries[face] != PERIODIC) {
+                    neighbors[face] = -1;
+                    continue;
+                }
+
+                c[d] = (c[d] + grid[d]) % grid[d];
+            }
+
+            neighbors[face] = get_rank_at(c);
+        }
+    }
+}
+
+int DomainDecomposition::get_rank_at(const std::array<int, 3>& c) const { return c[0] + grid[0] * (c[1] + grid[1] * c[2]); }
+
+double DomainDecomposition::get_shift(const size_t face) const {
+    const size_t d = face % 3;
+
+    // Only the faces of the global domain shift the particles to the periodic image on the opposite side
+    if (face < 3 && coords[d] == 0) {
+        return domain[d];
+    }
+
+    if (face >= 3 && coords[d] + 1 == grid[d]) {
+        return -domain[d];
+    }
+
+    return 0.0;
+}
+
+std::vector<double> DomainDecomposition::shift_buffer(const std::vector<double>& send, const int destination, const int source) const {
+    std::vector<double> receive;
+
+#ifdef MOLSIM_MPI
+    const int send_dest = destination < 0 ? MPI_PROC_NULL : destination;
+    const int recv_source = source < 0 ? MPI_PROC_NULL : source;
+
+    // The sizes are exchanged first, such that the receive buffer can be allocated
+    unsigned long send_count = send.size();
+    unsigned long recv_count = 0;
+    MPI_Sendrecv(&send_count, 1, MPI_UNSIGNED_LONG, send_dest, 0, &recv_count, 1, MPI_UNSIGNED_LONG, recv_source, 0, MPI_COMM_WORLD,
+        MPI_STATUS_IGNORE);
+
+    receive.resize(recv_count);
+    MPI_Sendrecv(send.data(), static_cast<int>(send_count), MPI_DOUBLE, send_dest, 1, receive.data(), static_cast<int>(recv_count), MPI_DOUBLE,
+        recv_source, 1, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+#else
+    if (destination >= 0 || source >= 0) {
+        SPDLOG_CRITICAL("Exchanging particles between subdomains requires a build with MPI.");
+        std::exit(EXIT_FAILURE);
+    }
+#endif
+
+    return receive;
+}
+
+std::shared_ptr<BoxContainer> DomainDecomposition::create_container(ParticleContainer& global, const Environment& env) const {
+    std::vector<Particle> particles;
+
+    for (const auto& p : global) {
+        bool inside = true;
+
+        // The subdomains at the global faces also take the particles outside of the domain
+        for (size_t d = 0; d < 3; d++) {
+            if ((p.getX()[d] < lower[d] && coords[d] > 0) || (p.getX()[d] >= upper[d] && coords[d] + 1 < grid[d])) {
+                inside = false;
+            }
+        }
+
+        if (inside) {
+            particles.push_back(p);
+            particles.back().setX(p.getX() - lower);
+        }
+    }
+
+    auto cont = std::make_shared<BoxContainer>(particles, env.get_r_cutoff(), get_local_domain_size(), global.get_types(), env.get_skin(),
+        env.get_reorder(), env.get_sub_cells(), env.get_dimensions(), env.get_cell_tasks(), env.get_balance());
+
+    // The halo copies must be located in the subdomains directly adjacent to the own subdomain
+    for (size_t d = 0; d < 3; d++) {
+        if (grid[d] > 1 && cont->get_halo_width()[d] > domain[d] / grid[d]) {
+            SPDLOG_CRITICAL("The subdomains must be at least as wide as the halo cells, use fewer ranks.");
+            std::exit(EXIT_FAILURE);
+        }
+    }
+
+    return cont;
+}
+
+Environment DomainDecomposition::create_environment(const Environment& env) const {
+    Environment local = env;
+    local.set_domain_size(get_local_domain_size());
+
+    return local;
+}
+
+void DomainDecomposition::migrate_particles(ParticleContainer& cont) const {
+    const Vec<double> local_size = get_local_domain_size();
+
+    for (size_t d = 0; d < 3; d++) {
+        // Directions with a single subdomain are handled by the boundaries of the container
+        if (grid[d] == 1) {
+            continue;
+        }
+
+        std::array<std::vector<double>, 2> send;
+        size_t n = cont.size();
+
+        for (size_t i = 0; i < n;) {
+            Particle& p = cont.begin()[i];
+            const size_t face = p.getX()[d] < 0.0 ? d : (p.getX()[d] >= local_size[d] ? d + 3 : 6);
+
+            if (face == 6 || neighbors[face] < 0) {
+                i++;
+                continue;
+            }
+
+            // Send the position within the global domain, such that the receiving rank can subtract its own lower corner
+            Vec<double> x = p.getX() + lower;
+            x[d] += get_shift(face);
+
+            std::vector<double>& buffer = send[face < 3 ? 0 : 1];
+            buffer.insert(buffer.end(), { x[0], x[1], x[2], p.getV()[0], p.getV()[1], p.getV()[2], p.getF()[0], p.getF()[1], p.getF()[2],
+                                            p.getOldF()[0], p.getOldF()[1], p.getOldF()[2], static_cast<double>(p.getType()) });
+
+            // Replace the particle by the last one
+            p = cont.begin()[n - 1];
+            n--;
+        }
+
+        cont.resize(n);
+
+        // Send down while receiving from above, then send up while receiving from below
+        const std::vector<double> from_upper = shift_buffer(send[0], neighbors[d], neighbors[d + 3]);
+        const std::vector<double> from_lower = shift_buffer(send[1], neighbors[d + 3], neighbors[d]);
+
+        for (const auto* buffer : { &from_upper, &from_lower }) {
+            const size_t offset = cont.size();
+            cont.resize(offset + buffer->size() / migration_doubles);
+
+            for (size_t k = 0; k < buffer->size() / migration_doubles; k++) {
+                const double* b = buffer->data() + k * migration_doubles;
+                Particle& p = cont.begin()[offset + k];
+
+                p.setX(Vec<double>(b[0], b[1], b[2]) - lower);
+                p.setV({ b[3], b[4], b[5] });
+                p.setF({ b[6], b[7], b[8] });
+                p.setOldF({ b[9], b[10], b[11] });
+                p.setType(static_cast<int>(b[12]));
+            }
+        }
+    }
+}
+
+void DomainDecomposition::exchange_halo(BoxContainer& cont) const {
+    const Vec<double> width = cont.get_halo_width();
+    const Vec<double> local_size = get_local_domain_size();
+
+    cont.begin_ghosts();
+
+    for (size_t d = 0; d < 3; d++) {
+        // A single periodic subdomain is its own neighbor, the images are created locally and their forces are folded back
+        if (grid[d] == 1) {
+            if (boundaries[d] == PERIODIC) {
+                cont.replicate_ghosts(d);
+            }
+
+            continue;
+        }
+
+        // The ghost particles received for the previous directions are sent as well, which covers the edges and corners
+        std::array<std::vector<double>, 2> send;
+
+        for (const auto& p : cont) {
+            for (const size_t face : { d, d + 3 }) {
+                const bool close = face < 3 ? p.getX()[d] < width[d] : p.getX()[d] >= local_size[d] - width[d];
+
+                if (!close || neighbors[face] < 0) {
+                    continue;
+                }
+
+                Vec<double> x = p.getX() + lower;
+                x[d] += get_shift(face);
+
+                send[face < 3 ? 0 : 1].insert(send[face < 3 ? 0 : 1].end(), { x[0], x[1], x[2], static_cast<double>(p.getType()) });
+            }
+        }
+
+        const std::vector<double> from_upper = shift_buffer(send[0], neighbors[d], neighbors[d + 3]);
+        const std::vector<double> from_lower = shift_buffer(send[1], neighbors[d + 3], neighbors[d]);
+
+        for (const auto* buffer : { &from_upper, &from_lower }) {
+            for (size_t k = 0; k < buffer->size() / halo_doubles; k++) {
+                const double* b = buffer->data() + k * halo_doubles;
+                Particle ghost { Vec<double>(b[0], b[1], b[2]) - lower, { 0.0, 0.0, 0.0 }, static_cast<int>(b[3]) };
+                cont.add_remote_ghost(ghost);
+            }
+        }
+    }
+
+    cont.finish_ghosts();
+}
+
+void DomainDecomposition::calculate_forces(physicsCalculator::Calculator& calc) const {
+    BoxContainer& cont = dynamic_cast<BoxContainer&>(calc.get_container());
+
+    exchange_halo(cont);
+    calc.calculateF();
+    cont.fold_ghost_forces();
+}
+
+double DomainDecomposition::sum(const double value) const {
+    double total = value;
+
+#ifdef MOLSIM_MPI
+    MPI_Allreduce(&value, &total, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+#endif
+
+    return total;
+}
+
+std::array<BoundaryType, 6> DomainDecomposition::get_local_boundary_type() const {
+    std::array<BoundaryType, 6> local = boundaries;
+
+    for (size_t face = 0; face < 6; face++) {
+        const size_t d = face % 3;
+        const bool global_face = face < 3 ? coords[d] == 0 : coords[d] + 1 == grid[d];
+
+        // Periodic faces split among multiple ranks are handled by the migration like the faces shared with another rank
+        if (!global_face || (boundaries[face] == PERIODIC && grid[d] > 1)) {
+            local[face] = INF_CONT;
+        }
+    }
+
+    return local;
+}
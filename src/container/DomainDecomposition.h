@@ -0,0 +1,274 @@
+/**
+ * @file DomainDecomposition.h
+ *
+ * @brief Define the decomposition of the domain into one subdomain per MPI rank.
+ */
+
+#pragma once
+
+#include "Environment.h"
+#include "container/BoxContainer.h"
+#include "physicsCalculator/Calculator.h"
+
+#include <array>
+#include <memory>
+#include <vector>
+
+/**
+ * @class DomainDecomposition
+ *
+ * @brief Split the domain into a grid of equally sized subdomains, one per MPI rank.
+ *
+ * Every rank stores the particles of its subdomain in its own box container, whose positions are relative to the lower corner of the
+ * subdomain. Before every force calculation, the particles within the halo width of a subdomain face are copied into the halo cells of the
+ * neighboring rank. The faces are exchanged one direction after another, such that the edges and corners are covered as well. Every rank
+ * computes the forces on its own particles, the forces on the copies are discarded. Particles leaving a subdomain are handed to the
+ * neighboring rank after the position update. The boundaries of the global domain are applied by the ranks touching them, periodic
+ * boundaries wrap around to the rank on the opposite side. Without MPI, the decomposition consists of a single subdomain.
+ */
+class DomainDecomposition {
+private:
+    /**
+     * Store the number of doubles a particle occupies in a migration message.
+     */
+    static constexpr size_t migration_doubles = 13;
+
+    /**
+     * Store the number of doubles a particle occupies in a halo message.
+     */
+    static constexpr size_t halo_doubles = 4;
+
+    /**
+     * Store the number of subdomains in every direction.
+     */
+    std::array<int, 3> grid = { 1, 1, 1 };
+
+    /**
+     * Store the position of the own subdomain within the grid.
+     */
+    std::array<int, 3> coords = { 0, 0, 0 };
+
+    /**
+     * Store the rank of this process and the number of ranks.
+     */
+    int rank = 0, size = 1;
+
+    /**
+     * Store the ranks owning the neighboring subdomains in the order of the boundary faces. A value of -1 indicates that the face is a
+     * boundary of the global domain, which is not periodic.
+     */
+    std::array<int, 6> neighbors = { -1, -1, -1, -1, -1, -1 };
+
+    /**
+     * Store the size of the global domain.
+     */
+    Vec<double> domain;
+
+    /**
+     * Store the lower and upper corner of the own subdomain.
+     */
+    Vec<double> lower, upper;
+
+    /**
+     * Store the boundary types of the global domain.
+     */
+    std::array<BoundaryType, 6> boundaries;
+
+    /**
+     * Compute the bounds of the own subdomain and the neighboring ranks from the grid and the own rank.
+     */
+    void setup();
+
+    /**
+     * Get the rank owning the subdomain at the given grid position.
+     *
+     * @param c The position within the grid.
+     *
+     * @return The rank of the subdomain.
+     */
+    int get_rank_at(const std::array<int, 3>& c) const;
+
+    /**
+     * Get the shift added to the global positions of particles crossing the given face, which is not zero for periodic boundaries.
+     *
+     * @param face The index of the face.
+     *
+     * @return The shift along the direction of the face.
+     */
+    double get_shift(const size_t face) const;
+
+protected:
+    /**
+     * Send a buffer to one rank, while receiving a buffer from another rank. Ranks of -1 are skipped. The exchange is virtual, such that the
+     * tests can hand the buffers between the subdomains of a single process.
+     *
+     * @param send The buffer to send.
+     * @param destination The rank receiving the buffer.
+     * @param source The rank sending the received buffer.
+     *
+     * @return The received buffer.
+     */
+    virtual std::vector<double> shift_buffer(const std::vector<double>& send, const int destination, const int source) const;
+
+public:
+    /**
+     * Decompose the domain of the environment among all MPI ranks. The grid is chosen by MPI, it never splits the z direction of two
+     * dimensional simulations.
+     *
+     * @param env The simulation environment storing the global domain.
+     */
+    explicit DomainDecomposition(const Environment& env);
+
+    /**
+     * Decompose the domain of the environment using the given grid without communicating. This constructor should only be used for testing
+     * the subdomains.
+     *
+     * @param env The simulation environment storing the global domain.
+     * @param new_grid The number of subdomains in every direction.
+     * @param new_rank The rank of the own subdomain.
+     */
+    DomainDecomposition(const Environment& env, const std::array<int, 3>& new_grid, const int new_rank);
+
+    /**
+     * Provide a default destructor for a domain decomposition.
+     */
+    virtual ~DomainDecomposition() = default;
+
+    /**
+     * Choose the number of subdomains in every direction, such that the grid is as balanced as possible.
+     *
+     * @param ranks The number of ranks.
+     * @param dimensions The number of simulated dimensions, either 2 or 3.
+     *
+     * @return The number of subdomains in every direction.
+     */
+    static std::array<int, 3> create_grid(const int ranks, const size_t dimensions);
+
+    /**
+     * Create the container of the own subdomain from a container storing all particles of the global domain.
+     *
+     * @param global The container storing all particles.
+     * @param env The simulation environment storing the global domain.
+     *
+     * @return The container storing the particles of the own subdomain relative to its lower corner.
+     */
+    std::shared_ptr<BoxContainer> create_container(ParticleContainer& global, const Environment& env) const;
+
+    /**
+     * Create the environment of the own subdomain, which only differs in the domain size.
+     *
+     * @param env The simulation environment storing the global domain.
+     *
+     * @return The environment of the own subdomain.
+     */
+    Environment create_environment(const Environment& env) const;
+
+    /**
+     * Hand the particles, which left the own subdomain through a face shared with another rank, to that rank and insert the particles
+     * received from the neighboring ranks.
+     *
+     * @param cont The container of the own subdomain.
+     */
+    void migrate_particles(ParticleContainer& cont) const;
+
+    /**
+     * Append copies of the particles within the halo width of the faces of the neighboring subdomains and the periodic images of the own
+     * particles as ghost particles.
+     *
+     * @param cont The container of the own subdomain.
+     */
+    void exchange_halo(BoxContainer& cont) const;
+
+    /**
+     * Add the forces of all particles within the cutoff distance, including the particles of the neighboring subdomains, to the forces of the
+     * own particles.
+     *
+     * @param calc The calculator storing the container of the own subdomain.
+     */
+    void calculate_forces(physicsCalculator::Calculator& calc) const;
+
+    /**
+     * Sum up a value over all ranks.
+     *
+     * @param value The value of this rank.
+     *
+     * @return The sum over all ranks.
+     */
+    double sum(const double value) const;
+
+    /**
+     * Call a function, while the positions of the particles of the own subdomain are shifted to the global domain, e.g. for writing output.
+     *
+     * @param cont The container of the own subdomain.
+     * @param function The function to call.
+     */
+    template <typename F> void with_global_positions(ParticleContainer& cont, const F& function) const;
+
+    /**
+     * Get the boundary types of the own subdomain. Faces shared with another rank have no boundary.
+     *
+     * @return The boundary types of the own subdomain.
+     */
+    std::array<BoundaryType, 6> get_local_boundary_type() const;
+
+    /**
+     * Get the size of the own subdomain.
+     *
+     * @return The size of the own subdomain.
+     */
+    inline Vec<double> get_local_domain_size() const { return upper - lower; }
+
+    /**
+     * Get the lower corner of the own subdomain.
+     *
+     * @return The lower corner of the own subdomain.
+     */
+    inline const Vec<double>& get_lower() const { return lower; }
+
+    /**
+     * Get the upper corner of the own subdomain.
+     *
+     * @return The upper corner of the own subdomain.
+     */
+    inline const Vec<double>& get_upper() const { return upper; }
+
+    /**
+     * Get the number of subdomains in every direction.
+     *
+     * @return The number of subdomains in every direction.
+     */
+    inline const std::array<int, 3>& get_grid() const { return grid; }
+
+    /**
+     * Get the ranks owning the neighboring subdomains in the order of the boundary faces, -1 for non periodic global boundaries.
+     *
+     * @return The neighboring ranks.
+     */
+    inline const std::array<int, 6>& get_neighbors() const { return neighbors; }
+
+    /**
+     * Get the rank of this process.
+     *
+     * @return The rank of this process.
+     */
+    inline int get_rank() const { return rank; }
+
+    /**
+     * Get the number of ranks.
+     *
+     * @return The number of ranks.
+     */
+    inline int get_size() const { return size; }
+};
+
+template <typename F> inline void DomainDecomposition::with_global_positions(ParticleContainer& cont, const F& function) const {
+    for (auto& p : cont) {
+        p.setX(p.getX() + lower);
+    }
+
+    function();
+
+    for (auto& p : cont) {
+        p.setX(p.getX() - lower);
+    }
+}
@@ -1,5 +1,13 @@
 #include "ParticleContainer.h"
 
+#include "utils/Morton.h"
+#include "utils/Numa.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+
 ParticleContainer::ParticleContainer() = default;
 
 ParticleContainer::ParticleContainer(const std::vector<Particle>& new_particles, const std::vector<TypeDesc>& new_desc)
@@ -30,6 +38,13 @@ size_t ParticleContainer::size() const { return particles.size(); }
 
 void ParticleContainer::resize(size_t new_size) { particles.resize(new_size); }
 
+void ParticleContainer::iterate_pairs(const std::function<displacement_pair_it>& iterator) {
+    iterate_pairs([&iterator](Particle& p1, Particle& p2) {
+        const Vec<double> diff = p1.getX() - p2.getX();
+        iterator(p1, p2, diff, diff.len_squ());
+    });
+}
+
 void ParticleContainer::remove_particles_out_of_domain() {
     for (size_t i = 0; i < particles.size(); i++) {
         bool removed = true;
@@ -55,6 +70,56 @@ void ParticleContainer::remove_particles_out_of_domain() {
     }
 }
 
+void ParticleContainer::sort_particles(const double cell_width) {
+    if (particles.empty()) {
+        return;
+    }
+
+    // Use the lower corner of the particles as origin, since the direct sum particles may have negative coordinates
+    Vec<double> origin = particles[0].getX();
+
+    for (const Particle& p : particles) {
+        for (size_t d = 0; d < 3; d++) {
+            origin[d] = std::min(origin[d], p.getX()[d]);
+        }
+    }
+
+    std::vector<uint64_t> keys(particles.size());
+
+    for (size_t i = 0; i < particles.size(); i++) {
+        const Vec<double> rel = particles[i].getX() - origin;
+
+        keys[i] = Morton::key(static_cast<uint64_t>(rel[0] / cell_width), static_cast<uint64_t>(rel[1] / cell_width),
+            static_cast<uint64_t>(rel[2] / cell_width));
+    }
+
+    std::vector<size_t> order(particles.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&keys](const size_t i, const size_t j) { return keys[i] < keys[j]; });
+
+    // Write the sorted particles into the existing allocation, whose pages were placed by the first touch
+    const std::vector<Particle> unsorted = particles;
+
+    for (size_t i = 0; i < order.size(); i++) {
+        particles[i] = unsorted[order[i]];
+    }
+}
+
+void ParticleContainer::first_touch(const bool huge_pages) {
+    Numa::first_touch(particles, huge_pages);
+    soa.huge_pages = huge_pages;
+    placed = particles.data();
+}
+
+bool ParticleContainer::is_placed() const { return particles.data() == placed; }
+
+ParticleSoA& ParticleContainer::load_soa(const bool single_precision) {
+    soa.gather(particles, single_precision);
+    return soa;
+}
+
+void ParticleContainer::store_soa_forces() { soa.scatter_forces(particles); }
+
 const Vec<double>& ParticleContainer::get_corner_vector() const { return domain; }
 
 std::vector<TypeDesc> ParticleContainer::get_types() const { return types; }
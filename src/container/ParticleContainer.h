@@ -8,6 +8,7 @@
 
 #include "Particle.h"
 #include "container/CellList.h"
+#include "container/ParticleSoA.h"
 #include "container/TypeDesc.h"
 #include "container/TypePairDesc.h"
 
@@ -42,6 +43,16 @@ protected:
      */
     std::vector<TypePairDesc> type_pairs;
 
+    /**
+     * Store the structure of arrays mirror of the particle data used by the force kernels.
+     */
+    ParticleSoA soa;
+
+    /**
+     * Store the start of the particle vector, whose pages were placed on the NUMA nodes by the last first touch.
+     */
+    const Particle* placed = nullptr;
+
 public:
     /**
      * Create a particle container with an empty particle vector.
@@ -141,6 +152,14 @@ public:
      */
     virtual void iterate_pairs(const std::function<particle_pair_it>& iterator) = 0;
 
+    /**
+     * Iterate over all pairs and pass the displacement from the second to the first particle and their squared distance along with the particles.
+     * The containers pass the values computed for their cutoff test, the default implementation computes them for every pair.
+     *
+     * @param iterator The iterator lambda that should loop over all the pairs.
+     */
+    virtual void iterate_pairs(const std::function<displacement_pair_it>& iterator);
+
     /**
      * Remove all particles which are out of the domain.
      */
@@ -151,6 +170,44 @@ public:
      */
     virtual void update_positions() = 0;
 
+    /**
+     * Sort the particles along a Morton (Z-order) curve of their cell coordinates, such that particles close in space are stored close in memory.
+     * The sorted particles are written into the existing allocation, such that its pages stay on their NUMA nodes.
+     *
+     * @param cell_width The width of the cells used for the space filling curve.
+     */
+    virtual void sort_particles(const double cell_width);
+
+    /**
+     * Move the pages of the particles to the NUMA nodes of the threads updating them, by touching them again in the static schedule of the
+     * integrator. The structure of arrays is allocated the same way, whenever it grows.
+     *
+     * @param huge_pages Ask the operating system to back the particles and the structure of arrays with transparent huge pages.
+     */
+    virtual void first_touch(const bool huge_pages);
+
+    /**
+     * Check if the pages of the particles are still placed by the last first touch, i.e. if the particle vector was not reallocated since, e.g.
+     * by a growing number of ghost particles.
+     *
+     * @return A boolean indicating if the particles are still placed.
+     */
+    bool is_placed() const;
+
+    /**
+     * Gather the positions and types of the particles into the structure of arrays and reset its forces.
+     *
+     * @param single_precision Additionally gather the positions in single precision for the mixed precision kernels.
+     *
+     * @return The structure of arrays storing the particle data.
+     */
+    ParticleSoA& load_soa(const bool single_precision = false);
+
+    /**
+     * Add the forces accumulated in the structure of arrays to the particles.
+     */
+    void store_soa_forces();
+
     /**
      * Get the vector pointing to the corner of the domain.
      *
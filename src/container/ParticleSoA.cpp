@@ -0,0 +1,102 @@
+#include "ParticleSoA.h"
+
+#include "utils/Numa.h"
+#include "utils/Threads.h"
+
+#include <algorithm>
+
+/**
+ * Resize an array without writing its new elements. A new allocation discards the previous content and may be backed by huge pages.
+ *
+ * @param values The array.
+ * @param n The new size.
+ * @param huge_pages Ask the operating system to back a new allocation with transparent huge pages.
+ */
+template <typename T> static void resize_array(aligned_vector<T>& values, const size_t n, const bool huge_pages) {
+    if (n > values.capacity()) {
+        values = aligned_vector<T>();
+        values.reserve(n);
+
+        if (huge_pages) {
+            Numa::release_pages(values.data(), n * sizeof(T), true);
+        }
+    }
+
+    values.resize(n);
+}
+
+void ParticleSoA::gather(const std::vector<Particle>& particles, const bool single_precision) {
+    const size_t n = particles.size();
+
+    if (single_precision) {
+        resize_array(x_single, n, huge_pages);
+        resize_array(y_single, n, huge_pages);
+        resize_array(z_single, n, huge_pages);
+    }
+
+    resize_array(x, n, huge_pages);
+    resize_array(y, n, huge_pages);
+    resize_array(z, n, huge_pages);
+    resize_array(type, n, huge_pages);
+    resize_array(f_x, n, huge_pages);
+    resize_array(f_y, n, huge_pages);
+    resize_array(f_z, n, huge_pages);
+
+#pragma omp parallel for schedule(static)
+    for (size_t i = 0; i < n; i++) {
+        const Vec<double>& pos = particles[i].getX();
+        x[i] = pos[0];
+        y[i] = pos[1];
+        z[i] = pos[2];
+        type[i] = particles[i].getType();
+        f_x[i] = 0.0;
+        f_y[i] = 0.0;
+        f_z[i] = 0.0;
+
+        if (single_precision) {
+            x_single[i] = static_cast<float>(pos[0]);
+            y_single[i] = static_cast<float>(pos[1]);
+            z_single[i] = static_cast<float>(pos[2]);
+        }
+    }
+}
+
+void ParticleSoA::scatter_forces(std::vector<Particle>& particles) const {
+    const size_t n = particles.size();
+
+#pragma omp parallel for schedule(static)
+    for (size_t i = 0; i < n; i++) {
+        particles[i].setF(particles[i].getF() + Vec<double>(f_x[i], f_y[i], f_z[i]));
+    }
+}
+
+void ParticleSoA::allocate_buffers() {
+#pragma omp single
+    {
+        // Only the threads of the team clear their buffers, such that surplus buffers must not be kept for the reduction
+        buffers.resize(Threads::get_num_threads());
+
+        // The buffers are cleared by their threads before every use, such that the threads touch the pages of their own buffers first
+        for (aligned_vector<double>& buffer : buffers) {
+            resize_array(buffer, 3 * size(), huge_pages);
+        }
+    }
+}
+
+double* ParticleSoA::clear_buffer(const size_t thread) {
+    std::fill(buffers[thread].begin(), buffers[thread].end(), 0.0);
+    return buffers[thread].data();
+}
+
+void ParticleSoA::reduce_buffers() {
+    const size_t n = size();
+
+#pragma omp for schedule(static)
+    for (size_t i = 0; i < n; i++) {
+        for (const aligned_vector<double>& buffer : buffers) {
+            f_x[i] += buffer[i];
+            f_y[i] += buffer[n + i];
+            f_z[i] += buffer[2 * n + i];
+        }
+    }
+}
@@ -0,0 +1,154 @@
+/**
+ * @file
+ *
+ * @brief Define the structure of arrays layout of the particle data used by the force kernels.
+ */
+
+#pragma once
+
+#include "Particle.h"
+#include "utils/AlignedAllocator.h"
+
+#include <array>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @typedef aligned_vector
+ *
+ * The aligned vector type is a standard vector, whose data is aligned to a cache line.
+ */
+template <typename T> using aligned_vector = std::vector<T, AlignedAllocator<T, 64>>;
+
+/**
+ * @class ParticleSoA
+ *
+ * @brief Store the data required by the force calculation in a structure of arrays.
+ *
+ * The particle vector stays the primary storage of the particles. Before the force calculation the positions and types are gathered into
+ * separate aligned arrays and the forces are accumulated in separate arrays, which are added to the particles afterwards. The force kernels
+ * therefore only stream through the data they require.
+ */
+class ParticleSoA {
+public:
+    /**
+     * Store the x coordinates of the particles.
+     */
+    aligned_vector<double> x;
+
+    /**
+     * Store the y coordinates of the particles.
+     */
+    aligned_vector<double> y;
+
+    /**
+     * Store the z coordinates of the particles.
+     */
+    aligned_vector<double> z;
+
+    /**
+     * Store the x coordinates of the particles in single precision, which are only gathered for the mixed precision kernels.
+     */
+    aligned_vector<float> x_single;
+
+    /**
+     * Store the y coordinates of the particles in single precision.
+     */
+    aligned_vector<float> y_single;
+
+    /**
+     * Store the z coordinates of the particles in single precision.
+     */
+    aligned_vector<float> z_single;
+
+    /**
+     * Store the x components of the forces accumulated by the kernel.
+     */
+    aligned_vector<double> f_x;
+
+    /**
+     * Store the y components of the forces accumulated by the kernel.
+     */
+    aligned_vector<double> f_y;
+
+    /**
+     * Store the z components of the forces accumulated by the kernel.
+     */
+    aligned_vector<double> f_z;
+
+    /**
+     * Store the types of the particles.
+     */
+    aligned_vector<int> type;
+
+    /**
+     * Store a private force buffer for every thread. The buffer of a thread stores the x, y and z components of the forces of all particles one
+     * after another.
+     */
+    std::vector<aligned_vector<double>> buffers;
+
+    /**
+     * Store if the arrays are backed by transparent huge pages, whenever they are allocated.
+     */
+    bool huge_pages = false;
+
+    /**
+     * Gather the positions and types of the particles and reset the accumulated forces. The arrays are written by a statically scheduled loop,
+     * such that newly allocated pages are placed on the NUMA nodes of the threads using them.
+     *
+     * @param particles The particles vector.
+     * @param single_precision Additionally gather the positions in single precision.
+     */
+    void gather(const std::vector<Particle>& particles, const bool single_precision = false);
+
+    /**
+     * Add the accumulated forces to the forces of the particles.
+     *
+     * @param particles The particles vector.
+     */
+    void scatter_forces(std::vector<Particle>& particles) const;
+
+    /**
+     * Allocate a force buffer for every thread of the current team, which is large enough to store the forces of all particles. This method must
+     * be called by all threads of a parallel region, since the team may be smaller than the maximum number of threads. The buffers are allocated
+     * by a single thread, the other threads wait until they are available.
+     */
+    void allocate_buffers();
+
+    /**
+     * Reset the force buffer of a thread to zero.
+     *
+     * @param thread The index of the thread.
+     *
+     * @return The pointer to the x components of the buffer, the y and z components follow after the number of particles.
+     */
+    double* clear_buffer(const size_t thread);
+
+    /**
+     * Add the force buffers of all threads of the team to the accumulated forces. If this method is called by all threads of a parallel region,
+     * the particles are distributed among the threads. The buffers must not be written anymore.
+     */
+    void reduce_buffers();
+
+    /**
+     * Get the positions of the particles in the precision of a kernel. The single precision positions must have been gathered.
+     *
+     * @tparam Real The floating point type of the kernel, either double or float.
+     *
+     * @return The pointers to the x, y and z coordinates.
+     */
+    template <typename Real> inline std::array<const Real*, 3> get_positions() const {
+        if constexpr (std::is_same_v<Real, float>) {
+            return { x_single.data(), y_single.data(), z_single.data() };
+        } else {
+            return { x.data(), y.data(), z.data() };
+        }
+    }
+
+    /**
+     * Get the number of particles stored.
+     *
+     * @return The number of particles.
+     */
+    inline size_t size() const { return x.size(); }
+};
@@ -0,0 +1,66 @@
+#include "VerletList.h"
+
+#include <spdlog/spdlog.h>
+
+VerletList::VerletList(const double rc, const double skin) {
+    rc_squ = rc * rc;
+    list_squ = (rc + skin) * (rc + skin);
+    max_disp_squ = skin * skin * 0.25;
+}
+
+void VerletList::build(CellList& cells, const std::vector<Particle>& particles) {
+    std::vector<size_t> first;
+    std::vector<size_t> second;
+
+    cells.loop_cell_index_pairs(
+        [&first, &second](const size_t i, const size_t j) {
+            first.push_back(i);
+            second.push_back(j);
+        },
+        particles, list_squ);
+
+    // Sort the pairs into the flat neighbor vector using a counting sort
+    offsets.assign(particles.size() + 1, 0);
+
+    for (size_t i : first) {
+        offsets[i + 1]++;
+    }
+
+    for (size_t i = 0; i < particles.size(); i++) {
+        offsets[i + 1] += offsets[i];
+    }
+
+    std::vector<size_t> fill(offsets.begin(), offsets.end() - 1);
+    neighbors.resize(first.size());
+
+    for (size_t i = 0; i < first.size(); i++) {
+        neighbors[fill[first[i]]++] = second[i];
+    }
+
+    reference.resize(particles.size());
+
+    for (size_t i = 0; i < particles.size(); i++) {
+        reference[i] = particles[i].getX();
+    }
+
+    builds++;
+    SPDLOG_DEBUG("Built the verlet lists with {} pairs.", neighbors.size());
+}
+
+bool VerletList::requires_rebuild(const std::vector<Particle>& particles) const {
+    if (particles.size() != reference.size()) {
+        return true;
+    }
+
+    for (size_t i = 0; i < particles.size(); i++) {
+        if ((particles[i].getX() - reference[i]).len_squ() > max_disp_squ) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void VerletList::loop_pairs(const std::function<particle_pair_it>& iterator, std::vector<Particle>& particles) { for_each_pair(iterator, particles); }
+
+size_t VerletList::get_builds() const { return builds; }
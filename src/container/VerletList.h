@@ -0,0 +1,184 @@
+/**
+ * @file VerletList.h
+ *
+ * @brief Define the verlet neighbor lists, which are built on top of the linked cells.
+ */
+
+#pragma once
+
+#include "CellList.h"
+#include "Particle.h"
+
+#include <functional>
+#include <vector>
+
+/**
+ * @class VerletList
+ *
+ * @brief Store for every particle the neighbors within the cutoff distance plus a skin.
+ *
+ * The lists are built from the linked cells and can be reused for multiple steps, until a particle moved further than half the skin.
+ */
+class VerletList {
+private:
+    /**
+     * Store the offsets of the neighbor lists of every particle within the flat neighbor vector.
+     */
+    std::vector<size_t> offsets;
+
+    /**
+     * Store the neighbors of all particles in a flat out vector. Every pair is only stored once (newton optimization).
+     */
+    std::vector<size_t> neighbors;
+
+    /**
+     * Store the positions of the particles at the time the lists were built.
+     */
+    std::vector<Vec<double>> reference;
+
+    /**
+     * Define the squared cutoff distance and the squared list distance.
+     */
+    double rc_squ, list_squ;
+
+    /**
+     * Define the squared maximum displacement before the lists must be rebuilt.
+     */
+    double max_disp_squ;
+
+    /**
+     * Count how often the lists have been built.
+     */
+    size_t builds = 0;
+
+public:
+    /**
+     * Define the default constructor.
+     */
+    VerletList() = default;
+
+    /**
+     * Define a constructor for the verlet lists.
+     *
+     * @param rc The cutoff distance.
+     * @param skin The skin added to the cutoff distance.
+     */
+    VerletList(const double rc, const double skin);
+
+    /**
+     * Define the default destructor.
+     */
+    ~VerletList() = default;
+
+    /**
+     * Build the neighbor lists using the linked cells. The cell list must be up to date and its cells must be at least as large as the cutoff
+     * distance plus the skin.
+     *
+     * @param cells The cell list storing the particles.
+     * @param particles The particles vector.
+     */
+    void build(CellList& cells, const std::vector<Particle>& particles);
+
+    /**
+     * Test if the neighbor lists must be rebuilt, because a particle moved further than half the skin or the particles changed.
+     *
+     * @param particles The particles vector.
+     *
+     * @return A boolean indicating if the lists must be rebuilt.
+     */
+    bool requires_rebuild(const std::vector<Particle>& particles) const;
+
+    /**
+     * Loop through the index pairs stored in the neighbor lists without testing their distance. The iterator must filter the pairs by their
+     * distance itself. A batch iterator receives every particle together with its whole neighbor list.
+     *
+     * @param iterator The index pair or batch iteration lambda.
+     */
+    template <typename F> void for_each_candidate_pair(const F& iterator);
+
+    /**
+     * Loop through the index pairs stored in the neighbor lists without testing their distance, while the particles are distributed among the
+     * threads of the enclosing OpenMP parallel region. This method must be called by every thread of the region. The iterator must only write to
+     * thread private data and filter the pairs by their distance itself. A batch iterator receives every particle together with its whole
+     * neighbor list.
+     *
+     * @param iterator The index pair or batch iteration lambda.
+     */
+    template <typename F> void for_each_distributed_candidate_pair(const F& iterator);
+
+    /**
+     * Loop through the particle pairs within the cutoff distance. The iterator is a template parameter, such that it can be inlined into the loop.
+     * An iterator accepting a displacement pair receives the displacement and the squared distance of the cutoff test.
+     *
+     * @param iterator The particle iteration lambda.
+     * @param particles The particles vector.
+     */
+    template <typename F> void for_each_pair(const F& iterator, std::vector<Particle>& particles);
+
+    /**
+     * Loop through the particle pairs within the cutoff distance.
+     *
+     * @param iterator The particle iteration lambda.
+     * @param particles The particles vector.
+     */
+    void loop_pairs(const std::function<particle_pair_it>& iterator, std::vector<Particle>& particles);
+
+    /**
+     * Get how often the lists have been built.
+     *
+     * @return The number of builds.
+     */
+    size_t get_builds() const;
+};
+
+template <typename F> inline void VerletList::for_each_pair(const F& iterator, std::vector<Particle>& particles) {
+    for (size_t i = 0; i + 1 < offsets.size(); i++) {
+        Particle& self = particles[i];
+
+        for (size_t k = offsets[i]; k < offsets[i + 1]; k++) {
+            Particle& other = particles[neighbors[k]];
+
+            const Vec<double> diff = self.getX() - other.getX();
+            const double dist_squ = diff.len_squ();
+
+            if (dist_squ <= rc_squ) {
+                visit_pair(iterator, self, other, diff, dist_squ);
+            }
+        }
+    }
+}
+
+template <typename F> inline void VerletList::for_each_candidate_pair(const F& iterator) {
+    for (size_t i = 0; i + 1 < offsets.size(); i++) {
+        if constexpr (is_batch_iterator<F>) {
+            if (offsets[i] != offsets[i + 1]) {
+                iterator(i, neighbors.data() + offsets[i], neighbors.data() + offsets[i + 1]);
+            }
+
+            continue;
+        }
+
+        for (size_t k = offsets[i]; k < offsets[i + 1]; k++) {
+            iterator(i, neighbors[k]);
+        }
+    }
+}
+
+template <typename F> inline void VerletList::for_each_distributed_candidate_pair(const F& iterator) {
+    const size_t n = offsets.empty() ? 0 : offsets.size() - 1;
+
+#pragma omp for schedule(dynamic, 64)
+    for (size_t i = 0; i < n; i++) {
+        if constexpr (is_batch_iterator<F>) {
+            if (offsets[i] != offsets[i + 1]) {
+                iterator(i, neighbors.data() + offsets[i], neighbors.data() + offsets[i + 1]);
+            }
+
+            continue;
+        }
+
+        for (size_t k = offsets[i]; k < offsets[i + 1]; k++) {
+            iterator(i, neighbors[k]);
+        }
+    }
+}
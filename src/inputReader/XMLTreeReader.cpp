@@ -81,6 +81,14 @@ namespace inputReader {
         };
         environment.set_domain_size(domain_size);
 
+        if (sim->param().sub_cells().present()) {
+            environment.set_sub_cells(sim->param().sub_cells().get());
+        }
+
+        if (sim->param().threads().present()) {
+            environment.set_threads(sim->param().threads().get());
+        }
+
         if (sim->thermo().present()) {
             if (sim->thermo().get().T_target().present()) {
                 thermostat.set_T_target(sim->thermo().get().T_target().get());
@@ -209,6 +209,22 @@ void param_t::g_grav(const g_grav_type& x) { this->g_grav_.set(x); }
 
 param_t::g_grav_type param_t::g_grav_default_value() { return g_grav_type(.0); }
 
+const param_t::sub_cells_optional& param_t::sub_cells() const { return this->sub_cells_; }
+
+param_t::sub_cells_optional& param_t::sub_cells() { return this->sub_cells_; }
+
+void param_t::sub_cells(const sub_cells_type& x) { this->sub_cells_.set(x); }
+
+void param_t::sub_cells(const sub_cells_optional& x) { this->sub_cells_ = x; }
+
+const param_t::threads_optional& param_t::threads() const { return this->threads_; }
+
+param_t::threads_optional& param_t::threads() { return this->threads_; }
+
+void param_t::threads(const threads_type& x) { this->threads_.set(x); }
+
+void param_t::threads(const threads_optional& x) { this->threads_ = x; }
+
 
 // particle_t
 //
@@ -1002,7 +1018,9 @@ param_t::param_t(const calc_type& calc, const boundaries_type& boundaries, const
     , dimensions_(dimensions, this)
     , r_cutoff_(r_cutoff, this)
     , domain_(domain, this)
-    , g_grav_(g_grav, this) { }
+    , g_grav_(g_grav, this)
+    , sub_cells_(this)
+    , threads_(this) { }
 
 param_t::param_t(const calc_type& calc, ::std::unique_ptr<boundaries_type> boundaries, const delta_t_type& delta_t, const t_end_type& t_end,
     const dimensions_type& dimensions, const r_cutoff_type& r_cutoff, ::std::unique_ptr<domain_type> domain, const g_grav_type& g_grav)
@@ -1014,7 +1032,9 @@ param_t::param_t(const calc_type& calc, ::std::unique_ptr<boundaries_type> bound
     , dimensions_(dimensions, this)
     , r_cutoff_(r_cutoff, this)
     , domain_(std::move(domain), this)
-    , g_grav_(g_grav, this) { }
+    , g_grav_(g_grav, this)
+    , sub_cells_(this)
+    , threads_(this) { }
 
 param_t::param_t(const param_t& x, ::xml_schema::flags f, ::xml_schema::container* c)
     : ::xml_schema::type(x, f, c)
@@ -1025,7 +1045,9 @@ param_t::param_t(const param_t& x, ::xml_schema::flags f, ::xml_schema::containe
     , dimensions_(x.dimensions_, f, this)
     , r_cutoff_(x.r_cutoff_, f, this)
     , domain_(x.domain_, f, this)
-    , g_grav_(x.g_grav_, f, this) { }
+    , g_grav_(x.g_grav_, f, this)
+    , sub_cells_(x.sub_cells_, f, this)
+    , threads_(x.threads_, f, this) { }
 
 param_t::param_t(const ::xercesc::DOMElement& e, ::xml_schema::flags f, ::xml_schema::container* c)
     : ::xml_schema::type(e, f | ::xml_schema::flags::base, c)
@@ -1036,7 +1058,9 @@ param_t::param_t(const ::xercesc::DOMElement& e, ::xml_schema::flags f, ::xml_sc
     , dimensions_(this)
     , r_cutoff_(this)
     , domain_(this)
-    , g_grav_(this) {
+    , g_grav_(this)
+    , sub_cells_(this)
+    , threads_(this) {
     if ((f & ::xml_schema::flags::base) == 0) {
         ::xsd::cxx::xml::dom::parser<char> p(e, true, false, false);
         this->parse(p, f);
@@ -1134,6 +1158,24 @@ void param_t::parse(::xsd::cxx::xml::dom::parser<char>& p, ::xml_schema::flags f
             }
         }
 
+        // sub_cells
+        //
+        if (n.name() == "sub_cells" && n.namespace_().empty()) {
+            if (!this->sub_cells_) {
+                this->sub_cells_.set(sub_cells_traits::create(i, f, this));
+                continue;
+            }
+        }
+
+        // threads
+        //
+        if (n.name() == "threads" && n.namespace_().empty()) {
+            if (!this->threads_) {
+                this->threads_.set(threads_traits::create(i, f, this));
+                continue;
+            }
+        }
+
         break;
     }
 
@@ -1183,6 +1225,8 @@ param_t& param_t::operator=(const param_t& x) {
         this->r_cutoff_ = x.r_cutoff_;
         this->domain_ = x.domain_;
         this->g_grav_ = x.g_grav_;
+        this->sub_cells_ = x.sub_cells_;
+        this->threads_ = x.threads_;
     }
 
     return *this;
@@ -2192,18 +2236,18 @@ calc* calc::_clone(::xml_schema::flags f, ::xml_schema::container* c) const { re
 
 calc::value calc::_xsd_calc_convert() const {
     ::xsd::cxx::tree::enum_comparator<char> c(_xsd_calc_literals_);
-    const value* i(::std::lower_bound(_xsd_calc_indexes_, _xsd_calc_indexes_ + 2, *this, c));
+    const value* i(::std::lower_bound(_xsd_calc_indexes_, _xsd_calc_indexes_ + 3, *this, c));
 
-    if (i == _xsd_calc_indexes_ + 2 || _xsd_calc_literals_[*i] != *this) {
+    if (i == _xsd_calc_indexes_ + 3 || _xsd_calc_literals_[*i] != *this) {
         throw ::xsd::cxx::tree::unexpected_enumerator<char>(*this);
     }
 
     return *i;
 }
 
-const char* const calc::_xsd_calc_literals_[2] = { "GRAVITY", "LJ_FULL" };
+const char* const calc::_xsd_calc_literals_[3] = { "GRAVITY", "LJ_FULL", "TABULATED" };
 
-const calc::value calc::_xsd_calc_indexes_[2] = { ::calc::GRAVITY, ::calc::LJ_FULL };
+const calc::value calc::_xsd_calc_indexes_[3] = { ::calc::GRAVITY, ::calc::LJ_FULL, ::calc::TABULATED };
 
 // boundaries
 //
@@ -1941,6 +1941,133 @@ public:
 
     //@}
 
+    /**
+     * @name sub_cells
+     *
+     * @brief Accessor and modifier functions for the %sub_cells
+     * optional element.
+     *
+     * Number of sub cells per cutoff distance in each direction
+     * of the linked cells.
+     */
+    //@{
+
+    /**
+     * @brief Element type.
+     */
+    typedef ::xml_schema::positive_integer sub_cells_type;
+
+    /**
+     * @brief Element optional container type.
+     */
+    typedef ::xsd::cxx::tree::optional<sub_cells_type> sub_cells_optional;
+
+    /**
+     * @brief Element traits type.
+     */
+    typedef ::xsd::cxx::tree::traits<sub_cells_type, char> sub_cells_traits;
+
+    /**
+     * @brief Return a read-only (constant) reference to the element
+     * container.
+     *
+     * @return A constant reference to the optional container.
+     */
+    const sub_cells_optional& sub_cells() const;
+
+    /**
+     * @brief Return a read-write reference to the element container.
+     *
+     * @return A reference to the optional container.
+     */
+    sub_cells_optional& sub_cells();
+
+    /**
+     * @brief Set the element value.
+     *
+     * @param x A new value to set.
+     *
+     * This function makes a copy of its argument and sets it as
+     * the new value of the element.
+     */
+    void sub_cells(const sub_cells_type& x);
+
+    /**
+     * @brief Set the element value.
+     *
+     * @param x An optional container with the new value to set.
+     *
+     * If the value is present in @a x then this function makes a copy
+     * of this value and sets it as the new value of the element.
+     * Otherwise the element container is set the 'not present' state.
+     */
+    void sub_cells(const sub_cells_optional& x);
+
+    //@}
+
+    /**
+     * @name threads
+     *
+     * @brief Accessor and modifier functions for the %threads
+     * optional element.
+     *
+     * Number of threads used for the force calculation.
+     */
+    //@{
+
+    /**
+     * @brief Element type.
+     */
+    typedef ::xml_schema::positive_integer threads_type;
+
+    /**
+     * @brief Element optional container type.
+     */
+    typedef ::xsd::cxx::tree::optional<threads_type> threads_optional;
+
+    /**
+     * @brief Element traits type.
+     */
+    typedef ::xsd::cxx::tree::traits<threads_type, char> threads_traits;
+
+    /**
+     * @brief Return a read-only (constant) reference to the element
+     * container.
+     *
+     * @return A constant reference to the optional container.
+     */
+    const threads_optional& threads() const;
+
+    /**
+     * @brief Return a read-write reference to the element container.
+     *
+     * @return A reference to the optional container.
+     */
+    threads_optional& threads();
+
+    /**
+     * @brief Set the element value.
+     *
+     * @param x A new value to set.
+     *
+     * This function makes a copy of its argument and sets it as
+     * the new value of the element.
+     */
+    void threads(const threads_type& x);
+
+    /**
+     * @brief Set the element value.
+     *
+     * @param x An optional container with the new value to set.
+     *
+     * If the value is present in @a x then this function makes a copy
+     * of this value and sets it as the new value of the element.
+     * Otherwise the element container is set the 'not present' state.
+     */
+    void threads(const threads_optional& x);
+
+    //@}
+
     /**
      * @name Constructors
      */
@@ -2033,6 +2160,8 @@ protected:
     ::xsd::cxx::tree::one<r_cutoff_type> r_cutoff_;
     ::xsd::cxx::tree::one<domain_type> domain_;
     ::xsd::cxx::tree::one<g_grav_type> g_grav_;
+    sub_cells_optional sub_cells_;
+    threads_optional threads_;
 
     //@endcond
 };
@@ -4991,7 +5120,12 @@ public:
          * @brief Calculates the Lennard-Jones forces
          * between particles.
          */
-        LJ_FULL
+        LJ_FULL,
+        /**
+         * @brief Interpolates the forces between particles
+         * from cubic spline tables of the type pairs.
+         */
+        TABULATED
     };
 
     /**
@@ -5103,8 +5237,8 @@ protected:
     value _xsd_calc_convert() const;
 
 public:
-    static const char* const _xsd_calc_literals_[2];
-    static const value _xsd_calc_indexes_[2];
+    static const char* const _xsd_calc_literals_[3];
+    static const value _xsd_calc_indexes_[3];
 
     //@endcond
 };
@@ -1,4 +1,5 @@
 #include "Calculator.h"
+#include "container/BoxContainer.h"
 #include "container/DSContainer.h"
 #include "inputReader/FileReader.h"
 #include "inputReader/Reader.h"
@@ -24,41 +25,84 @@ namespace physicsCalculator {
 
     const Environment& Calculator::get_env() const { return env; }
 
+    void Calculator::load_type_constants() {
+        const std::vector<TypeDesc> types = cont->get_types();
+
+        type_dt_m.resize(types.size());
+        type_dt_dt_m.resize(types.size());
+        type_g.resize(types.size());
+        type_m.resize(types.size());
+
+        for (size_t t = 0; t < types.size(); t++) {
+            type_dt_m[t] = types[t].get_dt_m();
+            type_dt_dt_m[t] = types[t].get_dt_dt_m();
+            type_g[t] = types[t].get_G();
+            type_m[t] = types[t].get_mass();
+        }
+    }
+
     void Calculator::calculateOldF() {
-        for (Particle& p : *cont) {
+        load_type_constants();
+
+        const Vec<double>* g = type_g.data();
+        const auto particles = cont->begin();
+        const size_t n = cont->size();
+
+#pragma omp parallel for schedule(static)
+        for (size_t i = 0; i < n; i++) {
+            Particle& p = particles[i];
             p.setOldF(p.getF());
-            p.setF(cont->get_type_descriptor(p.getType()).get_G());
+            p.setF(g[p.getType()]);
         }
 
         SPDLOG_DEBUG("Updated the old force.");
     }
 
     void Calculator::calculateX() {
-        for (Particle& p : *cont) {
-            p.setX(p.getX() + env.get_delta_t() * p.getV() + cont->get_type_descriptor(p.getType()).get_dt_dt_m() * p.getF());
+        const auto no_op = [](Particle&) {};
+
+        if (env.get_dimensions() == 2) {
+            updateX<2, false>(no_op);
+        } else {
+            updateX<3, false>(no_op);
         }
 
         SPDLOG_DEBUG("Updated the positions.");
     }
 
     void Calculator::calculateF() {
-        cont->iterate_pairs([this](Particle& i, Particle& j) {
-            const double dist_squ = (i.getX() - j.getX()).len_squ();
+        // The container passes the displacement and the squared distance, which it computed for the cutoff test
+        cont->iterate_pairs([this](Particle& i, Particle& j, const Vec<double>& diff, const double dist_squ) {
             const double force = this->calculateFAbs(i, j, dist_squ);
 
             // Update the forces for both particles
-            i.setF(force * (j.getX() - i.getX()) + i.getF());
-            j.setF(force * (i.getX() - j.getX()) + j.getF());
+            i.setF(-force * diff + i.getF());
+            j.setF(force * diff + j.getF());
         });
 
         SPDLOG_DEBUG("Calculated the new force.");
     }
 
     void Calculator::calculateV() {
-        for (Particle& p : *cont) {
-            p.setV(p.getV() + cont->get_type_descriptor(p.getType()).get_dt_m() * (p.getOldF() + p.getF()));
-        }
+        integrateV([](Particle&) {});
 
         SPDLOG_DEBUG("Updated the velocities.");
     }
+
+    void Calculator::calculatePeriodicF(const std::array<bool, 3>& periodic) {
+        BoxContainer& box = dynamic_cast<BoxContainer&>(*cont);
+
+        // The traversal passes the displacement to the periodic image of the first particle, which it computed for the cutoff test
+        box.for_each_periodic_pair(
+            [this](Particle& p1, Particle& p2, const Vec<double>& arr, const double dist) {
+                const double force = this->calculateFAbs(p1, p2, dist);
+
+                // Update the forces for both particles
+                p1.setF(-force * arr + p1.getF());
+                p2.setF(force * arr + p2.getF());
+            },
+            periodic);
+
+        SPDLOG_DEBUG("Calculated the periodic forces.");
+    }
 }
@@ -8,8 +8,21 @@
 
 #include "Environment.h"
 #include "container/ParticleContainer.h"
+#include "utils/Threads.h"
 
+#include <array>
 #include <memory>
+#include <vector>
+
+// The floating point kernels shared by the stepper and the statically dispatched simulation are compiled exactly once and never inlined or cloned
+// into their callers. Otherwise the release mode (-Ofast) may contract or reassociate their operations differently in both paths
+#if defined(__GNUC__) && !defined(__clang__)
+#define SHARED_KERNEL __attribute__((noipa))
+#elif defined(__GNUC__)
+#define SHARED_KERNEL __attribute__((noinline))
+#else
+#define SHARED_KERNEL
+#endif
 
 /**
  * @brief Collection of calculators for different levels of complexity.
@@ -22,6 +35,84 @@ namespace physicsCalculator {
      * @brief The default class for an instance of a force calculator. It implements the leap frog method.
      */
     class Calculator {
+    private:
+        /**
+         * Store the delta_t / m of every particle type, such that the type descriptors are not read for every particle.
+         */
+        std::vector<double> type_dt_m;
+
+        /**
+         * Store the delta_t * delta_t * 0.5 / m of every particle type.
+         */
+        std::vector<double> type_dt_dt_m;
+
+        /**
+         * Store the gravity of every particle type.
+         */
+        std::vector<Vec<double>> type_g;
+
+        /**
+         * Store the mass of every particle type.
+         */
+        std::vector<double> type_m;
+
+        /**
+         * Store if the velocity update sums up the kinetic energy of the particles.
+         */
+        bool track_kinetic_energy = false;
+
+        /**
+         * Store the sum of m * v * v over all particles after the last velocity update, which tracked the kinetic energy.
+         */
+        double kinetic_energy = 0.0;
+
+        /**
+         * Copy the constants of the particle types into the flat type constant vectors.
+         */
+        void load_type_constants();
+
+        /**
+         * Update the position of all the particles in parallel and apply an operation to every particle afterwards. The number of dimensions is a
+         * template parameter, such that the z component is not updated in two dimensional simulations.
+         *
+         * @tparam Dim The number of simulated dimensions.
+         * @tparam Reset Move the forces into the old forces and reset the forces to the gravity within the same pass.
+         * @param post_x The operation applied to every particle after its position update.
+         */
+        template <size_t Dim, bool Reset, typename F> void updateX(const F& post_x);
+
+        /**
+         * Apply an operation to every particle and update its velocity afterwards in parallel. The number of dimensions is a template parameter,
+         * such that the z component is not updated in two dimensional simulations.
+         *
+         * @tparam Dim The number of simulated dimensions.
+         * @tparam Track Sum up the kinetic energy of the updated velocities within the same pass.
+         * @param post_f The operation applied to every particle before its velocity update.
+         */
+        template <size_t Dim, bool Track, typename F> void updateV(const F& post_f);
+
+        /**
+         * Update the position of a single particle. The update is a shared kernel of the integrator passes.
+         *
+         * @tparam Dim The number of simulated dimensions.
+         * @param p The particle which should be updated.
+         * @param delta_t The time step.
+         * @param dt_dt_m The delta_t * delta_t * 0.5 / m of the particle type.
+         */
+        template <size_t Dim> SHARED_KERNEL static void advance_x(Particle& p, const double delta_t, const double dt_dt_m);
+
+        /**
+         * Update the velocity of a single particle. The update is a shared kernel of the integrator passes.
+         *
+         * @tparam Dim The number of simulated dimensions.
+         * @param p The particle which should be updated.
+         * @param dt_m The delta_t / m of the particle type.
+         * @param m The mass of the particle type.
+         *
+         * @return The contribution m * v * v of the particle to the kinetic energy.
+         */
+        template <size_t Dim> SHARED_KERNEL static double advance_v(Particle& p, const double dt_m, const double m);
+
     protected:
         /**
          * Store the simulation environment used throughout the simulation.
@@ -86,7 +177,7 @@ namespace physicsCalculator {
         /**
          * Update the forces experienced by all the particles.
          */
-        void calculateF();
+        virtual void calculateF();
 
         /**
          * Update the old forces and set the current forces to 0.
@@ -94,15 +185,53 @@ namespace physicsCalculator {
         void calculateOldF();
 
         /**
-         * Update the position of all the particles.
+         * Update the position of all the particles. Two dimensional simulations keep the z coordinate fixed.
          */
         void calculateX();
 
         /**
-         * Update the velocity of all the particles.
+         * Update the velocity of all the particles. Two dimensional simulations keep the z velocity fixed.
          */
         void calculateV();
 
+        /**
+         * Add the forces between the particle pairs across the periodic boundaries of the linked cells. The pass is a shared kernel of the stepper
+         * and the statically dispatched simulation.
+         *
+         * @param periodic An array storing for every direction if the domain is periodic along it.
+         */
+        SHARED_KERNEL void calculatePeriodicF(const std::array<bool, 3>& periodic);
+
+        /**
+         * Update the positions of all the particles, apply an operation to every particle (e.g. the boundary conditions) and move the forces into
+         * the old forces, which are reset to the gravity. This fuses calculateX and calculateOldF into a single parallel pass over the particles.
+         *
+         * @param post_x The operation applied to every particle after its position update. It may only modify the particle itself.
+         */
+        template <typename F> void integrateX(const F& post_x);
+
+        /**
+         * Apply an operation to every particle (e.g. the boundary conditions) and update its velocity in a single parallel pass over the particles.
+         *
+         * @param post_f The operation applied to every particle before its velocity update. It may only modify the particle itself.
+         */
+        template <typename F> void integrateV(const F& post_f);
+
+        /**
+         * Set if the following velocity updates sum up the kinetic energy of the particles, e.g. for the next application of the thermostat. The
+         * sum is deterministic, but costs an additional pass over the blocks of particles.
+         *
+         * @param track Sum up the kinetic energy during the velocity updates.
+         */
+        inline void set_track_kinetic_energy(const bool track) { track_kinetic_energy = track; }
+
+        /**
+         * Get the sum of m * v * v over all particles of the container after the last velocity update tracking the kinetic energy.
+         *
+         * @return Twice the kinetic energy of the particles.
+         */
+        inline double get_kinetic_energy() const { return kinetic_energy; }
+
         /**
          * Get a reference to the particle container.
          *
@@ -117,4 +246,98 @@ namespace physicsCalculator {
          */
         const Environment& get_env() const;
     };
+
+    template <size_t Dim, bool Reset, typename F> inline void Calculator::updateX(const F& post_x) {
+        load_type_constants();
+
+        const double delta_t = env.get_delta_t();
+        const double* dt_dt_m = type_dt_dt_m.data();
+        const Vec<double>* g = type_g.data();
+        const auto particles = cont->begin();
+        const size_t n = cont->size();
+
+#pragma omp parallel for schedule(static)
+        for (size_t i = 0; i < n; i++) {
+            Particle& p = particles[i];
+            advance_x<Dim>(p, delta_t, dt_dt_m[p.getType()]);
+            post_x(p);
+
+            if constexpr (Reset) {
+                p.setOldF(p.getF());
+                p.setF(g[p.getType()]);
+            }
+        }
+    }
+
+    template <size_t Dim, bool Track, typename F> inline void Calculator::updateV(const F& post_f) {
+        load_type_constants();
+
+        const double* dt_m = type_dt_m.data();
+        const double* m = type_m.data();
+        const auto particles = cont->begin();
+        const size_t n = cont->size();
+
+        // Update a single particle and return its contribution to the kinetic energy
+        const auto update = [&](const size_t i) {
+            Particle& p = particles[i];
+            post_f(p);
+
+            return advance_v<Dim>(p, dt_m[p.getType()], m[p.getType()]);
+        };
+
+        if constexpr (Track) {
+            kinetic_energy = Threads::deterministic_sum(n, update);
+        } else {
+#pragma omp parallel for schedule(static)
+            for (size_t i = 0; i < n; i++) {
+                update(i);
+            }
+        }
+    }
+
+    template <size_t Dim> void Calculator::advance_x(Particle& p, const double delta_t, const double dt_dt_m) {
+        const Vec<double>& x = p.getX();
+        const Vec<double>& v = p.getV();
+        const Vec<double>& f = p.getF();
+
+        if constexpr (Dim == 3) {
+            p.setX(x + delta_t * v + dt_dt_m * f);
+        } else {
+            p.setX({ x[0] + delta_t * v[0] + dt_dt_m * f[0], x[1] + delta_t * v[1] + dt_dt_m * f[1], x[2] });
+        }
+    }
+
+    template <size_t Dim> double Calculator::advance_v(Particle& p, const double dt_m, const double m) {
+        const Vec<double>& v = p.getV();
+        const Vec<double>& old_f = p.getOldF();
+        const Vec<double>& f = p.getF();
+
+        if constexpr (Dim == 3) {
+            p.setV(v + dt_m * (old_f + f));
+        } else {
+            p.setV({ v[0] + dt_m * (old_f[0] + f[0]), v[1] + dt_m * (old_f[1] + f[1]), v[2] });
+        }
+
+        return m * p.getV().len_squ();
+    }
+
+    template <typename F> inline void Calculator::integrateX(const F& post_x) {
+        if (env.get_dimensions() == 2) {
+            updateX<2, true>(post_x);
+        } else {
+            updateX<3, true>(post_x);
+        }
+    }
+
+    template <typename F> inline void Calculator::integrateV(const F& post_f) {
+        if (env.get_dimensions() == 2 && track_kinetic_energy) {
+            updateV<2, true>(post_f);
+        } else if (env.get_dimensions() == 2) {
+            updateV<2, false>(post_f);
+        } else if (track_kinetic_energy) {
+            updateV<3, true>(post_f);
+        } else {
+            updateV<3, false>(post_f);
+        }
+    }
 } // namespace physicsCalculator
\ No newline at end of file
@@ -0,0 +1,114 @@
+#include "ForceTable.h"
+
+#include <cmath>
+
+namespace physicsCalculator {
+    ForceTable::ForceTable(const size_t new_types, const double r_min, const double r_max, const size_t new_intervals)
+        : types { new_types }
+        , intervals { new_intervals }
+        , r_squ_min { r_min * r_min }
+        , r_squ_max { r_max * r_max }
+        , coefficients(4 * new_types * new_types * new_intervals, 0.0) { }
+
+    void ForceTable::tabulate(const int t1, const int t2, const std::function<double(double)>& force) {
+        const double delta = (r_squ_max - r_squ_min) / static_cast<double>(intervals);
+
+        // The spline is built in the grid coordinate, such that the knots are the integers and the polynomials are evaluated at t in [0, 1]
+        std::vector<double> s(intervals + 1);
+        std::vector<double> y(intervals + 1);
+
+        for (size_t k = 0; k <= intervals; k++) {
+            s[k] = static_cast<double>(k);
+            y[k] = force(r_squ_min + static_cast<double>(k) * delta);
+        }
+
+        // Clamp the spline with one sided third order differences, the steep repulsion makes a natural spline inaccurate at the first point
+        const size_t n = intervals;
+        const double slopes[2] = {
+            (-11.0 * y[0] + 18.0 * y[1] - 9.0 * y[2] + 2.0 * y[3]) / 6.0,
+            (11.0 * y[n] - 18.0 * y[n - 1] + 9.0 * y[n - 2] - 2.0 * y[n - 3]) / 6.0,
+        };
+        const std::vector<double> m = spline_moments(s, y, slopes);
+
+        for (const auto& [a, b] : { std::pair { t1, t2 }, std::pair { t2, t1 } }) {
+            double* c = coefficients.data() + 4 * (a + types * b) * intervals;
+
+            for (size_t k = 0; k < intervals; k++) {
+                c[4 * k] = y[k];
+                c[4 * k + 1] = y[k + 1] - y[k] - (2.0 * m[k] + m[k + 1]) / 6.0;
+                c[4 * k + 2] = m[k] / 2.0;
+                c[4 * k + 3] = (m[k + 1] - m[k]) / 6.0;
+            }
+        }
+    }
+
+    void ForceTable::tabulate(const int t1, const int t2, const std::vector<double>& r, const std::vector<double>& force) {
+        const std::vector<double> m = spline_moments(r, force);
+
+        tabulate(t1, t2, [&](const double dist_squ) {
+            const double dist = std::sqrt(dist_squ);
+
+            if (dist > r.back()) {
+                return 0.0;
+            }
+
+            // Find the interval of the samples containing the distance, distances below the first sample are clamped
+            const size_t k = std::upper_bound(r.begin(), r.end() - 1, dist) - r.begin();
+            const size_t i = k == 0 ? 0 : k - 1;
+            const double h = r[i + 1] - r[i];
+            const double t = std::max(dist - r[i], 0.0);
+            const double f = force[i] + t * ((force[i + 1] - force[i]) / h - h * (2.0 * m[i] + m[i + 1]) / 6.0) + t * t * m[i] / 2.0
+                + t * t * t * (m[i + 1] - m[i]) / (6.0 * h);
+
+            // Convert the repulsive force into the force divided by the distance of calculateFDist
+            return -f / std::max(dist, r.front());
+        });
+    }
+
+    ForceTable::View ForceTable::view() const {
+        return View { coefficients.data(), types, intervals, r_squ_min, r_squ_max, static_cast<double>(intervals) / (r_squ_max - r_squ_min) };
+    }
+
+    std::vector<double> ForceTable::spline_moments(const std::vector<double>& x, const std::vector<double>& y, const double* slopes) {
+        const size_t n = x.size();
+
+        // Set up the tridiagonal system of the second derivatives, the first and last row either clamp the slopes or set the moments to zero
+        std::vector<double> lower(n, 0.0), diag(n, 1.0), upper(n, 0.0), rhs(n, 0.0);
+
+        for (size_t k = 1; k + 1 < n; k++) {
+            const double h_l = x[k] - x[k - 1];
+            const double h_r = x[k + 1] - x[k];
+            lower[k] = h_l;
+            diag[k] = 2.0 * (h_l + h_r);
+            upper[k] = h_r;
+            rhs[k] = 6.0 * ((y[k + 1] - y[k]) / h_r - (y[k] - y[k - 1]) / h_l);
+        }
+
+        if (slopes != nullptr) {
+            const double h_first = x[1] - x[0];
+            const double h_last = x[n - 1] - x[n - 2];
+            diag[0] = 2.0 * h_first;
+            upper[0] = h_first;
+            rhs[0] = 6.0 * ((y[1] - y[0]) / h_first - slopes[0]);
+            lower[n - 1] = h_last;
+            diag[n - 1] = 2.0 * h_last;
+            rhs[n - 1] = 6.0 * (slopes[1] - (y[n - 1] - y[n - 2]) / h_last);
+        }
+
+        // Eliminate the lower diagonal and substitute backwards
+        for (size_t k = 1; k < n; k++) {
+            const double factor = lower[k] / diag[k - 1];
+            diag[k] -= factor * upper[k - 1];
+            rhs[k] -= factor * rhs[k - 1];
+        }
+
+        std::vector<double> m(n);
+        m[n - 1] = rhs[n - 1] / diag[n - 1];
+
+        for (size_t k = n - 1; k-- > 0;) {
+            m[k] = (rhs[k] - upper[k] * m[k + 1]) / diag[k];
+        }
+
+        return m;
+    }
+} // namespace physicsCalculator
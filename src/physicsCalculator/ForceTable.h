@@ -0,0 +1,179 @@
+/**
+ * @file
+ *
+ * @brief Stores the forces of the type pairs as cubic splines over the squared distance
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace physicsCalculator {
+
+    /**
+     * @class ForceTable
+     *
+     * @brief Class storing the force absolute divided by the distance of every type pair as a cubic spline on a uniform grid of squared
+     * distances. Evaluating the spline neither requires a square root nor a division, such that every tabulated pair potential costs the same.
+     */
+    class ForceTable {
+    public:
+        /**
+         * @struct View
+         *
+         * @brief Reference the spline coefficients of a table, such that the kernels can capture the table by value.
+         */
+        struct View {
+            /**
+             * Store the four polynomial coefficients of every interval of every type pair.
+             */
+            const double* coefficients;
+
+            /**
+             * Store the number of particle types.
+             */
+            size_t types;
+
+            /**
+             * Store the number of intervals of the grid.
+             */
+            size_t intervals;
+
+            /**
+             * Store the smallest squared distance of the grid.
+             */
+            double r_squ_min;
+
+            /**
+             * Store the largest squared distance of the grid, beyond which the forces vanish.
+             */
+            double r_squ_max;
+
+            /**
+             * Store the number of intervals per unit of the squared distance.
+             */
+            double inv_delta;
+
+            /**
+             * Get the force absolute divided by the distance of a type pair. Distances below the grid are clamped to its first point, the forces
+             * vanish beyond the grid. The function is free of branches, such that it can be inlined into the vectorized kernels.
+             *
+             * @tparam Real The floating point type of the evaluation, the coefficients are stored in double precision.
+             *
+             * @param t1 The type of the first particle.
+             * @param t2 The type of the second particle.
+             * @param dist_squ The squared distance between two particles.
+             *
+             * @return The force absolute divided by the distance.
+             */
+            template <typename Real> inline Real force(const int t1, const int t2, const Real dist_squ) const {
+                const Real s = std::min(std::max((dist_squ - static_cast<Real>(r_squ_min)) * static_cast<Real>(inv_delta), Real(0)),
+                    static_cast<Real>(intervals));
+                const int k = std::min(static_cast<int>(s), static_cast<int>(intervals) - 1);
+                const Real t = s - static_cast<Real>(k);
+                const double* c = coefficients + 4 * ((t1 + types * t2) * intervals + k);
+                const Real value = static_cast<Real>(c[0])
+                    + t * (static_cast<Real>(c[1]) + t * (static_cast<Real>(c[2]) + t * static_cast<Real>(c[3])));
+
+                return dist_squ < static_cast<Real>(r_squ_max) ? value : Real(0);
+            }
+        };
+
+        /**
+         * Store the number of grid intervals per type pair used by default, the coefficients of a type pair fill 32 KiB.
+         */
+        static constexpr size_t default_intervals = 1024;
+
+    private:
+        /**
+         * Store the number of particle types.
+         */
+        size_t types;
+
+        /**
+         * Store the number of intervals of the grid.
+         */
+        size_t intervals;
+
+        /**
+         * Store the smallest squared distance of the grid.
+         */
+        double r_squ_min;
+
+        /**
+         * Store the largest squared distance of the grid.
+         */
+        double r_squ_max;
+
+        /**
+         * Store the four polynomial coefficients of every interval of every type pair, the pair of the types t1 and t2 starts at the interval
+         * (t1 + types * t2) * intervals.
+         */
+        std::vector<double> coefficients;
+
+    public:
+        /**
+         * Create a table of vanishing forces for all type pairs.
+         *
+         * @param new_types The number of particle types.
+         * @param r_min The smallest distance of the grid, which must be strictly positive.
+         * @param r_max The largest distance of the grid, usually the cutoff radius.
+         * @param new_intervals The number of grid intervals, which must be at least three.
+         */
+        ForceTable(const size_t new_types, const double r_min, const double r_max, const size_t new_intervals = default_intervals);
+
+        /**
+         * Tabulate the force of a type pair by sampling a function at the grid points. The pair is stored for both orders of its types.
+         *
+         * @param t1 The type of the first particle.
+         * @param t2 The type of the second particle.
+         * @param force The force absolute divided by the distance as a function of the squared distance, using the sign of calculateFDist.
+         */
+        void tabulate(const int t1, const int t2, const std::function<double(double)>& force);
+
+        /**
+         * Tabulate the force of a type pair from samples of the force at increasing distances, e.g. read from a table file. The samples are
+         * interpolated by a natural cubic spline in the distance. Below the first sample the force of the first sample is used, beyond the last
+         * sample the force vanishes.
+         *
+         * @param t1 The type of the first particle.
+         * @param t2 The type of the second particle.
+         * @param r The strictly increasing distances of the samples, at least two.
+         * @param force The force -dU/dr at the distances, positive forces are repulsive.
+         */
+        void tabulate(const int t1, const int t2, const std::vector<double>& r, const std::vector<double>& force);
+
+        /**
+         * Get a view of the table, which the kernels capture by value. The view is invalidated by tabulating a type pair.
+         *
+         * @return The view of the table.
+         */
+        View view() const;
+
+        /**
+         * Get the force absolute divided by the distance of a type pair.
+         *
+         * @param t1 The type of the first particle.
+         * @param t2 The type of the second particle.
+         * @param dist_squ The squared distance between two particles.
+         *
+         * @return The force absolute divided by the distance.
+         */
+        inline double evaluate(const int t1, const int t2, const double dist_squ) const { return view().force(t1, t2, dist_squ); }
+
+        /**
+         * Compute the second derivatives of the cubic spline through the given knots by solving the tridiagonal system of the spline. The spline
+         * is natural, unless the slopes at both ends are given.
+         *
+         * @param x The strictly increasing positions of the knots, at least two.
+         * @param y The values at the knots.
+         * @param slopes The slopes at the first and the last knot or a null pointer.
+         *
+         * @return The second derivatives at the knots.
+         */
+        static std::vector<double> spline_moments(const std::vector<double>& x, const std::vector<double>& y, const double* slopes = nullptr);
+    };
+} // namespace physicsCalculator
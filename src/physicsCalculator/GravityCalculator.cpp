@@ -3,6 +3,7 @@
 #include <spdlog/spdlog.h>
 
 #include "container/DSContainer.h"
+#include "utils/Threads.h"
 
 namespace physicsCalculator {
     GravityCalculator::GravityCalculator(const Environment& new_env, const std::shared_ptr<ParticleContainer>& new_cont)
@@ -36,8 +37,70 @@ namespace physicsCalculator {
     GravityCalculator::~GravityCalculator() = default;
 
     double GravityCalculator::calculateFDist(const double dist_squ, const int t1, const int t2) const {
-        const double dist = std::sqrt(dist_squ);
-        return cont->get_type_pair_descriptor(t1, t2).get_mass() / (dist_squ * dist);
+        return calculateFPair(dist_squ, cont->get_type_pair_descriptor(t1, t2).get_mass());
+    }
+
+    void GravityCalculator::calculateF() {
+        DSContainer* ds = dynamic_cast<DSContainer*>(cont.get());
+
+        if (ds == nullptr) {
+            Calculator::calculateF();
+            return;
+        }
+
+        ParticleSoA& soa = cont->load_soa();
+        const size_t n = soa.size();
+        const size_t types = cont->get_types().size();
+        const double* x = soa.x.data();
+        const double* y = soa.y.data();
+        const double* z = soa.z.data();
+        const int* type = soa.type.data();
+
+        // Copy the mass products of the type pairs into a flat array, which the vectorized kernel can gather from
+        std::vector<double> mass(types * types);
+
+        for (size_t t = 0; t < types * types; t++) {
+            mass[t] = cont->get_type_pair_descriptor(static_cast<int>(t % types), static_cast<int>(t / types)).get_mass();
+        }
+
+#pragma omp parallel
+        {
+            soa.allocate_buffers();
+
+            double* f_x = soa.clear_buffer(Threads::get_thread_num());
+            double* f_y = f_x + n;
+            double* f_z = f_x + 2 * n;
+
+            ds->for_each_tile_pair([&](const size_t i, const size_t first, const size_t last) {
+                double f_x_i = 0.0, f_y_i = 0.0, f_z_i = 0.0;
+
+                // The force on particle i is accumulated in registers, the forces on the particles j are written to distinct elements
+#pragma omp simd reduction(+ : f_x_i, f_y_i, f_z_i)
+                for (size_t j = first; j < last; j++) {
+                    const double d_x = x[j] - x[i];
+                    const double d_y = y[j] - y[i];
+                    const double d_z = z[j] - z[i];
+                    const double force = calculateFPair(d_x * d_x + d_y * d_y + d_z * d_z, mass[type[i] + types * type[j]]);
+
+                    f_x_i += force * d_x;
+                    f_y_i += force * d_y;
+                    f_z_i += force * d_z;
+                    f_x[j] -= force * d_x;
+                    f_y[j] -= force * d_y;
+                    f_z[j] -= force * d_z;
+                }
+
+                f_x[i] += f_x_i;
+                f_y[i] += f_y_i;
+                f_z[i] += f_z_i;
+            });
+
+            soa.reduce_buffers();
+        }
+
+        cont->store_soa_forces();
+
+        SPDLOG_DEBUG("Calculated the new force.");
     }
 
     double GravityCalculator::calculateFAbs(const Particle& p1, const Particle& p2, const double dist_squ) {
@@ -11,6 +11,8 @@
 #include "container/ParticleContainer.h"
 #include "utils/Vec.h"
 
+#include <cmath>
+
 namespace physicsCalculator {
 
     /**
@@ -68,5 +70,27 @@ namespace physicsCalculator {
          * @return The force interacting between p1 and p2.
          */
         virtual double calculateFDist(const double dist_squ, const int t1, const int t2) const;
+
+        /**
+         * Update the forces experienced by all the particles. The direct sum container is traversed in tiles, which are distributed among the
+         * threads. Every thread accumulates into its own force buffer and the inner loop over the particles of a tile is vectorized. Other
+         * containers use the generic pair iteration.
+         */
+        virtual void calculateF();
+
+    private:
+        /**
+         * Get the force absolute divided by the distance for the mass product of a type pair. The function is inlined into the vectorized kernel.
+         *
+         * @param dist_squ The squared distance between two particles.
+         * @param mass The mass product of the type pair.
+         *
+         * @return The force absolute divided by the distance.
+         */
+        static inline double calculateFPair(const double dist_squ, const double mass) {
+            // The reciprocal square root is computed once and cubed, which the compiler maps to the vectorized approximation
+            const double inv_dist = 1.0 / std::sqrt(dist_squ);
+            return mass * inv_dist * inv_dist * inv_dist;
+        }
     };
 } // namespace physicsCalculator
\ No newline at end of file
@@ -1,15 +1,43 @@
 #include "LJCalculator.h"
 
+#include <algorithm>
+#include <array>
+#include <limits>
 #include <spdlog/spdlog.h>
+#include <type_traits>
 
 #include "container/BoxContainer.h"
 #include "container/DSContainer.h"
+#include "utils/Threads.h"
+
+// Compile the batch kernels for several instruction sets, the dynamic loader chooses the widest one supported by the cpu. Other compilers and
+// platforms compile a single version for the target of the build
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 12 && defined(__x86_64__) && defined(__ELF__)
+#define LJ_TARGET_CLONES __attribute__((target_clones("arch=x86-64-v4", "arch=x86-64-v3", "default")))
+#else
+#define LJ_TARGET_CLONES
+#endif
 
 namespace physicsCalculator {
-    LJCalculator::LJCalculator(const Environment& new_env, const std::shared_ptr<ParticleContainer>& new_cont)
+    /**
+     * Combine a pair kernel and a batch kernel into a single iterator, such that every traversal can choose the form it supports.
+     */
+    template <typename Pair, typename Batch> struct CombinedKernel : Pair, Batch {
+        using Pair::operator();
+        using Batch::operator();
+    };
+
+    /**
+     * Deduce the types of the combined kernel from the pair kernel and the batch kernel.
+     */
+    template <typename Pair, typename Batch> CombinedKernel(Pair, Batch) -> CombinedKernel<Pair, Batch>;
+
+    LJCalculator::LJCalculator(const Environment& new_env, const std::shared_ptr<ParticleContainer>& new_cont, const bool init_forces)
         : Calculator { new_env, new_cont } {
         // Initialize the forces
-        calculateF();
+        if (init_forces) {
+            calculateF();
+        }
     }
 
     LJCalculator::LJCalculator(const Environment& new_env, const std::vector<Particle>& particles, const std::vector<TypeDesc>& new_desc,
@@ -20,7 +48,8 @@ namespace physicsCalculator {
         if (is_infinite) {
             cont = std::make_shared<DSContainer>(particles, env.get_domain_size(), new_desc);
         } else {
-            cont = std::make_shared<BoxContainer>(particles, env.get_r_cutoff(), env.get_domain_size(), new_desc);
+            cont = std::make_shared<BoxContainer>(particles, env.get_r_cutoff(), env.get_domain_size(), new_desc, env.get_skin(), env.get_reorder(),
+                env.get_sub_cells(), env.get_dimensions(), env.get_cell_tasks(), env.get_balance());
         }
 
         // Initialize the forces
@@ -37,10 +66,322 @@ namespace physicsCalculator {
     }
 
     double LJCalculator::calculateFDist(const double dist_squ, const int t1, const int t2) const {
-        // Calculate the powers of (sigma / distance)
-        const double term_to_2 = (cont->get_type_pair_descriptor(t1, t2).get_sigma_squared() / (dist_squ));
-        const double term_to_6 = term_to_2 * term_to_2 * term_to_2;
+        const TypePairDesc& pair = cont->get_type_pair_descriptor(t1, t2);
+        return calculateFPair(dist_squ, pair.get_sigma_squared(), pair.get_scaled_epsilon());
+    }
+
+    const char* LJCalculator::get_simd_target() {
+#if defined(__GNUC__) && defined(__x86_64__)
+        if (__builtin_cpu_supports("avx512f")) {
+            return "x86-64-v4";
+        } else if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+            return "x86-64-v3";
+        }
+#endif
+
+        return "scalar";
+    }
+
+    void LJCalculator::load_pair_tables() {
+        const size_t types = cont->get_types().size();
+
+        pair_sigma_squ.resize(types * types);
+        pair_scaled_epsilon.resize(types * types);
+
+        for (size_t t = 0; t < types * types; t++) {
+            const TypePairDesc& pair = cont->get_type_pair_descriptor(static_cast<int>(t % types), static_cast<int>(t / types));
+            pair_sigma_squ[t] = pair.get_sigma_squared();
+            pair_scaled_epsilon[t] = pair.get_scaled_epsilon();
+        }
+    }
+
+    template <size_t Types> LJCalculator::PackedPairTable<Types> LJCalculator::load_packed_table() const {
+        const size_t types = cont->get_types().size();
+        PackedPairTable<Types> table {};
+
+        for (size_t t1 = 0; t1 < types; t1++) {
+            for (size_t t2 = 0; t2 < types; t2++) {
+                const TypePairDesc& pair = cont->get_type_pair_descriptor(static_cast<int>(t1), static_cast<int>(t2));
+                table.sigma_squ[table.index(t1, t2)] = pair.get_sigma_squared();
+                table.scaled_epsilon[table.index(t1, t2)] = pair.get_scaled_epsilon();
+            }
+        }
+
+        return table;
+    }
 
-        return (cont->get_type_pair_descriptor(t1, t2).get_scaled_epsilon() / (dist_squ)) * std::fma(-2.0 * term_to_6, term_to_6, term_to_6);
+    template <size_t Dim, typename Real, typename Table>
+    inline void LJCalculator::calculateFBatch(const BatchData<Real, Table>& data, const size_t i, const size_t* batch, const size_t count) {
+        const Real x_i = data.x[i];
+        const Real y_i = data.y[i];
+        const Real z_i = data.z[i];
+        const int type_i = data.type[i];
+        double f_x_i = 0.0, f_y_i = 0.0, f_z_i = 0.0;
+
+        // Accumulate the force on particle i in registers, while the forces on the other particles are scattered to distinct elements. The
+        // reduction uses local sums, a reduction into the captured references is not vectorized
+        const auto interact = [&](const size_t* indices, const size_t size, const Real cutoff_squ) {
+            double sum_x = 0.0, sum_y = 0.0, sum_z = 0.0;
+
+#pragma omp simd reduction(+ : sum_x, sum_y, sum_z)
+            for (size_t k = 0; k < size; k++) {
+                const size_t j = indices[k];
+                const Real d_x = data.x[j] - x_i;
+                const Real d_y = data.y[j] - y_i;
+                const Real d_z = Dim == 3 ? data.z[j] - z_i : Real(0);
+                const Real dist_squ = d_x * d_x + d_y * d_y + d_z * d_z;
+
+                // The pairs beyond the cutoff distance are masked out instead of branching
+                const Real force = dist_squ <= cutoff_squ ? data.table.force(type_i, data.type[j], dist_squ) : Real(0);
+
+                sum_x += force * d_x;
+                sum_y += force * d_y;
+                data.f_x[j] -= force * d_x;
+                data.f_y[j] -= force * d_y;
+
+                if constexpr (Dim == 3) {
+                    sum_z += force * d_z;
+                    data.f_z[j] -= force * d_z;
+                }
+            }
+
+            f_x_i += sum_x;
+            f_y_i += sum_y;
+            f_z_i += sum_z;
+        };
+
+        for (size_t first = 0; first < count; first += batch_chunk) {
+            const size_t size = std::min(batch_chunk, count - first);
+            const size_t* chunk = batch + first;
+            Real dist_squ[batch_chunk];
+
+#pragma omp simd
+            for (size_t k = 0; k < size; k++) {
+                const size_t j = chunk[k];
+                const Real d_x = data.x[j] - x_i;
+                const Real d_y = data.y[j] - y_i;
+                const Real d_z = Dim == 3 ? data.z[j] - z_i : Real(0);
+                dist_squ[k] = d_x * d_x + d_y * d_y + d_z * d_z;
+            }
+
+            // Compact the candidates within the cutoff distance without branching
+            size_t near[batch_chunk];
+            size_t near_count = 0;
+
+            for (size_t k = 0; k < size; k++) {
+                near[near_count] = chunk[k];
+                near_count += dist_squ[k] <= data.rc_squ;
+            }
+
+            // Dense chunks (e.g. of verlet lists) are computed with a mask, sparse chunks (e.g. of linked cells) only compute the compacted pairs
+            if (2 * near_count >= size) {
+                interact(chunk, size, data.rc_squ);
+            } else {
+                interact(near, near_count, std::numeric_limits<Real>::infinity());
+            }
+        }
+
+        data.f_x[i] += f_x_i;
+        data.f_y[i] += f_y_i;
+
+        if constexpr (Dim == 3) {
+            data.f_z[i] += f_z_i;
+        }
+    }
+
+    template <typename Real, typename Table>
+    LJ_TARGET_CLONES void LJCalculator::calculateFBatch2D(
+        const BatchData<Real, Table>& data, const size_t i, const size_t* batch, const size_t count) {
+        calculateFBatch<2>(data, i, batch, count);
+    }
+
+    template <typename Real, typename Table>
+    LJ_TARGET_CLONES void LJCalculator::calculateFBatch3D(
+        const BatchData<Real, Table>& data, const size_t i, const size_t* batch, const size_t count) {
+        calculateFBatch<3>(data, i, batch, count);
+    }
+
+    void LJCalculator::calculateF() {
+        BoxContainer* box = dynamic_cast<BoxContainer*>(cont.get());
+        DSContainer* ds = dynamic_cast<DSContainer*>(cont.get());
+
+        if (box == nullptr && ds == nullptr) {
+            Calculator::calculateF();
+            return;
+        }
+
+        // The mixed precision mode computes the pair forces in single precision, the forces are accumulated in double precision
+        const bool mixed_precision = env.get_precision() == MIXED_PRECISION;
+
+        const auto calculate = [this, box, ds, mixed_precision](const auto& table) {
+            if (env.get_dimensions() == 2 && mixed_precision) {
+                calculateFSoA<2, float>(box, ds, table);
+            } else if (env.get_dimensions() == 2) {
+                calculateFSoA<2, double>(box, ds, table);
+            } else if (mixed_precision) {
+                calculateFSoA<3, float>(box, ds, table);
+            } else {
+                calculateFSoA<3, double>(box, ds, table);
+            }
+        };
+
+        // Choose the kernel by the number of types, the parameters of a single type are kept in registers and those of a few types in a small
+        // table, which is indexed with a constant stride
+        const size_t types = cont->get_types().size();
+
+        if (force_table != nullptr) {
+            calculate(force_table->view());
+        } else if (types == 1) {
+            calculate(load_packed_table<1>());
+        } else if (types <= packed_types) {
+            calculate(load_packed_table<packed_types>());
+        } else {
+            load_pair_tables();
+            calculate(PairTable { pair_sigma_squ.data(), pair_scaled_epsilon.data(), types });
+        }
+
+        SPDLOG_DEBUG("Calculated the new force.");
+    }
+
+    template <size_t Dim, typename Real, typename Table>
+    void LJCalculator::calculateFSoA(BoxContainer* box, DSContainer* ds, const Table& table) {
+        // The direct sum has no cutoff distance
+        const Real rc_squ = box != nullptr ? static_cast<Real>(box->getRC() * box->getRC()) : std::numeric_limits<Real>::infinity();
+
+        ParticleSoA& soa = cont->load_soa(std::is_same_v<Real, float>);
+        const size_t n = soa.size();
+        const std::array<const Real*, 3> positions = soa.get_positions<Real>();
+        const Real* x = positions[0];
+        const Real* y = positions[1];
+        const Real* z = positions[2];
+        const int* type = soa.type.data();
+
+        // Create the kernel accumulating the forces into the given arrays, atomically if the tag is true. The table is captured by value, such
+        // that its parameters are not reloaded through the container for every pair
+        const auto make_kernel = [x, y, z, type, rc_squ, &table](double* f_x, double* f_y, double* f_z, auto atomic) {
+            return [x, y, z, type, rc_squ, table, f_x, f_y, f_z](const size_t i, const size_t j) {
+                const Real d_x = x[j] - x[i];
+                const Real d_y = y[j] - y[i];
+                const Real d_z = Dim == 3 ? z[j] - z[i] : Real(0);
+                const Real dist_squ = d_x * d_x + d_y * d_y + d_z * d_z;
+
+                if (dist_squ > rc_squ) {
+                    return;
+                }
+
+                const Real force = table.force(type[i], type[j], dist_squ);
+
+                if constexpr (decltype(atomic)::value) {
+                    Threads::atomic_add(f_x[i], force * d_x);
+                    Threads::atomic_add(f_y[i], force * d_y);
+                    Threads::atomic_add(f_x[j], -force * d_x);
+                    Threads::atomic_add(f_y[j], -force * d_y);
+
+                    if constexpr (Dim == 3) {
+                        Threads::atomic_add(f_z[i], force * d_z);
+                        Threads::atomic_add(f_z[j], -force * d_z);
+                    }
+
+                    return;
+                }
+
+                // Update the forces for both particles, the z components vanish in two dimensions
+                f_x[i] += force * d_x;
+                f_y[i] += force * d_y;
+                f_x[j] -= force * d_x;
+                f_y[j] -= force * d_y;
+
+                if constexpr (Dim == 3) {
+                    f_z[i] += force * d_z;
+                    f_z[j] -= force * d_z;
+                }
+            };
+        };
+
+        // Extend the kernel by the batch kernel, which the linked cells and the verlet lists pass every particle with its neighbor candidates to
+        const auto make_batched_kernel = [&](double* f_x, double* f_y, double* f_z) {
+            const BatchData<Real, Table> data { x, y, z, type, table, rc_squ, f_x, f_y, f_z };
+            const auto batch_kernel = [data](const size_t i, const size_t* first, const size_t* last) {
+                if constexpr (Dim == 3) {
+                    calculateFBatch3D(data, i, first, last - first);
+                } else {
+                    calculateFBatch2D(data, i, first, last - first);
+                }
+            };
+
+            return CombinedKernel { make_kernel(f_x, f_y, f_z, std::false_type {}), batch_kernel };
+        };
+
+        if (box == nullptr) {
+            calculateFTiles<Dim, Real>(*ds, soa, table);
+        } else if (env.get_parallel_strategy() == REDUCTION) {
+#pragma omp parallel
+            {
+                soa.allocate_buffers();
+
+                // Every thread accumulates into its own buffer, the buffers are added up after all threads finished their pairs
+                double* buffer = soa.clear_buffer(Threads::get_thread_num());
+                box->for_each_distributed_candidate_pair(make_batched_kernel(buffer, buffer + n, buffer + 2 * n));
+                soa.reduce_buffers();
+            }
+        } else if (env.get_parallel_strategy() == ATOMIC) {
+            // Every thread adds both forces of its pairs directly to the shared forces, such that neither colors nor buffers are needed
+            const auto kernel = make_kernel(soa.f_x.data(), soa.f_y.data(), soa.f_z.data(), std::true_type {});
+
+#pragma omp parallel
+            box->for_each_distributed_candidate_pair(kernel);
+        } else {
+            box->for_each_colored_candidate_pair(make_batched_kernel(soa.f_x.data(), soa.f_y.data(), soa.f_z.data()));
+        }
+
+        cont->store_soa_forces();
+    }
+
+    template <size_t Dim, typename Real, typename Table>
+    void LJCalculator::calculateFTiles(DSContainer& ds, ParticleSoA& soa, const Table& table) {
+        const size_t n = soa.size();
+        const std::array<const Real*, 3> positions = soa.get_positions<Real>();
+        const Real* x = positions[0];
+        const Real* y = positions[1];
+        const Real* z = positions[2];
+        const int* type = soa.type.data();
+
+#pragma omp parallel
+        {
+            soa.allocate_buffers();
+
+            double* f_x = soa.clear_buffer(Threads::get_thread_num());
+            double* f_y = f_x + n;
+            double* f_z = f_x + 2 * n;
+
+            ds.for_each_tile_pair([&](const size_t i, const size_t first, const size_t last) {
+                double f_x_i = 0.0, f_y_i = 0.0, f_z_i = 0.0;
+
+                // The force on particle i is accumulated in registers, the forces on the particles j are written to distinct elements
+#pragma omp simd reduction(+ : f_x_i, f_y_i, f_z_i)
+                for (size_t j = first; j < last; j++) {
+                    const Real d_x = x[j] - x[i];
+                    const Real d_y = y[j] - y[i];
+                    const Real d_z = Dim == 3 ? z[j] - z[i] : Real(0);
+                    const Real force = table.force(type[i], type[j], d_x * d_x + d_y * d_y + d_z * d_z);
+
+                    f_x_i += force * d_x;
+                    f_y_i += force * d_y;
+                    f_x[j] -= force * d_x;
+                    f_y[j] -= force * d_y;
+
+                    if constexpr (Dim == 3) {
+                        f_z_i += force * d_z;
+                        f_z[j] -= force * d_z;
+                    }
+                }
+
+                f_x[i] += f_x_i;
+                f_y[i] += f_y_i;
+                f_z[i] += f_z_i;
+            });
+
+            soa.reduce_buffers();
+        }
     }
 } // namespace physicsCalculator
@@ -8,9 +8,16 @@
 
 #include "Calculator.h"
 #include "Environment.h"
+#include "ForceTable.h"
 #include "container/ParticleContainer.h"
 #include "utils/Vec.h"
 
+#include <cmath>
+#include <vector>
+
+class BoxContainer;
+class DSContainer;
+
 namespace physicsCalculator {
 
     /**
@@ -19,6 +26,162 @@ namespace physicsCalculator {
      * @brief Class corresponding to a leap frog integrator using Lenard Jones potentials.
      */
     class LJCalculator : public Calculator {
+    private:
+        /**
+         * Store the number of particle types up to which the kernels read the type pairs from a small table of fixed size.
+         */
+        static constexpr size_t packed_types = 4;
+
+        /**
+         * @struct PackedPairTable
+         *
+         * @brief Store the parameters of the type pairs of at most Types types in a table of fixed size, which is captured by value by the kernels.
+         * A table of a single type ignores the types of the particles, such that its parameters are kept in registers.
+         *
+         * @tparam Types The maximum number of particle types.
+         */
+        template <size_t Types> struct PackedPairTable {
+            /**
+             * Store the squared sigma of every type pair.
+             */
+            double sigma_squ[Types * Types];
+
+            /**
+             * Store the scaled epsilon of every type pair.
+             */
+            double scaled_epsilon[Types * Types];
+
+            /**
+             * Get the index of a type pair in the table.
+             *
+             * @param t1 The type of the first particle.
+             * @param t2 The type of the second particle.
+             *
+             * @return The index of the type pair.
+             */
+            inline size_t index(const int t1, const int t2) const { return Types == 1 ? 0 : t1 + Types * t2; }
+
+            /**
+             * Get the force absolute divided by the distance of a type pair.
+             *
+             * @tparam Real The floating point type of the evaluation.
+             *
+             * @param t1 The type of the first particle.
+             * @param t2 The type of the second particle.
+             * @param dist_squ The squared distance between two particles.
+             *
+             * @return The force absolute divided by the distance.
+             */
+            template <typename Real> inline Real force(const int t1, const int t2, const Real dist_squ) const {
+                return calculateFPair<Real>(
+                    dist_squ, static_cast<Real>(sigma_squ[index(t1, t2)]), static_cast<Real>(scaled_epsilon[index(t1, t2)]));
+            }
+        };
+
+        /**
+         * @struct PairTable
+         *
+         * @brief Reference the parameters of the type pairs of an arbitrary number of types, which are stored in the flat pair arrays.
+         */
+        struct PairTable {
+            /**
+             * Store the squared sigma of every type pair.
+             */
+            const double* sigma_squ;
+
+            /**
+             * Store the scaled epsilon of every type pair.
+             */
+            const double* scaled_epsilon;
+
+            /**
+             * Store the number of particle types.
+             */
+            size_t types;
+
+            /**
+             * Get the index of a type pair in the table.
+             *
+             * @param t1 The type of the first particle.
+             * @param t2 The type of the second particle.
+             *
+             * @return The index of the type pair.
+             */
+            inline size_t index(const int t1, const int t2) const { return t1 + types * t2; }
+
+            /**
+             * Get the force absolute divided by the distance of a type pair.
+             *
+             * @tparam Real The floating point type of the evaluation.
+             *
+             * @param t1 The type of the first particle.
+             * @param t2 The type of the second particle.
+             * @param dist_squ The squared distance between two particles.
+             *
+             * @return The force absolute divided by the distance.
+             */
+            template <typename Real> inline Real force(const int t1, const int t2, const Real dist_squ) const {
+                return calculateFPair<Real>(
+                    dist_squ, static_cast<Real>(sigma_squ[index(t1, t2)]), static_cast<Real>(scaled_epsilon[index(t1, t2)]));
+            }
+        };
+
+        /**
+         * @struct BatchData
+         *
+         * @brief Define the arrays and constants the batch kernel reads from and accumulates into.
+         *
+         * @tparam Real The floating point type of the positions and the pair math.
+         * @tparam Table The type of the table providing the forces of the type pairs.
+         */
+        template <typename Real, typename Table> struct BatchData {
+            /**
+             * Store the positions of the particles.
+             */
+            const Real *x, *y, *z;
+
+            /**
+             * Store the types of the particles.
+             */
+            const int* type;
+
+            /**
+             * Store the forces of the type pairs.
+             */
+            Table table;
+
+            /**
+             * Store the squared cutoff distance.
+             */
+            Real rc_squ;
+
+            /**
+             * Store the force arrays the batch kernel accumulates into, the forces are always accumulated in double precision.
+             */
+            double *f_x, *f_y, *f_z;
+        };
+
+        /**
+         * Store the number of candidates of a batch, whose distances are computed before the forces of the chunk are computed.
+         */
+        static constexpr size_t batch_chunk = 64;
+
+        /**
+         * Store the squared sigma of every type pair in a flat array.
+         */
+        std::vector<double> pair_sigma_squ;
+
+        /**
+         * Store the scaled epsilon of every type pair in a flat array.
+         */
+        std::vector<double> pair_scaled_epsilon;
+
+    protected:
+        /**
+         * Store the tabulated forces of the type pairs, which replace the Lenard-Jones forces in the kernels if set (e.g. by the tabulated
+         * calculator).
+         */
+        std::unique_ptr<ForceTable> force_table;
 
     public:
         /**
@@ -26,8 +189,9 @@ namespace physicsCalculator {
          *
          * @param new_env The simulation environment that should be used for initialization.
          * @param new_cont The container storing the particles that should be used throughout the simulation.
+         * @param init_forces Define wether the forces should be initialized.
          */
-        LJCalculator(const Environment& new_env, const std::shared_ptr<ParticleContainer>& new_cont);
+        LJCalculator(const Environment& new_env, const std::shared_ptr<ParticleContainer>& new_cont, const bool init_forces = true);
 
         /**
          * Provide a constructor that allows the construction of a calculator using a particle container
@@ -68,5 +232,128 @@ namespace physicsCalculator {
          * @return The force interacting between p1 and p2.
          */
         virtual double calculateFDist(const double dist, const int t1, const int t2) const;
+
+        /**
+         * Update the forces experienced by all the particles. The container type is resolved once, such that the Lenard Jones kernel is inlined
+         * into the pair traversal of the container. The kernel operates on the structure of arrays mirror of the particle data. The linked cells
+         * are traversed in parallel either using a cell coloring or using thread local force buffers, which are reduced afterwards. Both strategies
+         * update the forces of both particles of a pair without races. The linked cells and the verlet lists pass every particle together with a
+         * batch of neighbor candidates to the vectorized batch kernel, the atomic strategy and the ghost particles use the pair kernel. The kernels
+         * are specialized for a single particle type and for a few types, whose parameters are read from registers or a small table. A force table
+         * replaces the Lenard-Jones forces of all kernels. In the mixed precision mode the kernels read single precision positions and compute the
+         * pair forces in single precision, while the forces are accumulated in double precision.
+         */
+        virtual void calculateF();
+
+        /**
+         * Get the instruction set the batch kernel was dispatched to on this cpu, e.g. for logging or benchmarks.
+         *
+         * @return The name of the instruction set, either x86-64-v4 (AVX-512), x86-64-v3 (AVX2) or scalar.
+         */
+        static const char* get_simd_target();
+
+    private:
+        /**
+         * Get the force absolute divided by the distance for the parameters of a type pair. The function is inlined into the vectorized kernels.
+         *
+         * @tparam Real The floating point type of the evaluation.
+         *
+         * @param dist_squ The squared distance between two particles.
+         * @param sigma_squ The squared sigma of the type pair.
+         * @param scaled_epsilon The scaled epsilon of the type pair.
+         *
+         * @return The force absolute divided by the distance.
+         */
+        template <typename Real> static inline Real calculateFPair(const Real dist_squ, const Real sigma_squ, const Real scaled_epsilon) {
+            // Calculate the powers of (sigma / distance)
+            const Real term_to_2 = sigma_squ / dist_squ;
+            const Real term_to_6 = term_to_2 * term_to_2 * term_to_2;
+
+            return (scaled_epsilon / dist_squ) * std::fma(Real(-2) * term_to_6, term_to_6, term_to_6);
+        }
+
+        /**
+         * Copy the parameters of the type pairs into the flat pair arrays, which the vectorized kernels can gather from.
+         */
+        void load_pair_tables();
+
+        /**
+         * Copy the parameters of the type pairs into a table of fixed size.
+         *
+         * @tparam Types The maximum number of particle types of the table, which must not be less than the number of types of the container.
+         *
+         * @return The table of the type pairs.
+         */
+        template <size_t Types> PackedPairTable<Types> load_packed_table() const;
+
+        /**
+         * Compute the forces between one particle and a batch of other particles. The forces on the batch are gathered and scattered with vector
+         * instructions, pairs beyond the cutoff distance are masked out. The batch must not contain the particle itself or any particle twice.
+         *
+         * @tparam Dim The number of simulated dimensions.
+         * @tparam Real The floating point type of the positions and the pair math.
+         * @tparam Table The type of the table providing the forces of the type pairs.
+         * @param data The arrays of the particles and the forces of the type pairs.
+         * @param i The index of the particle.
+         * @param batch The indices of the other particles.
+         * @param count The number of other particles.
+         */
+        template <size_t Dim, typename Real, typename Table>
+        static void calculateFBatch(const BatchData<Real, Table>& data, const size_t i, const size_t* batch, const size_t count);
+
+        /**
+         * Compute the forces between one particle and a batch of other particles in two dimensions. The function is compiled for several
+         * instruction sets and dispatched to the widest one supported by the cpu at runtime.
+         *
+         * @tparam Real The floating point type of the positions and the pair math.
+         * @tparam Table The type of the table providing the forces of the type pairs.
+         * @param data The arrays of the particles and the forces of the type pairs.
+         * @param i The index of the particle.
+         * @param batch The indices of the other particles.
+         * @param count The number of other particles.
+         */
+        template <typename Real, typename Table>
+        static void calculateFBatch2D(const BatchData<Real, Table>& data, const size_t i, const size_t* batch, const size_t count);
+
+        /**
+         * Compute the forces between one particle and a batch of other particles in three dimensions. The function is compiled for several
+         * instruction sets and dispatched to the widest one supported by the cpu at runtime.
+         *
+         * @tparam Real The floating point type of the positions and the pair math.
+         * @tparam Table The type of the table providing the forces of the type pairs.
+         * @param data The arrays of the particles and the forces of the type pairs.
+         * @param i The index of the particle.
+         * @param batch The indices of the other particles.
+         * @param count The number of other particles.
+         */
+        template <typename Real, typename Table>
+        static void calculateFBatch3D(const BatchData<Real, Table>& data, const size_t i, const size_t* batch, const size_t count);
+
+        /**
+         * Update the forces of the direct sum using a tiled traversal, which is distributed among the threads. Every thread accumulates into its
+         * own force buffer, the inner loop over the particles of a tile is vectorized.
+         *
+         * @tparam Dim The number of simulated dimensions.
+         * @tparam Real The floating point type of the positions and the pair math.
+         * @tparam Table The type of the table providing the forces of the type pairs.
+         * @param ds The direct sum container storing the particles.
+         * @param soa The structure of arrays mirror of the particle data.
+         * @param table The forces of the type pairs.
+         */
+        template <size_t Dim, typename Real, typename Table> void calculateFTiles(DSContainer& ds, ParticleSoA& soa, const Table& table);
+
+        /**
+         * Update the forces using the Lenard Jones kernel on the structure of arrays mirror. The number of dimensions is a template parameter, such
+         * that the z components are removed at compile time in two dimensional simulations, where all particles share their z coordinate. The
+         * floating point type of the pair math is a template parameter as well, single precision kernels gather the positions in single precision.
+         *
+         * @tparam Dim The number of simulated dimensions.
+         * @tparam Real The floating point type of the positions and the pair math.
+         * @tparam Table The type of the table providing the forces of the type pairs.
+         * @param box The box container storing the particles or a null pointer.
+         * @param ds The direct sum container storing the particles or a null pointer.
+         * @param table The forces of the type pairs.
+         */
+        template <size_t Dim, typename Real, typename Table> void calculateFSoA(BoxContainer* box, DSContainer* ds, const Table& table);
     };
 } // namespace physicsCalculator
\ No newline at end of file
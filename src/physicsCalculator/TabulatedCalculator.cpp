@@ -0,0 +1,117 @@
+#include "TabulatedCalculator.h"
+
+#include <algorithm>
+#include <fstream>
+#include <spdlog/spdlog.h>
+#include <sstream>
+
+namespace physicsCalculator {
+    TabulatedCalculator::TabulatedCalculator(const Environment& new_env, const std::shared_ptr<ParticleContainer>& new_cont)
+        : LJCalculator { new_env, new_cont, false } {
+        build_table(env.get_table_file());
+
+        // Initialize the forces
+        calculateF();
+    }
+
+    TabulatedCalculator::TabulatedCalculator(const Environment& new_env, const std::vector<Particle>& particles,
+        const std::vector<TypeDesc>& new_desc, const bool init_forces, const bool is_infinite)
+        : LJCalculator { new_env, particles, new_desc, false, is_infinite } {
+        build_table(env.get_table_file());
+
+        // Initialize the forces
+        if (init_forces) {
+            calculateF();
+        }
+    }
+
+    TabulatedCalculator::~TabulatedCalculator() = default;
+
+    double TabulatedCalculator::calculateFDist(const double dist_squ, const int t1, const int t2) const {
+        return force_table->evaluate(t1, t2, dist_squ);
+    }
+
+    void TabulatedCalculator::build_table(const std::string& file_name) {
+        const std::vector<TypeDesc> types = cont->get_types();
+        const size_t n = types.size();
+
+        // Collect the samples of every type pair, the pair is stored with its smaller type first
+        std::vector<std::vector<double>> r(n * n);
+        std::vector<std::vector<double>> force(n * n);
+
+        if (!file_name.empty()) {
+            std::ifstream file(file_name);
+
+            if (!file.is_open()) {
+                SPDLOG_CRITICAL("Could not open the table file {}.", file_name);
+                std::exit(EXIT_FAILURE);
+            }
+
+            std::string line;
+            size_t line_number = 0;
+
+            while (std::getline(file, line)) {
+                line_number++;
+
+                if (line.empty() || line[0] == '#') {
+                    continue;
+                }
+
+                std::istringstream stream(line);
+                int t1 = 0, t2 = 0;
+                double dist = 0.0, f = 0.0;
+
+                if (!(stream >> t1 >> t2 >> dist >> f) || t1 < 0 || t2 < 0 || static_cast<size_t>(std::max(t1, t2)) >= n || dist <= 0.0) {
+                    SPDLOG_CRITICAL("Error reading the table file {}: line {} must contain two valid types, a positive distance and a force.",
+                        file_name, line_number);
+                    std::exit(EXIT_FAILURE);
+                }
+
+                const size_t pair = std::min(t1, t2) + n * std::max(t1, t2);
+
+                if (!r[pair].empty() && dist <= r[pair].back()) {
+                    SPDLOG_CRITICAL("Error reading the table file {}: the distances of a type pair must increase (line {}).", file_name, line_number);
+                    std::exit(EXIT_FAILURE);
+                }
+
+                r[pair].push_back(dist);
+                force[pair].push_back(f);
+            }
+        }
+
+        // Start the grid below the repulsion of all type pairs, the particles do not come closer in stable simulations
+        double r_min = 0.5 * env.get_r_cutoff();
+
+        for (size_t t = 0; t < n; t++) {
+            r_min = std::min(r_min, 0.5 * types[t].get_sigma());
+        }
+
+        for (size_t pair = 0; pair < n * n; pair++) {
+            if (r[pair].size() == 1) {
+                SPDLOG_CRITICAL("Error reading the table file {}: every type pair requires at least two samples.", file_name);
+                std::exit(EXIT_FAILURE);
+            }
+
+            if (!r[pair].empty()) {
+                r_min = std::min(r_min, r[pair].front());
+            }
+        }
+
+        force_table = std::make_unique<ForceTable>(n, r_min, env.get_r_cutoff());
+
+        for (size_t t1 = 0; t1 < n; t1++) {
+            for (size_t t2 = t1; t2 < n; t2++) {
+                const size_t pair = t1 + n * t2;
+
+                if (r[pair].empty()) {
+                    // The qualified call evaluates the Lenard-Jones forces of the base class
+                    force_table->tabulate(t1, t2, [this, t1, t2](const double dist_squ) { return LJCalculator::calculateFDist(dist_squ, t1, t2); });
+                } else {
+                    force_table->tabulate(t1, t2, r[pair], force[pair]);
+                }
+            }
+        }
+
+        SPDLOG_DEBUG("Tabulated the forces of {} type pairs from {} to {}.", n * n, r_min, env.get_r_cutoff());
+    }
+} // namespace physicsCalculator
@@ -0,0 +1,74 @@
+/**
+ * @file
+ *
+ * @brief Handles the physics calculations of pair potentials interpolated from tables
+ */
+
+#pragma once
+
+#include "Environment.h"
+#include "ForceTable.h"
+#include "LJCalculator.h"
+#include "container/ParticleContainer.h"
+
+#include <string>
+
+namespace physicsCalculator {
+
+    /**
+     * @class TabulatedCalculator
+     *
+     * @brief Class corresponding to a leap frog integrator using pair potentials, whose forces are interpolated from cubic spline tables. The
+     * tables are built once, either from the Lenard-Jones potential or from a table file, such that expensive potentials (e.g. Morse, Buckingham
+     * or smoothed Lenard-Jones) run at the cost of the Lenard-Jones kernels. The tabulated forces vanish beyond the cutoff radius, also for the
+     * direct sum.
+     */
+    class TabulatedCalculator : public LJCalculator {
+    public:
+        /**
+         * Initialize a tabulated calculator using a simulation environment. The forces are read from the table file of the environment.
+         *
+         * @param new_env The simulation environment that should be used for initialization.
+         * @param new_cont The container storing the particles that should be used throughout the simulation.
+         */
+        TabulatedCalculator(const Environment& new_env, const std::shared_ptr<ParticleContainer>& new_cont);
+
+        /**
+         * Provide a constructor that allows the construction of a calculator using a particle container
+         * and simulation environment. This class should be used for testing.
+         *
+         * @param new_env The new simulation environment.
+         * @param particles The vector storing the particles that should be used throughout the simulation.
+         * @param new_desc The particle types.
+         * @param init_forces Define wether the forces should be initialized.
+         * @param is_infinite A boolean indicating if the simulation has an infinite domain size.
+         */
+        TabulatedCalculator(const Environment& new_env, const std::vector<Particle>& particles, const std::vector<TypeDesc>& new_desc,
+            const bool init_forces = true, const bool is_infinite = true);
+
+        /**
+         * Define a destructor for a tabulated calculator.
+         */
+        virtual ~TabulatedCalculator();
+
+        /**
+         * Get the force absolute and sign direction between two particles interpolated from the table.
+         *
+         * @param dist_squ The squared distance between two particles.
+         * @param t1 The type of the first particle.
+         * @param t2 The type of the second particle.
+         *
+         * @return The force interacting between p1 and p2.
+         */
+        virtual double calculateFDist(const double dist_squ, const int t1, const int t2) const;
+
+    private:
+        /**
+         * Build the force table of all type pairs. The type pairs of the table file are interpolated from its samples, the other type pairs
+         * tabulate the Lenard-Jones forces.
+         *
+         * @param file_name The name of the table file or an empty string.
+         */
+        void build_table(const std::string& file_name);
+    };
+} // namespace physicsCalculator
@@ -0,0 +1,112 @@
+/**
+ * @file
+ *
+ * @brief Define an allocator for aligned memory, which can be used for the standard containers.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @class AlignedAllocator
+ *
+ * @brief Define an allocator, which aligns the allocated memory to the given alignment. This allows the compiler to use aligned simd loads.
+ *
+ * @tparam T The type of the allocated elements.
+ * @tparam alignment The alignment in bytes. It must be a power of two.
+ */
+template <typename T, std::size_t alignment = 64> class AlignedAllocator {
+public:
+    /**
+     * Define the type of the allocated elements.
+     */
+    using value_type = T;
+
+    /**
+     * Define the rebind type required by the standard containers.
+     *
+     * @tparam U The new element type.
+     */
+    template <typename U> struct rebind {
+        /**
+         * Define the allocator type for the new element type.
+         */
+        using other = AlignedAllocator<U, alignment>;
+    };
+
+    /**
+     * Define the default constructor.
+     */
+    constexpr AlignedAllocator() noexcept = default;
+
+    /**
+     * Define the converting copy constructor.
+     *
+     * @param other The allocator that should be copied.
+     */
+    template <typename U> constexpr AlignedAllocator(const AlignedAllocator<U, alignment>& other) noexcept { (void)other; }
+
+    /**
+     * Allocate aligned memory for n elements.
+     *
+     * @param n The number of elements.
+     *
+     * @return The pointer to the allocated memory.
+     */
+    T* allocate(const std::size_t n) { return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t { alignment })); }
+
+    /**
+     * Free the memory allocated by this allocator.
+     *
+     * @param p The pointer to the allocated memory.
+     * @param n The number of elements.
+     */
+    void deallocate(T* p, const std::size_t n) noexcept {
+        (void)n;
+        ::operator delete(p, std::align_val_t { alignment });
+    }
+
+    /**
+     * Default initialize an element, such that resizing a vector of arithmetic types does not write the new elements. The pages of the memory are
+     * therefore first touched by the threads filling the vector.
+     *
+     * @param p The pointer to the element.
+     */
+    template <typename U> void construct(U* p) noexcept(std::is_nothrow_default_constructible_v<U>) { ::new (static_cast<void*>(p)) U; }
+
+    /**
+     * Construct an element from the given arguments.
+     *
+     * @param p The pointer to the element.
+     * @param args The arguments of the constructor.
+     */
+    template <typename U, typename... Args> void construct(U* p, Args&&... args) { ::new (static_cast<void*>(p)) U(std::forward<Args>(args)...); }
+
+    /**
+     * Test if two allocators are equal. All aligned allocators with the same alignment are interchangeable.
+     *
+     * @param other The other allocator.
+     *
+     * @return Always true.
+     */
+    template <typename U> constexpr bool operator==(const AlignedAllocator<U, alignment>& other) const noexcept {
+        (void)other;
+        return true;
+    }
+
+    /**
+     * Test if two allocators are not equal. All aligned allocators with the same alignment are interchangeable.
+     *
+     * @param other The other allocator.
+     *
+     * @return Always false.
+     */
+    template <typename U> constexpr bool operator!=(const AlignedAllocator<U, alignment>& other) const noexcept {
+        (void)other;
+        return false;
+    }
+};
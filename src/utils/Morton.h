@@ -0,0 +1,42 @@
+/**
+ * @file
+ *
+ * @brief Define the keys of the Morton (Z-order) space filling curve.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief Collection of functions computing the position of integer coordinates along the Morton curve.
+ */
+namespace Morton {
+    /**
+     * Spread the lowest 21 bits of the value, such that two zero bits are placed between every bit.
+     *
+     * @param v The value which should be spread.
+     *
+     * @return The spread value.
+     */
+    inline uint64_t spread_bits(uint64_t v) {
+        v &= 0x1fffff;
+        v = (v | v << 32) & 0x1f00000000ffff;
+        v = (v | v << 16) & 0x1f0000ff0000ff;
+        v = (v | v << 8) & 0x100f00f00f00f00f;
+        v = (v | v << 4) & 0x10c30c30c30c30c3;
+        v = (v | v << 2) & 0x1249249249249249;
+        return v;
+    }
+
+    /**
+     * Interleave the bits of the three coordinates, such that coordinates close along the curve are close in space.
+     *
+     * @param x The x coordinate.
+     * @param y The y coordinate.
+     * @param z The z coordinate.
+     *
+     * @return The key of the coordinates along the curve.
+     */
+    inline uint64_t key(const uint64_t x, const uint64_t y, const uint64_t z) { return spread_bits(x) << 2 | spread_bits(y) << 1 | spread_bits(z); }
+} // namespace Morton
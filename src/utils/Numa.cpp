@@ -0,0 +1,176 @@
+#include "Numa.h"
+
+#include "Threads.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+
+#include <spdlog/spdlog.h>
+
+#ifdef __linux__
+#include <sched.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+std::vector<size_t> Numa::parse_cpu_list(const std::string& list) {
+    std::vector<size_t> cpus;
+    std::stringstream stream(list);
+    std::string range;
+
+    while (std::getline(stream, range, ',')) {
+        const size_t dash = range.find('-');
+
+        try {
+            const size_t first = std::stoul(range.substr(0, dash));
+            const size_t last = dash == std::string::npos ? first : std::stoul(range.substr(dash + 1));
+
+            for (size_t cpu = first; cpu <= last; cpu++) {
+                cpus.push_back(cpu);
+            }
+        } catch (const std::exception& e) {
+            // Skip empty ranges, e.g. the trailing newline of the sysfs file or nodes without cpus
+            continue;
+        }
+    }
+
+    return cpus;
+}
+
+/**
+ * Read the cpu list stored in a sysfs file.
+ *
+ * @param path The path of the file.
+ *
+ * @return The cpus of the list, an empty vector if the file does not exist.
+ */
+static std::vector<size_t> read_cpu_list(const std::string& path) {
+    std::ifstream file(path);
+    std::string list;
+
+    if (!file || !std::getline(file, list)) {
+        return {};
+    }
+
+    return Numa::parse_cpu_list(list);
+}
+
+std::vector<std::vector<size_t>> Numa::read_topology(const std::string& sys) {
+    std::vector<std::vector<size_t>> topology;
+
+    // The node directories are numbered consecutively, memory only nodes without cpus are skipped
+    for (size_t node = 0;; node++) {
+        const std::string path = sys + "/node/node" + std::to_string(node) + "/cpulist";
+
+        if (!std::ifstream(path)) {
+            break;
+        }
+
+        std::vector<size_t> cpus = read_cpu_list(path);
+
+        if (!cpus.empty()) {
+            topology.push_back(std::move(cpus));
+        }
+    }
+
+    if (topology.empty()) {
+        std::vector<size_t> cpus = read_cpu_list(sys + "/cpu/online");
+
+        if (!cpus.empty()) {
+            topology.push_back(std::move(cpus));
+        }
+    }
+
+    return topology;
+}
+
+std::vector<size_t> Numa::order_cpus(const std::vector<std::vector<size_t>>& topology, const PinningStrategy strategy) {
+    std::vector<size_t> order;
+
+    if (strategy == COMPACT) {
+        for (const std::vector<size_t>& cpus : topology) {
+            order.insert(order.end(), cpus.begin(), cpus.end());
+        }
+    } else if (strategy == SCATTER) {
+        size_t max_cpus = 0;
+
+        for (const std::vector<size_t>& cpus : topology) {
+            max_cpus = std::max(max_cpus, cpus.size());
+        }
+
+        // Take the next cpu of every node in turn, nodes with fewer cpus drop out at the end
+        for (size_t i = 0; i < max_cpus; i++) {
+            for (const std::vector<size_t>& cpus : topology) {
+                if (i < cpus.size()) {
+                    order.push_back(cpus[i]);
+                }
+            }
+        }
+    }
+
+    return order;
+}
+
+size_t Numa::pin_threads(const PinningStrategy strategy) {
+    if (strategy == NO_PINNING) {
+        return 0;
+    }
+
+    const std::vector<std::vector<size_t>> topology = read_topology();
+    const std::vector<size_t> order = order_cpus(topology, strategy);
+
+    if (order.empty()) {
+        SPDLOG_WARN("The cpu topology could not be read, the threads are not pinned.");
+        return 0;
+    }
+
+    size_t pinned = 0;
+
+#ifdef __linux__
+#pragma omp parallel reduction(+ : pinned)
+    {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(order[Threads::get_thread_num() % order.size()], &set);
+
+        if (sched_setaffinity(0, sizeof(set), &set) == 0) {
+            pinned++;
+        }
+    }
+#else
+    SPDLOG_WARN("Pinning the threads is only supported on Linux.");
+#endif
+
+    SPDLOG_INFO("Pinned {} threads to {} cpus on {} NUMA nodes.", pinned, order.size(), topology.size());
+
+    return pinned;
+}
+
+void Numa::release_pages(void* data, const size_t bytes, const bool huge_pages) {
+#ifdef __linux__
+    const uintptr_t page = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+    const uintptr_t begin = (reinterpret_cast<uintptr_t>(data) + page - 1) / page * page;
+    const uintptr_t end = (reinterpret_cast<uintptr_t>(data) + bytes) / page * page;
+
+    // The pages at both ends may be shared with other allocations and must keep their content
+    if (end <= begin) {
+        return;
+    }
+
+    void* first = reinterpret_cast<void*>(begin);
+
+#ifdef MADV_HUGEPAGE
+    if (huge_pages) {
+        madvise(first, end - begin, MADV_HUGEPAGE);
+    }
+#endif
+
+    madvise(first, end - begin, MADV_DONTNEED);
+#else
+    (void)data;
+    (void)bytes;
+    (void)huge_pages;
+#endif
+}
@@ -0,0 +1,92 @@
+/**
+ * @file
+ *
+ * @brief Define the utility for placing the threads and the memory of the simulation on the NUMA nodes of the machine.
+ */
+
+#pragma once
+
+#include "Environment.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Collection of functions for thread pinning and first touch page placement.
+ *
+ * Linux places a page on the NUMA node of the thread writing it first. If the particles are initialized by the main thread, all pages are located
+ * on its node and the threads of the other nodes access remote memory for every step. The pages are therefore touched again by the threads, which
+ * use them in the statically scheduled loops of the integrator. This only pays off if the threads are pinned, such that they do not move to
+ * another node later on.
+ */
+namespace Numa {
+    /**
+     * Parse a list of cpu ranges in the format of the Linux sysfs, e.g. "0-3,8,10-11".
+     *
+     * @param list The list of cpu ranges.
+     *
+     * @return The cpu indices in ascending order of the list.
+     */
+    std::vector<size_t> parse_cpu_list(const std::string& list);
+
+    /**
+     * Read the cpus of every NUMA node from the sysfs. If the NUMA nodes are not available, the online cpus form a single node.
+     *
+     * @param sys Optional: The directory of the system devices.
+     *
+     * @return The cpus of every NUMA node, an empty vector if the topology could not be read.
+     */
+    std::vector<std::vector<size_t>> read_topology(const std::string& sys = "/sys/devices/system");
+
+    /**
+     * Order the cpus of the NUMA nodes, such that thread t is pinned to the cpu at position t modulo the number of cpus.
+     *
+     * @param topology The cpus of every NUMA node.
+     * @param strategy The pinning strategy.
+     *
+     * @return The order of the cpus.
+     */
+    std::vector<size_t> order_cpus(const std::vector<std::vector<size_t>>& topology, const PinningStrategy strategy);
+
+    /**
+     * Pin every thread of the OpenMP thread pool to a cpu. The threads keep their cpu in the following parallel regions, as long as the number of
+     * threads does not change.
+     *
+     * @param strategy The pinning strategy.
+     *
+     * @return The number of pinned threads.
+     */
+    size_t pin_threads(const PinningStrategy strategy);
+
+    /**
+     * Return the pages fully contained in a memory range to the operating system, such that the next write places them on the node of the
+     * writing thread. The content of the released pages is lost.
+     *
+     * @param data The start of the memory range.
+     * @param bytes The size of the memory range in bytes.
+     * @param huge_pages Ask the operating system to back the range with transparent huge pages.
+     */
+    void release_pages(void* data, const size_t bytes, const bool huge_pages);
+
+    /**
+     * Move the pages of a vector to the threads using them, by touching them again in a statically scheduled parallel loop.
+     *
+     * @param values The vector.
+     * @param huge_pages Ask the operating system to back the vector with transparent huge pages.
+     */
+    template <typename T> void first_touch(std::vector<T>& values, const bool huge_pages);
+} // namespace Numa
+
+template <typename T> inline void Numa::first_touch(std::vector<T>& values, const bool huge_pages) {
+    const std::vector<T> copy = values;
+    const size_t n = values.size();
+
+    release_pages(values.data(), n * sizeof(T), huge_pages);
+
+    // The same static schedule as in the integrator loops assigns every element to the thread updating it
+#pragma omp parallel for schedule(static)
+    for (size_t i = 0; i < n; i++) {
+        values[i] = copy[i];
+    }
+}
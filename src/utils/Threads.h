@@ -0,0 +1,124 @@
+/**
+ * @file
+ *
+ * @brief Define wrappers around the OpenMP runtime, which fall back to a single thread if the program is compiled without OpenMP.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/**
+ * @brief Collection of functions querying the threads of the OpenMP runtime.
+ */
+namespace Threads {
+    /**
+     * Get the maximum number of threads, which a parallel region would use.
+     *
+     * @return The maximum number of threads.
+     */
+    inline size_t get_max_threads() {
+#ifdef _OPENMP
+        return static_cast<size_t>(omp_get_max_threads());
+#else
+        return 1;
+#endif
+    }
+
+    /**
+     * Get the number of threads of the current parallel region, which is 1 outside of a parallel region.
+     *
+     * @return The number of threads.
+     */
+    inline size_t get_num_threads() {
+#ifdef _OPENMP
+        return static_cast<size_t>(omp_get_num_threads());
+#else
+        return 1;
+#endif
+    }
+
+    /**
+     * Get the wall clock time used for measuring the work of the threads.
+     *
+     * @return The time in seconds.
+     */
+    inline double get_time() {
+#ifdef _OPENMP
+        return omp_get_wtime();
+#else
+        return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+    }
+
+    /**
+     * Get the index of the calling thread within the current parallel region.
+     *
+     * @return The index of the thread.
+     */
+    inline size_t get_thread_num() {
+#ifdef _OPENMP
+        return static_cast<size_t>(omp_get_thread_num());
+#else
+        return 0;
+#endif
+    }
+
+    /**
+     * Add a value to a variable shared by multiple threads atomically. The update compiles to a lock free compare and swap loop on the common
+     * platforms.
+     *
+     * @param target The shared variable.
+     * @param value The value added to the variable.
+     */
+    inline void atomic_add(double& target, const double value) {
+#pragma omp atomic
+        target += value;
+    }
+
+    /**
+     * Store the number of consecutive terms, which are summed up by a single thread in a deterministic sum.
+     */
+    constexpr size_t sum_block_size = 1024;
+
+    /**
+     * Sum up the terms of an index range in parallel. The range is split into blocks of a fixed size, whose partial sums are added in order
+     * afterwards, such that the result does not depend on the number of threads.
+     *
+     * @param n The number of terms.
+     * @param term The function returning the term of an index, it is called exactly once for every index.
+     *
+     * @return The sum of all terms.
+     */
+    template <typename F> inline double deterministic_sum(const size_t n, const F& term) {
+        const size_t blocks = (n + sum_block_size - 1) / sum_block_size;
+        std::vector<double> partial(blocks, 0.0);
+
+#pragma omp parallel for schedule(static)
+        for (size_t b = 0; b < blocks; b++) {
+            const size_t last = std::min(n, (b + 1) * sum_block_size);
+            double sum = 0.0;
+
+            for (size_t i = b * sum_block_size; i < last; i++) {
+                sum += term(i);
+            }
+
+            partial[b] = sum;
+        }
+
+        double total = 0.0;
+
+        for (const double sum : partial) {
+            total += sum;
+        }
+
+        return total;
+    }
+} // namespace Threads
@@ -314,3 +314,447 @@ TEST(EnvironmentConstructor, EnvironmentDuplicateLogLevel) {
 
     ASSERT_EXIT(env = Environment(argc, argv), testing::ExitedWithCode(EXIT_FAILURE), "");
 }
+
+// Test if the verlet list skin is parsed correctly
+TEST(EnvironmentConstructor, EnvironmentSkin) {
+    const char* argv[] = {
+        "./MolSim",
+        "-skin=0.3",
+        "path/to/input.txt",
+    };
+
+    constexpr int argc = sizeof(argv) / sizeof(argv[0]);
+
+    Environment env;
+
+    EXPECT_DOUBLE_EQ(env.get_skin(), 0.0) << "The skin should be initialized to its default value.";
+
+    ASSERT_NO_THROW(env = Environment(argc, argv));
+
+    EXPECT_DOUBLE_EQ(env.get_skin(), 0.3) << "The skin must be the same as provided.";
+}
+
+// Test if a negative skin is recognized
+TEST(EnvironmentConstructor, EnvironmentNegativeSkin) {
+    const char* argv[] = {
+        "./MolSim",
+        "-skin=-0.3",
+        "path/to/input.txt",
+    };
+
+    constexpr int argc = sizeof(argv) / sizeof(argv[0]);
+
+    Environment env;
+
+    ASSERT_EXIT(env = Environment(argc, argv), testing::ExitedWithCode(EXIT_FAILURE), "");
+}
+
+// Test if the reorder option is parsed correctly
+TEST(EnvironmentConstructor, EnvironmentReorder) {
+    const char* argv[] = {
+        "./MolSim",
+        "-reorder=on",
+        "path/to/input.txt",
+    };
+
+    constexpr int argc = sizeof(argv) / sizeof(argv[0]);
+
+    Environment env;
+
+    EXPECT_FALSE(env.get_reorder()) << "The reordering should be disabled by default.";
+
+    ASSERT_NO_THROW(env = Environment(argc, argv));
+
+    EXPECT_TRUE(env.get_reorder()) << "The reordering must be enabled as provided.";
+}
+
+// Test if a duplicate reorder option is recognized
+TEST(EnvironmentConstructor, EnvironmentDuplicateReorder) {
+    const char* argv[] = {
+        "./MolSim",
+        "-reorder=on",
+        "-reorder=off",
+        "path/to/input.txt",
+    };
+
+    constexpr int argc = sizeof(argv) / sizeof(argv[0]);
+
+    Environment env;
+
+    ASSERT_EXIT(env = Environment(argc, argv), testing::ExitedWithCode(EXIT_FAILURE), "");
+}
+
+// Test if the sort interval is parsed correctly
+TEST(EnvironmentConstructor, EnvironmentSortInterval) {
+    const char* argv[] = {
+        "./MolSim",
+        "-sort_interval=100",
+        "path/to/input.txt",
+    };
+
+    constexpr int argc = sizeof(argv) / sizeof(argv[0]);
+
+    Environment env;
+
+    EXPECT_EQ(env.get_sort_interval(), 0) << "The sort interval should be initialized to its default value.";
+
+    ASSERT_NO_THROW(env = Environment(argc, argv));
+
+    EXPECT_EQ(env.get_sort_interval(), 100) << "The sort interval must be the same as provided.";
+}
+
+// Test if a negative sort interval is recognized
+TEST(EnvironmentConstructor, EnvironmentNegativeSortInterval) {
+    const char* argv[] = {
+        "./MolSim",
+        "-sort_interval=-1",
+        "path/to/input.txt",
+    };
+
+    constexpr int argc = sizeof(argv) / sizeof(argv[0]);
+
+    Environment env;
+
+    ASSERT_EXIT(env = Environment(argc, argv), testing::ExitedWithCode(EXIT_FAILURE), "");
+}
+
+// Test if the sub cells are rejected in combination with the periodic boundary
+TEST(EnvironmentConstructor, EnvironmentPeriodicSubCells) {
+    Environment env;
+    env.set_sub_cells(2);
+
+    ASSERT_NO_THROW(env.assert_boundary_conditions());
+
+    env.set_boundary_type({ PERIODIC, HALO, HALO, PERIODIC, HALO, HALO });
+
+    ASSERT_EXIT(env.assert_boundary_conditions(), testing::ExitedWithCode(EXIT_FAILURE), "");
+
+    // The ghost particles support sub cells
+    env.set_periodic_ghosts(true);
+
+    ASSERT_NO_THROW(env.assert_boundary_conditions());
+
+    // The ghost particles do not support verlet lists
+    env.set_skin(0.3);
+
+    ASSERT_EXIT(env.assert_boundary_conditions(), testing::ExitedWithCode(EXIT_FAILURE), "");
+}
+
+// Test if the periodic ghosts option is parsed correctly
+TEST(EnvironmentConstructor, EnvironmentPeriodicGhosts) {
+    const char* argv[] = {
+        "./MolSim",
+        "-periodic_ghosts=on",
+        "path/to/input.txt",
+    };
+
+    constexpr int argc = sizeof(argv) / sizeof(argv[0]);
+
+    Environment env;
+
+    EXPECT_FALSE(env.get_periodic_ghosts()) << "The periodic ghost particles should be disabled by default.";
+
+    ASSERT_NO_THROW(env = Environment(argc, argv));
+
+    EXPECT_TRUE(env.get_periodic_ghosts()) << "The periodic ghost particles must be enabled as provided.";
+}
+
+// Test if a duplicate periodic ghosts option is recognized
+TEST(EnvironmentConstructor, EnvironmentDuplicatePeriodicGhosts) {
+    const char* argv[] = {
+        "./MolSim",
+        "-periodic_ghosts=off",
+        "-periodic_ghosts=on",
+        "path/to/input.txt",
+    };
+
+    constexpr int argc = sizeof(argv) / sizeof(argv[0]);
+
+    Environment env;
+
+    ASSERT_EXIT(env = Environment(argc, argv), testing::ExitedWithCode(EXIT_FAILURE), "");
+}
+
+// Test if the number of threads is parsed correctly
+TEST(EnvironmentConstructor, EnvironmentThreads) {
+    const char* argv[] = {
+        "./MolSim",
+        "-threads=4",
+        "path/to/input.txt",
+    };
+
+    constexpr int argc = sizeof(argv) / sizeof(argv[0]);
+
+    Environment env;
+
+    EXPECT_EQ(env.get_threads(), 0) << "The number of threads should be initialized to its default value.";
+
+    ASSERT_NO_THROW(env = Environment(argc, argv));
+
+    EXPECT_EQ(env.get_threads(), 4) << "The number of threads must be the same as provided.";
+}
+
+// Test if a number of threads, which is not strictly positive, is recognized
+TEST(EnvironmentConstructor, EnvironmentZeroThreads) {
+    const char* argv[] = {
+        "./MolSim",
+        "-threads=0",
+        "path/to/input.txt",
+    };
+
+    constexpr int argc = sizeof(argv) / sizeof(argv[0]);
+
+    Environment env;
+
+    ASSERT_EXIT(env = Environment(argc, argv), testing::ExitedWithCode(EXIT_FAILURE), "");
+}
+
+// Test if the parallel strategy is parsed correctly
+TEST(EnvironmentConstructor, EnvironmentParallelStrategy) {
+    const char* argv[] = {
+        "./MolSim",
+        "-parallel=reduction",
+        "path/to/input.txt",
+    };
+
+    constexpr int argc = sizeof(argv) / sizeof(argv[0]);
+
+    Environment env;
+
+    EXPECT_EQ(env.get_parallel_strategy(), COLORING) << "The parallel strategy should be initialized to its default value.";
+
+    ASSERT_NO_THROW(env = Environment(argc, argv));
+
+    EXPECT_EQ(env.get_parallel_strategy(), REDUCTION) << "The parallel strategy must be the same as provided.";
+}
+
+// Test if the atomic parallel strategy is parsed correctly
+TEST(EnvironmentConstructor, EnvironmentAtomicParallelStrategy) {
+    const char* argv[] = {
+        "./MolSim",
+        "-parallel=atomic",
+        "path/to/input.txt",
+    };
+
+    constexpr int argc = sizeof(argv) / sizeof(argv[0]);
+
+    Environment env;
+
+    ASSERT_NO_THROW(env = Environment(argc, argv));
+
+    EXPECT_EQ(env.get_parallel_strategy(), ATOMIC) << "The parallel strategy must be the same as provided.";
+}
+
+// Test if a duplicate parallel strategy is recognized
+TEST(EnvironmentConstructor, EnvironmentDuplicateParallelStrategy) {
+    const char* argv[] = {
+        "./MolSim",
+        "-parallel=coloring",
+        "-parallel=reduction",
+        "path/to/input.txt",
+    };
+
+    constexpr int argc = sizeof(argv) / sizeof(argv[0]);
+
+    Environment env;
+
+    ASSERT_EXIT(env = Environment(argc, argv), testing::ExitedWithCode(EXIT_FAILURE), "");
+}
+
+// Test if the cell tasks are parsed correctly
+TEST(EnvironmentConstructor, EnvironmentCellTasks) {
+    const char* argv[] = {
+        "./MolSim",
+        "-cell_tasks=on",
+        "path/to/input.txt",
+    };
+
+    constexpr int argc = sizeof(argv) / sizeof(argv[0]);
+
+    Environment env;
+
+    EXPECT_FALSE(env.get_cell_tasks()) << "The cell tasks should be initialized to their default value.";
+
+    ASSERT_NO_THROW(env = Environment(argc, argv));
+
+    EXPECT_TRUE(env.get_cell_tasks()) << "The cell tasks must be the same as provided.";
+}
+
+// Test if the balance threshold is parsed correctly and only accepted together with the reduction strategy
+TEST(EnvironmentConstructor, EnvironmentBalance) {
+    const char* argv[] = {
+        "./MolSim",
+        "-balance=0.1",
+        "path/to/input.txt",
+    };
+
+    constexpr int argc = sizeof(argv) / sizeof(argv[0]);
+
+    Environment env;
+
+    EXPECT_DOUBLE_EQ(env.get_balance(), 0.0) << "The balance threshold should be initialized to its default value.";
+
+    ASSERT_NO_THROW(env = Environment(argc, argv));
+
+    EXPECT_DOUBLE_EQ(env.get_balance(), 0.1) << "The balance threshold must be the same as provided.";
+
+    ASSERT_EXIT(env.assert_boundary_conditions(), testing::ExitedWithCode(EXIT_FAILURE), "");
+
+    env.set_parallel_strategy(REDUCTION);
+
+    ASSERT_NO_THROW(env.assert_boundary_conditions());
+
+    // The cell tasks replace the balanced partition
+    env.set_cell_tasks(true);
+
+    ASSERT_EXIT(env.assert_boundary_conditions(), testing::ExitedWithCode(EXIT_FAILURE), "");
+}
+
+// Test if a negative balance threshold is recognized
+TEST(EnvironmentConstructor, EnvironmentNegativeBalance) {
+    const char* argv[] = {
+        "./MolSim",
+        "-balance=-0.1",
+        "path/to/input.txt",
+    };
+
+    constexpr int argc = sizeof(argv) / sizeof(argv[0]);
+
+    Environment env;
+
+    ASSERT_EXIT(env = Environment(argc, argv), testing::ExitedWithCode(EXIT_FAILURE), "");
+}
+
+// Test if the NUMA options are parsed correctly
+TEST(EnvironmentConstructor, EnvironmentNuma) {
+    const char* argv[] = {
+        "./MolSim",
+        "-numa=on",
+        "-pinning=scatter",
+        "-huge_pages=on",
+        "path/to/input.txt",
+    };
+
+    constexpr int argc = sizeof(argv) / sizeof(argv[0]);
+
+    Environment env;
+
+    EXPECT_FALSE(env.get_numa()) << "The NUMA mode should be initialized to its default value.";
+    EXPECT_EQ(env.get_pinning(), NO_PINNING) << "The pinning should be initialized to its default value.";
+    EXPECT_FALSE(env.get_huge_pages()) << "The huge pages should be initialized to their default value.";
+
+    ASSERT_NO_THROW(env = Environment(argc, argv));
+
+    EXPECT_TRUE(env.get_numa()) << "The NUMA mode must be the same as provided.";
+    EXPECT_EQ(env.get_pinning(), SCATTER) << "The pinning must be the same as provided.";
+    EXPECT_TRUE(env.get_huge_pages()) << "The huge pages must be the same as provided.";
+
+    ASSERT_NO_THROW(env.assert_boundary_conditions());
+
+    // The huge pages are only used by the NUMA mode
+    env.set_numa(false);
+
+    ASSERT_EXIT(env.assert_boundary_conditions(), testing::ExitedWithCode(EXIT_FAILURE), "");
+}
+
+// Test if a duplicate pinning option is recognized
+TEST(EnvironmentConstructor, EnvironmentDuplicatePinning) {
+    const char* argv[] = {
+        "./MolSim",
+        "-pinning=compact",
+        "-pinning=off",
+        "path/to/input.txt",
+    };
+
+    constexpr int argc = sizeof(argv) / sizeof(argv[0]);
+
+    Environment env;
+
+    ASSERT_EXIT(env = Environment(argc, argv), testing::ExitedWithCode(EXIT_FAILURE), "");
+}
+
+// Test if the tabulated calculator and its table file are parsed correctly
+TEST(EnvironmentConstructor, EnvironmentTabulatedCalculator) {
+    const char* argv[] = {
+        "./MolSim",
+        "-calc=tabulated",
+        "-table=path/to/table.txt",
+        "path/to/input.txt",
+    };
+
+    constexpr int argc = sizeof(argv) / sizeof(argv[0]);
+
+    Environment env;
+
+    EXPECT_EQ(env.get_table_file(), "") << "The table file should be initialized to its default value.";
+
+    ASSERT_NO_THROW(env = Environment(argc, argv));
+
+    EXPECT_EQ(env.get_calculator_type(), TABULATED) << "The calculator type must be the same as provided.";
+    EXPECT_EQ(env.get_table_file(), "path/to/table.txt") << "The table file must be the same as provided.";
+
+    ASSERT_NO_THROW(env.assert_boundary_conditions());
+
+    // The table file is only read by the tabulated calculator
+    env.set_calculator_type(LJ_FULL);
+
+    ASSERT_EXIT(env.assert_boundary_conditions(), testing::ExitedWithCode(EXIT_FAILURE), "");
+}
+
+// Test if a duplicate table file is recognized
+TEST(EnvironmentConstructor, EnvironmentDuplicateTable) {
+    const char* argv[] = {
+        "./MolSim",
+        "-table=path/to/table.txt",
+        "-table=path/to/other.txt",
+        "path/to/input.txt",
+    };
+
+    constexpr int argc = sizeof(argv) / sizeof(argv[0]);
+
+    Environment env;
+
+    ASSERT_EXIT(env = Environment(argc, argv), testing::ExitedWithCode(EXIT_FAILURE), "");
+}
+
+// Test if the mixed precision is parsed and only combined with the pair potential calculators
+TEST(EnvironmentConstructor, EnvironmentMixedPrecision) {
+    const char* argv[] = {
+        "./MolSim",
+        "-precision=mixed",
+        "path/to/input.txt",
+    };
+
+    constexpr int argc = sizeof(argv) / sizeof(argv[0]);
+
+    Environment env;
+
+    EXPECT_EQ(env.get_precision(), DOUBLE_PRECISION) << "The precision should be initialized to its default value.";
+
+    ASSERT_NO_THROW(env = Environment(argc, argv));
+
+    EXPECT_EQ(env.get_precision(), MIXED_PRECISION) << "The precision must be the same as provided.";
+
+    ASSERT_NO_THROW(env.assert_boundary_conditions());
+
+    // The gravity calculator has no mixed precision kernels
+    env.set_calculator_type(GRAVITY);
+
+    ASSERT_EXIT(env.assert_boundary_conditions(), testing::ExitedWithCode(EXIT_FAILURE), "");
+}
+
+// Test if a duplicate precision is recognized
+TEST(EnvironmentConstructor, EnvironmentDuplicatePrecision) {
+    const char* argv[] = {
+        "./MolSim",
+        "-precision=mixed",
+        "-precision=double",
+        "path/to/input.txt",
+    };
+
+    constexpr int argc = sizeof(argv) / sizeof(argv[0]);
+
+    Environment env;
+
+    ASSERT_EXIT(env = Environment(argc, argv), testing::ExitedWithCode(EXIT_FAILURE), "");
+}
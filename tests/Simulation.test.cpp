@@ -0,0 +1,147 @@
+#include <ParticleGenerator.h>
+#include <Simulation.h>
+#include <boundaries/Stepper.h>
+#include <gtest/gtest.h>
+#include <physicsCalculator/GravityCalculator.h>
+#include <physicsCalculator/LJCalculator.h>
+#include <physicsCalculator/TabulatedCalculator.h>
+
+/**
+ * Perform the same steps using the stepper and the statically dispatched simulation and compare the particles bit by bit.
+ *
+ * @param env The simulation environment providing the boundaries.
+ * @param calc_stepper The calculator used by the stepper.
+ * @param calc_engine The calculator used by the simulation, which stores the same particles.
+ * @param steps The number of steps.
+ */
+static void expect_equal_steps(
+    const Environment& env, physicsCalculator::Calculator& calc_stepper, physicsCalculator::Calculator& calc_engine, const size_t steps) {
+    Stepper stepper(env.get_boundary_type(), env.get_domain_size(), env.get_periodic_ghosts());
+    const std::unique_ptr<Engine> engine = Engine::create(env, calc_engine);
+
+    for (size_t i = 0; i < steps; i++) {
+        stepper.step(calc_stepper);
+        engine->step();
+    }
+
+    ParticleContainer& expected = calc_stepper.get_container();
+    ParticleContainer& actual = calc_engine.get_container();
+
+    ASSERT_EQ(expected.size(), actual.size()) << "The simulation must remove the same particles.";
+
+    for (size_t i = 0; i < expected.size(); i++) {
+        EXPECT_EQ(expected[i].getX(), actual[i].getX()) << "The position of particle " << i << " must be equal.";
+        EXPECT_EQ(expected[i].getV(), actual[i].getV()) << "The velocity of particle " << i << " must be equal.";
+        EXPECT_EQ(expected[i].getF(), actual[i].getF()) << "The force of particle " << i << " must be equal.";
+    }
+}
+
+// Test if the simulation reproduces the stepper for the Lenard-Jones calculator using the linked cells
+TEST(Simulation, LinkedCells) {
+    Environment env;
+    env.set_r_cutoff(2.5);
+    env.set_domain_size({ 10.0, 10.0, 10.0 });
+    env.set_delta_t(0.0005);
+
+    ParticleGenerator gen;
+
+    // Fill the domain, such that particles interact across all periodic boundaries, edges and corners
+    physicsCalculator::LJCalculator calc(env, {}, {}, false, false);
+    calc.get_container().resize(512);
+    gen.generateCuboid(calc.get_container(), 0, { 0.6, 0.6, 0.6 }, { 0.0, 0.0, 0.0 }, 0, { 8, 8, 8 }, 1.25, 2.0, 3);
+
+    const std::vector<Particle> particles(calc.get_container().begin(), calc.get_container().end());
+    const std::vector<TypeDesc> ptypes = { TypeDesc { 1.0, 1.0, 5.0, 0.0005, 0.0 } };
+
+    // Cover the boundary configurations resolved at compile time and the configuration reading the boundary types at runtime
+    for (const std::array<BoundaryType, 6>& boundaries : {
+             std::array<BoundaryType, 6> { PERIODIC, PERIODIC, PERIODIC, PERIODIC, PERIODIC, PERIODIC },
+             std::array<BoundaryType, 6> { PERIODIC, HALO, HALO, PERIODIC, HALO, HALO },
+             std::array<BoundaryType, 6> { HARD, HARD, HARD, HARD, HARD, HARD },
+             std::array<BoundaryType, 6> { HALO, HALO, HALO, HALO, HALO, HALO },
+             std::array<BoundaryType, 6> { OUTFLOW, OUTFLOW, OUTFLOW, OUTFLOW, OUTFLOW, OUTFLOW },
+             std::array<BoundaryType, 6> { PERIODIC, HARD, OUTFLOW, PERIODIC, HALO, OUTFLOW },
+         }) {
+        for (const bool ghosts : { false, true }) {
+            env.set_boundary_type(boundaries);
+            env.set_periodic_ghosts(ghosts);
+
+            physicsCalculator::LJCalculator calc_stepper(env, particles, ptypes, true, false);
+            physicsCalculator::LJCalculator calc_engine(env, particles, ptypes, true, false);
+
+            expect_equal_steps(env, calc_stepper, calc_engine, 100);
+        }
+    }
+}
+
+// Test if the simulation reproduces the stepper for the tabulated calculator in two dimensions
+TEST(Simulation, Tabulated) {
+    Environment env;
+    env.set_r_cutoff(2.5);
+    env.set_domain_size({ 20.0, 12.0, 1.0 });
+    env.set_delta_t(0.0005);
+    env.set_dimensions(2);
+    env.set_calculator_type(TABULATED);
+    env.set_boundary_type({ PERIODIC, HALO, INF_CONT, PERIODIC, HALO, INF_CONT });
+
+    ParticleGenerator gen;
+
+    physicsCalculator::LJCalculator calc(env, {}, {}, false, false);
+    calc.get_container().resize(2 * 16 * 4);
+    gen.generateCuboid(calc.get_container(), 0, { 0.6, 0.7, 0.5 }, { 0.0, 0.0, 0.0 }, 0, { 16, 4, 1 }, 1.2, 5.0, 2);
+    gen.generateCuboid(calc.get_container(), 16 * 4, { 0.6, 6.0, 0.5 }, { 0.0, 0.0, 0.0 }, 1, { 16, 4, 1 }, 1.2, 5.0, 2);
+
+    const std::vector<Particle> particles(calc.get_container().begin(), calc.get_container().end());
+    const std::vector<TypeDesc> ptypes = { TypeDesc { 1.0, 1.2, 1.0, 0.0005, -12.44 }, TypeDesc { 2.0, 1.1, 1.0, 0.0005, -12.44 } };
+
+    physicsCalculator::TabulatedCalculator calc_stepper(env, particles, ptypes, true, false);
+    physicsCalculator::TabulatedCalculator calc_engine(env, particles, ptypes, true, false);
+
+    // The lower layer falls into the range of the halo boundary
+    expect_equal_steps(env, calc_stepper, calc_engine, 500);
+}
+
+// Test if the simulation reproduces the stepper for the direct sum
+TEST(Simulation, DirectSum) {
+    Environment env;
+    env.set_domain_size({ 10.0, 10.0, 10.0 });
+    env.set_delta_t(0.0005);
+
+    ParticleGenerator gen;
+
+    physicsCalculator::LJCalculator calc(env, {}, {}, false, true);
+    calc.get_container().resize(125);
+    gen.generateCuboid(calc.get_container(), 0, { 0.6, 0.6, 0.6 }, { 0.0, 0.0, 0.0 }, 0, { 5, 5, 5 }, 1.1225, 2.0, 3);
+
+    const std::vector<Particle> particles(calc.get_container().begin(), calc.get_container().end());
+    const std::vector<TypeDesc> ptypes = { TypeDesc { 1.0, 1.0, 5.0, 0.0005, 0.0 } };
+
+    // The infinite domain may be combined with the reflecting boundaries
+    for (const std::array<BoundaryType, 6>& boundaries : {
+             std::array<BoundaryType, 6> { INF_CONT, INF_CONT, INF_CONT, INF_CONT, INF_CONT, INF_CONT },
+             std::array<BoundaryType, 6> { HARD, HALO, INF_CONT, INF_CONT, HALO, INF_CONT },
+         }) {
+        env.set_boundary_type(boundaries);
+
+        physicsCalculator::LJCalculator calc_stepper(env, particles, ptypes, true, true);
+        physicsCalculator::LJCalculator calc_engine(env, particles, ptypes, true, true);
+
+        expect_equal_steps(env, calc_stepper, calc_engine, 100);
+    }
+
+    // The gravity calculator only supports the infinite domain
+    env.set_boundary_type({ INF_CONT, INF_CONT, INF_CONT, INF_CONT, INF_CONT, INF_CONT });
+    env.set_calculator_type(GRAVITY);
+
+    const std::vector<Particle> bodies = {
+        Particle({ 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 }, 0),
+        Particle({ 0.0, 1.0, 0.0 }, { -1.0, 0.0, 0.0 }, 1),
+        Particle({ 0.0, 5.36, 0.0 }, { -0.425, 0.0, 0.0 }, 1),
+    };
+    const std::vector<TypeDesc> masses = { TypeDesc { 1.0, 1.0, 5.0, 0.014, 0.0 }, TypeDesc { 3.0e-6, 1.0, 5.0, 0.014, 0.0 } };
+
+    physicsCalculator::GravityCalculator gravity_stepper(env, bodies, masses, true, INF_CONT);
+    physicsCalculator::GravityCalculator gravity_engine(env, bodies, masses, true, INF_CONT);
+
+    expect_equal_steps(env, gravity_stepper, gravity_engine, 1000);
+}
@@ -1,6 +1,7 @@
 #include "../src/Thermostat.h"
 #include "../src/container/BoxContainer.h"
 #include "../src/container/DSContainer.h"
+#include "../src/physicsCalculator/LJCalculator.h"
 
 #include <gtest/gtest.h>
 
@@ -130,4 +131,58 @@ TEST(Thermostat, MultipleParticleRegulation) {
         EXPECT_EQ((*actual).getType(), expected[i].getType()) << "Type of particle should not be changed by temperature regulation.";
         actual++;
     }
-}
\ No newline at end of file
+}
+
+// Test if the kinetic energy summed up by the velocity update regulates the temperature like the separate reduction of the thermostat
+TEST(Thermostat, TrackedKineticEnergy) {
+    std::vector<Particle> particles;
+
+    for (size_t i = 0; i < 3000; i++) {
+        const double s = static_cast<double>(i);
+        particles.emplace_back(Vec<double> { 0.01 * s, 1.0, 2.0 }, Vec<double> { std::sin(s), std::cos(s), 0.5 * std::sin(3.0 * s) }, i % 2);
+        particles.back().setF({ std::cos(2.0 * s), 1.0, -0.5 });
+    }
+
+    const std::vector<TypeDesc> types = { { 1.0, 1.0, 5.0, 0.01, 0.0 }, { 2.5, 1.0, 5.0, 0.01, 0.0 } };
+
+    Environment env;
+    env.set_dimensions(3);
+
+    physicsCalculator::LJCalculator tracked(env, particles, types, false);
+    physicsCalculator::LJCalculator separate(env, particles, types, false);
+
+    tracked.set_track_kinetic_energy(true);
+    tracked.calculateV();
+    separate.calculateV();
+
+    // Compute the reference energy serially from the updated velocities
+    double E_kin = 0.0;
+
+    for (const auto& p : separate.get_container()) {
+        E_kin += types[p.getType()].get_mass() * p.getV().len_squ();
+    }
+
+    EXPECT_NEAR(tracked.get_kinetic_energy(), E_kin, 1e-12 * E_kin) << "The velocity update must sum up m * v * v of all particles.";
+
+    const auto regulate = [](ParticleContainer& cont, const double* E_kin) {
+        Thermostat thermo;
+        thermo.set_dimensions(3);
+        thermo.set_T_target(0.1);
+        thermo.set_particles(std::shared_ptr<ParticleContainer>(&cont, [](ParticleContainer*) {}));
+
+        if (E_kin != nullptr) {
+            thermo.regulate_Temperature(*E_kin);
+        } else {
+            thermo.regulate_Temperature();
+        }
+    };
+
+    const double tracked_E_kin = tracked.get_kinetic_energy();
+    regulate(tracked.get_container(), &tracked_E_kin);
+    regulate(separate.get_container(), nullptr);
+
+    for (size_t i = 0; i < particles.size(); i++) {
+        EXPECT_EQ(tracked.get_container().begin()[i].getV(), separate.get_container().begin()[i].getV())
+            << "Both thermostat applications must scale the velocities equally.";
+    }
+}
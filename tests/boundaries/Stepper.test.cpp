@@ -2,7 +2,10 @@
 #include <boundaries/GhostBoundary.h>
 #include <boundaries/HardBoundary.h>
 #include <boundaries/NoBoundary.h>
+#include <boundaries/PeriodicBoundary.h>
 #include <boundaries/Stepper.h>
+#include <container/BoxContainer.h>
+#include <container/DomainDecomposition.h>
 #include <gtest/gtest.h>
 #include <physicsCalculator/GravityCalculator.h>
 #include <physicsCalculator/LJCalculator.h>
@@ -1013,3 +1016,277 @@ TEST(Stepper, PeriodicHard) {
         total_time += 0.0001;
     }
 }
+
+// Test if the verlet lists produce the same trajectories as rebuilding the linked cells every step.
+TEST(Stepper, VerletPeriodic) {
+    // Set the margin for the maximum floatingpoint error (the pairs are summed in a different order)
+    const double error_margin = 1E-4;
+
+    // Initialize the simulation environment
+    const char* argv[] = {
+        "./MolSim",
+        "path/to/input.txt",
+        "-delta_t=0.0005",
+        "-sigma=1.0",
+        "-epsilon=5.0",
+    };
+
+    constexpr int argc = sizeof(argv) / sizeof(argv[0]);
+    Environment env;
+
+    ASSERT_NO_THROW(env = Environment(argc, argv));
+    env.set_r_cutoff(2.5);
+    env.set_domain_size({ 15.0, 15.0, 15.0 });
+
+    ParticleGenerator gen;
+
+    // Initialize the calculators, one of them using the verlet lists
+    physicsCalculator::LJCalculator calc(env, {}, {}, false, false);
+    calc.get_container().resize(343);
+    gen.generateCuboid(calc.get_container(), 0, { 0.5, 0.5, 0.5 }, { 0.0, 0.0, 0.0 }, 0, { 7, 7, 7 }, 1.15, 2.0, 3);
+    calc.get_container().build_type_table({ TypeDesc { 1.0, 1.0, 5.0, 0.0005, 0.0 } });
+    calc.get_container().update_positions();
+
+    std::vector<Particle> particles(calc.get_container().begin(), calc.get_container().end());
+
+    env.set_skin(0.4);
+    physicsCalculator::LJCalculator calc_verlet(env, particles, { TypeDesc { 1.0, 1.0, 5.0, 0.0005, 0.0 } }, false, false);
+
+    Stepper stepper({ PERIODIC, HARD, PERIODIC, PERIODIC, HALO, PERIODIC }, { 15.0, 15.0, 15.0 });
+    Stepper stepper_verlet({ PERIODIC, HARD, PERIODIC, PERIODIC, HALO, PERIODIC }, { 15.0, 15.0, 15.0 });
+
+    for (size_t i = 0; i < 500; i++) {
+        stepper.step(calc);
+        stepper_verlet.step(calc_verlet);
+    }
+
+    ASSERT_EQ(calc.get_container().size(), calc_verlet.get_container().size()) << "The verlet lists must not change the particle count.";
+
+    for (size_t i = 0; i < calc.get_container().size(); i++) {
+        EXPECT_LT((calc.get_container()[i].getX() - calc_verlet.get_container()[i].getX()).len(), error_margin)
+            << "The verlet lists changed the trajectory of particle " << i;
+    }
+
+    EXPECT_LT(dynamic_cast<BoxContainer&>(calc_verlet.get_container()).get_verlet_builds(), 250)
+        << "The verlet lists should be reused for multiple steps.";
+}
+
+/**
+ * Perform a step using the separate passes, which the stepper fused into its integrator passes: calculateX, the postX boundaries, calculateOldF,
+ * the force calculation, the postF boundaries, the periodic pairs and calculateV.
+ *
+ * @param calc The calculator using the linked cells.
+ * @param bc The boundaries of the six faces.
+ * @param periodic An array storing for every direction if the domain is periodic along it.
+ */
+static void separate_step(physicsCalculator::Calculator& calc, const std::vector<std::unique_ptr<Boundary>>& bc, const std::array<bool, 3>& periodic) {
+    calc.calculateX();
+
+    for (Particle& p : calc.get_container()) {
+        for (const std::unique_ptr<Boundary>& b : bc) {
+            b->postX(p);
+        }
+    }
+
+    calc.get_container().update_positions();
+
+    calc.calculateOldF();
+    calc.calculateF();
+
+    for (Particle& p : calc.get_container()) {
+        for (const std::unique_ptr<Boundary>& b : bc) {
+            b->postF(p, calc);
+        }
+    }
+
+    dynamic_cast<BoxContainer&>(calc.get_container())
+        .for_each_periodic_pair(
+            [&calc](Particle& p1, Particle& p2, const Vec<double>& arr, const double dist) {
+                const double force = calc.calculateFAbs(p1, p2, dist);
+
+                p1.setF(-force * arr + p1.getF());
+                p2.setF(force * arr + p2.getF());
+            },
+            periodic);
+
+    calc.calculateV();
+}
+
+// Test if the fused integrator passes produce the same trajectories as the separate passes, for multiple types with gravity.
+TEST(Stepper, FusedPasses) {
+    // Set the margin for the maximum floatingpoint error (the halo forces are added after the periodic pairs instead of before them)
+    const double error_margin = 1E-9;
+
+    // Initialize the simulation environment
+    const char* argv[] = {
+        "./MolSim",
+        "path/to/input.txt",
+        "-delta_t=0.0005",
+    };
+
+    constexpr int argc = sizeof(argv) / sizeof(argv[0]);
+    Environment env;
+
+    ASSERT_NO_THROW(env = Environment(argc, argv));
+    env.set_r_cutoff(2.5);
+    env.set_domain_size({ 12.0, 12.0, 12.0 });
+
+    ParticleGenerator gen;
+
+    // Fill the domain with two types, such that the particles reach the periodic, the reflecting and the halo boundaries (the lower layer starts
+    // within the range of the halo boundary)
+    physicsCalculator::LJCalculator calc(env, {}, {}, false, false);
+    calc.get_container().resize(2 * 250);
+    gen.generateCuboid(calc.get_container(), 0, { 0.6, 0.6, 0.5 }, { 0.0, 0.0, 0.0 }, 0, { 10, 5, 5 }, 1.15, 2.0, 3);
+    gen.generateCuboid(calc.get_container(), 250, { 0.6, 6.4, 6.4 }, { 0.0, 0.0, 0.0 }, 1, { 10, 5, 5 }, 1.15, 2.0, 3);
+
+    const std::vector<Particle> particles(calc.get_container().begin(), calc.get_container().end());
+    const std::vector<TypeDesc> ptypes = { TypeDesc { 1.0, 1.0, 5.0, 0.0005, -12.44 }, TypeDesc { 2.0, 1.1, 1.0, 0.0005, -12.44 } };
+
+    physicsCalculator::LJCalculator calc_fused(env, particles, ptypes, true, false);
+    physicsCalculator::LJCalculator calc_separate(env, particles, ptypes, true, false);
+
+    const std::array<BoundaryType, 6> bt = { PERIODIC, HARD, HALO, PERIODIC, HARD, HALO };
+    Stepper stepper(bt, env.get_domain_size());
+
+    std::vector<std::unique_ptr<Boundary>> bc;
+    bc.push_back(std::make_unique<PeriodicBoundary>(0.0, 0));
+    bc.push_back(std::make_unique<HardBoundary>(0.0, 1));
+    bc.push_back(std::make_unique<GhostBoundary>(0.0, 2));
+    bc.push_back(std::make_unique<PeriodicBoundary>(12.0, 0));
+    bc.push_back(std::make_unique<HardBoundary>(12.0, 1));
+    bc.push_back(std::make_unique<GhostBoundary>(12.0, 2));
+
+    for (size_t i = 0; i < 200; i++) {
+        stepper.step(calc_fused);
+        separate_step(calc_separate, bc, { true, false, false });
+    }
+
+    ASSERT_EQ(calc_fused.get_container().size(), calc_separate.get_container().size()) << "The fused passes must not change the particle count.";
+
+    for (size_t i = 0; i < calc_fused.get_container().size(); i++) {
+        const Particle& fused = calc_fused.get_container()[i];
+        const Particle& separate = calc_separate.get_container()[i];
+
+        EXPECT_LT((fused.getX() - separate.getX()).len(), error_margin) << "The fused passes changed the position of particle " << i;
+        EXPECT_LT((fused.getV() - separate.getV()).len(), error_margin) << "The fused passes changed the velocity of particle " << i;
+        EXPECT_LT((fused.getF() - separate.getF()).len(), error_margin * std::max(separate.getF().len(), 1.0))
+            << "The fused passes changed the force of particle " << i;
+        EXPECT_LT((fused.getOldF() - separate.getOldF()).len(), error_margin * std::max(separate.getOldF().len(), 1.0))
+            << "The fused passes changed the old force of particle " << i;
+    }
+}
+
+// Test if the periodic ghost particles produce the same trajectories as the periodic pair loops.
+TEST(Stepper, GhostPeriodic) {
+    // Set the margin for the maximum floatingpoint error (the pairs are summed in a different order)
+    const double error_margin = 1E-4;
+
+    // Initialize the simulation environment
+    const char* argv[] = {
+        "./MolSim",
+        "path/to/input.txt",
+        "-delta_t=0.0005",
+        "-sigma=1.0",
+        "-epsilon=5.0",
+    };
+
+    constexpr int argc = sizeof(argv) / sizeof(argv[0]);
+    Environment env;
+
+    ASSERT_NO_THROW(env = Environment(argc, argv));
+    env.set_r_cutoff(2.5);
+    env.set_domain_size({ 10.0, 10.0, 10.0 });
+
+    ParticleGenerator gen;
+
+    // Fill the domain, such that particles interact across all periodic boundaries, edges and corners
+    physicsCalculator::LJCalculator calc(env, {}, {}, false, false);
+    calc.get_container().resize(512);
+    gen.generateCuboid(calc.get_container(), 0, { 0.6, 0.6, 0.6 }, { 0.0, 0.0, 0.0 }, 0, { 8, 8, 8 }, 1.25, 2.0, 3);
+    calc.get_container().build_type_table({ TypeDesc { 1.0, 1.0, 5.0, 0.0005, 0.0 } });
+    calc.get_container().update_positions();
+
+    std::vector<Particle> particles(calc.get_container().begin(), calc.get_container().end());
+
+    for (const std::array<BoundaryType, 6>& boundaries : {
+             std::array<BoundaryType, 6> { PERIODIC, PERIODIC, PERIODIC, PERIODIC, PERIODIC, PERIODIC },
+             std::array<BoundaryType, 6> { PERIODIC, HARD, PERIODIC, PERIODIC, HALO, PERIODIC },
+         }) {
+        physicsCalculator::LJCalculator calc_loops(env, particles, { TypeDesc { 1.0, 1.0, 5.0, 0.0005, 0.0 } }, false, false);
+        physicsCalculator::LJCalculator calc_ghosts(env, particles, { TypeDesc { 1.0, 1.0, 5.0, 0.0005, 0.0 } }, false, false);
+
+        Stepper stepper(boundaries, { 10.0, 10.0, 10.0 });
+        Stepper stepper_ghosts(boundaries, { 10.0, 10.0, 10.0 }, true);
+
+        for (size_t i = 0; i < 200; i++) {
+            stepper.step(calc_loops);
+            stepper_ghosts.step(calc_ghosts);
+        }
+
+        ASSERT_EQ(calc_loops.get_container().size(), calc_ghosts.get_container().size()) << "The ghost particles must be removed after every step.";
+
+        for (size_t i = 0; i < calc_loops.get_container().size(); i++) {
+            EXPECT_LT((calc_loops.get_container()[i].getX() - calc_ghosts.get_container()[i].getX()).len(), error_margin)
+                << "The ghost particles changed the trajectory of particle " << i;
+        }
+    }
+}
+
+// Test if a distributed simulation with a single rank produces the same trajectories as the periodic ghost particles.
+TEST(Stepper, DistributedSingleRank) {
+    // Set the margin for the maximum floatingpoint error
+    const double error_margin = 1E-9;
+
+    // Initialize the simulation environment
+    const char* argv[] = {
+        "./MolSim",
+        "path/to/input.txt",
+        "-delta_t=0.0005",
+        "-sigma=1.0",
+        "-epsilon=5.0",
+    };
+
+    constexpr int argc = sizeof(argv) / sizeof(argv[0]);
+    Environment env;
+
+    ASSERT_NO_THROW(env = Environment(argc, argv));
+    env.set_r_cutoff(2.5);
+    env.set_domain_size({ 10.0, 10.0, 10.0 });
+
+    ParticleGenerator gen;
+
+    physicsCalculator::LJCalculator calc(env, {}, {}, false, false);
+    calc.get_container().resize(512);
+    gen.generateCuboid(calc.get_container(), 0, { 0.6, 0.6, 0.6 }, { 0.0, 0.0, 0.0 }, 0, { 8, 8, 8 }, 1.25, 2.0, 3);
+    calc.get_container().build_type_table({ TypeDesc { 1.0, 1.0, 5.0, 0.0005, 0.0 } });
+    calc.get_container().update_positions();
+
+    std::vector<Particle> particles(calc.get_container().begin(), calc.get_container().end());
+
+    for (const std::array<BoundaryType, 6>& boundaries : {
+             std::array<BoundaryType, 6> { PERIODIC, PERIODIC, PERIODIC, PERIODIC, PERIODIC, PERIODIC },
+             std::array<BoundaryType, 6> { PERIODIC, HARD, OUTFLOW, PERIODIC, HALO, OUTFLOW },
+         }) {
+        env.set_boundary_type(boundaries);
+
+        physicsCalculator::LJCalculator calc_ghosts(env, particles, { TypeDesc { 1.0, 1.0, 5.0, 0.0005, 0.0 } }, false, false);
+        physicsCalculator::LJCalculator calc_dist(env, particles, { TypeDesc { 1.0, 1.0, 5.0, 0.0005, 0.0 } }, false, false);
+
+        DomainDecomposition decomposition(env);
+        Stepper stepper_ghosts(boundaries, { 10.0, 10.0, 10.0 }, true);
+        Stepper stepper_dist(decomposition);
+
+        for (size_t i = 0; i < 200; i++) {
+            stepper_ghosts.step(calc_ghosts);
+            stepper_dist.step(calc_dist);
+        }
+
+        ASSERT_EQ(calc_ghosts.get_container().size(), calc_dist.get_container().size()) << "The distributed mode must not lose particles.";
+
+        for (size_t i = 0; i < calc_ghosts.get_container().size(); i++) {
+            EXPECT_LT((calc_ghosts.get_container()[i].getX() - calc_dist.get_container()[i].getX()).len(), error_margin)
+                << "The distributed mode changed the trajectory of particle " << i;
+        }
+    }
+}
@@ -103,3 +103,278 @@ TEST(BoxContainer, UpdatePosition) {
 
     EXPECT_TRUE(pairs.size() == 0) << "The pair size should be 0 but it was " << pairs.size();
 }
+
+// Test if update position only rebuilds the verlet lists when required
+TEST(BoxContainer, UpdatePositionVerlet) {
+    std::vector<Particle> particles = {
+        Particle({ 1.0, 1.0, 0.5 }, {}, 1),
+        Particle({ 2.5, 1.0, 0.5 }, {}, 2),
+        Particle({ 19.0, 19.0, 0.5 }, {}, 3),
+    };
+
+    BoxContainer box = BoxContainer(particles, 2.0, { 40.0, 40.0, 10.0 }, {}, 1.0);
+
+    EXPECT_EQ(box.get_verlet_builds(), 1) << "The verlet lists must be built by the constructor.";
+
+    size_t count = 0;
+    box.iterate_pairs([&count](Particle& p1, Particle& p2) { count++; });
+    EXPECT_EQ(count, 1) << "Only the first two particles are within the cutoff.";
+
+    // Small displacements must reuse the lists
+    box[0].setX({ 1.2, 1.0, 0.5 });
+    box.update_positions();
+    EXPECT_EQ(box.get_verlet_builds(), 1) << "The verlet lists must not be rebuilt for small displacements.";
+
+    // Large displacements must rebuild the lists
+    box[2].setX({ 2.0, 2.0, 0.5 });
+    box.update_positions();
+    EXPECT_EQ(box.get_verlet_builds(), 2) << "The verlet lists must be rebuilt for large displacements.";
+
+    count = 0;
+    box.iterate_pairs([&count](Particle& p1, Particle& p2) { count++; });
+    EXPECT_EQ(count, 3) << "All particles are within the cutoff after the update.";
+}
+
+// Test if the reordering keeps the particles and their pairs intact
+TEST(BoxContainer, UpdatePositionReorder) {
+    std::vector<Particle> particles = {
+        Particle({ 19.0, 19.0, 0.5 }, {}, 1),
+        Particle({ 1.0, 1.0, 0.5 }, {}, 2),
+        Particle({ 19.5, 19.0, 0.5 }, {}, 3),
+        Particle({ 1.5, 1.0, 0.5 }, {}, 4),
+    };
+
+    BoxContainer box = BoxContainer(particles, 2.0, { 40.0, 40.0, 10.0 }, {}, 0.0, true);
+
+    ASSERT_EQ(box.size(), 4) << "The reordering must not change the number of particles.";
+    EXPECT_EQ(box[0].getType(), 2) << "The particles must be stored in the order of their cells.";
+    EXPECT_EQ(box[1].getType(), 4) << "The particles must be stored in the order of their cells.";
+    EXPECT_EQ(box[2].getType(), 1) << "The particles must be stored in the order of their cells.";
+    EXPECT_EQ(box[3].getType(), 3) << "The particles must be stored in the order of their cells.";
+
+    // Move the first particle next to the other particles
+    box[0].setX({ 20.0, 19.0, 0.5 });
+    box.update_positions();
+
+    EXPECT_EQ(box[0].getType(), 4) << "The particles must be reordered after the update.";
+    EXPECT_EQ(box[3].getType(), 2) << "The particles must be reordered after the update.";
+
+    size_t count = 0;
+    box.iterate_pairs([&count](Particle& p1, Particle& p2) { count++; });
+    EXPECT_EQ(count, 3) << "The three particles at the far corner must be neighbors.";
+}
+
+// Test if the cells and verlet lists are rebuilt after sorting the particles
+TEST(BoxContainer, SortParticles) {
+    std::vector<Particle> particles = {
+        Particle({ 19.0, 19.0, 0.5 }, {}, 1),
+        Particle({ 1.0, 1.0, 0.5 }, {}, 2),
+        Particle({ 19.5, 19.0, 0.5 }, {}, 3),
+        Particle({ 1.5, 1.0, 0.5 }, {}, 4),
+    };
+
+    BoxContainer box = BoxContainer(particles, 2.0, { 40.0, 40.0, 10.0 }, {}, 1.0);
+
+    box.sort_particles(2.0);
+
+    EXPECT_EQ(box[0].getType(), 2) << "The particles must be sorted along the Morton curve.";
+    EXPECT_EQ(box[3].getType(), 3) << "The particles must be sorted along the Morton curve.";
+    EXPECT_EQ(box.get_verlet_builds(), 2) << "The verlet lists must be rebuilt after sorting.";
+
+    box.iterate_pairs([](Particle& p1, Particle& p2) {
+        EXPECT_EQ(std::abs(p1.getType() - p2.getType()), 2) << "The pairs must not change by sorting the particles.";
+    });
+}
+
+// Test if moving the pages of the particles and the cells to the threads keeps the particles and their pairs
+TEST(BoxContainer, FirstTouch) {
+    std::vector<Particle> particles;
+
+    for (size_t i = 0; i < 4000; i++) {
+        particles.push_back(Particle({ 0.5 + static_cast<double>(i % 20), 0.5 + static_cast<double>(i / 20 % 20), 0.05 + 0.1 * (i / 400) }, {}, 0));
+    }
+
+    BoxContainer box = BoxContainer(particles, 1.0, { 20.0, 20.0, 1.0 }, { TypeDesc { 1.0, 1.0, 1.0, 0.1, 0.0 } });
+    size_t pairs = 0;
+    box.iterate_pairs([&pairs](Particle&, Particle&) { pairs++; });
+
+    box.first_touch(true);
+
+    for (size_t i = 0; i < particles.size(); i++) {
+        ASSERT_EQ(box[i], particles[i]) << "The particles must not change by moving their pages.";
+    }
+
+    size_t touched_pairs = 0;
+    box.iterate_pairs([&touched_pairs](Particle&, Particle&) { touched_pairs++; });
+    EXPECT_EQ(touched_pairs, pairs) << "The cells must not change by moving their pages.";
+}
+
+// Test if the sorting keeps the pages placed by the first touch, while a growing number of particles requires placing them again
+TEST(BoxContainer, KeepPlacement) {
+    std::vector<Particle> particles;
+
+    for (size_t i = 0; i < 1000; i++) {
+        particles.push_back(Particle({ 9.5 - static_cast<double>(i % 10), 9.5 - static_cast<double>(i / 10 % 10), 0.05 + 0.1 * (i / 100) }, {}, 0));
+    }
+
+    BoxContainer box = BoxContainer(particles, 1.0, { 10.0, 10.0, 1.0 }, { TypeDesc { 1.0, 1.0, 1.0, 0.1, 0.0 } }, 0.0, true);
+    EXPECT_FALSE(box.is_placed()) << "The particles must not be placed before the first touch.";
+
+    box.first_touch(false);
+    const Particle* data = &box[0];
+    EXPECT_TRUE(box.is_placed()) << "The particles must be placed by the first touch.";
+
+    box.sort_particles(1.0);
+    box.update_positions();
+
+    EXPECT_EQ(&box[0], data) << "The sorting must keep the allocation of the particles.";
+    EXPECT_TRUE(box.is_placed()) << "The sorted particles must keep their pages.";
+    EXPECT_FALSE(box[0].getX() == particles[0].getX()) << "The particles must be sorted.";
+
+    // The ghost particles exceed the capacity of the particle vector
+    box.create_ghosts({ true, true, false });
+    box.fold_ghost_forces();
+    EXPECT_FALSE(box.is_placed()) << "The reallocated particles must be placed again.";
+
+    box.first_touch(false);
+    EXPECT_TRUE(box.is_placed()) << "The particles must be placed by the first touch.";
+}
+
+// Test if the ghost particles cover the interactions across the periodic boundaries exactly once
+TEST(BoxContainer, PeriodicGhosts) {
+    std::vector<Particle> particles = {
+        Particle({ 0.5, 0.5, 0.5 }, {}, 0),
+        Particle({ 9.5, 9.5, 9.5 }, {}, 0),
+        Particle({ 5.0, 0.2, 5.0 }, {}, 0),
+        Particle({ 5.0, 9.9, 5.0 }, {}, 0),
+        Particle({ 5.0, 5.0, 5.0 }, {}, 0),
+    };
+
+    BoxContainer box = BoxContainer(particles, 2.0, { 10.0, 10.0, 10.0 }, {});
+    box.create_ghosts({ true, true, true });
+
+    // The corner particles have 7 images each, the particles at the y boundary have one image each
+    EXPECT_EQ(box.get_ghost_count(), 16) << "The number of ghost particles is wrong.";
+    EXPECT_EQ(box.size(), 21) << "The ghost particles must be appended to the particles.";
+
+    // Count the interactions using the minimal image of every pair
+    std::vector<std::pair<size_t, size_t>> pairs;
+
+    box.for_each_candidate_pair([&box, &pairs](const size_t i, const size_t j) {
+        if ((box[i].getX() - box[j].getX()).len_squ() <= 4.0) {
+            pairs.push_back({ i, j });
+        }
+    });
+
+    EXPECT_EQ(pairs.size(), 2) << "Only the corner particles and the y boundary particles interact through the periodic boundaries.";
+
+    box.for_each_pair([](Particle& p1, Particle& p2) {
+        const Vec<double> diff = p2.getX() - p1.getX();
+        p1.setF(p1.getF() + diff);
+        p2.setF(p2.getF() - diff);
+    });
+
+    box.fold_ghost_forces();
+
+    EXPECT_EQ(box.size(), 5) << "The ghost particles must be removed.";
+    EXPECT_LT((box[0].getF() - Vec<double>(-1.0, -1.0, -1.0)).len(), 1E-9) << "The force must be folded back onto the owner.";
+    EXPECT_LT((box[1].getF() - Vec<double>(1.0, 1.0, 1.0)).len(), 1E-9) << "The force must be folded back onto the owner.";
+    EXPECT_LT((box[2].getF() - Vec<double>(0.0, -0.3, 0.0)).len(), 1E-9) << "The force must be folded back onto the owner.";
+    EXPECT_LT((box[3].getF() - Vec<double>(0.0, 0.3, 0.0)).len(), 1E-9) << "The force must be folded back onto the owner.";
+    EXPECT_LT(box[4].getF().len(), 1E-9) << "The particle in the center does not interact.";
+}
+
+// Test if the ghost particles of other subdomains interact with the own particles, while their forces are discarded.
+TEST(BoxContainer, RemoteGhosts) {
+    std::vector<Particle> particles = {
+        Particle({ 0.5, 5.0, 5.0 }, {}, 0),
+        Particle({ 9.5, 5.0, 5.0 }, {}, 0),
+    };
+
+    BoxContainer box = BoxContainer(particles, 2.0, { 10.0, 10.0, 10.0 }, {});
+    box.begin_ghosts();
+    box.add_remote_ghost(Particle({ -0.5, 5.0, 5.0 }, {}, 0));
+    box.add_remote_ghost(Particle({ 10.5, 5.0, 5.0 }, {}, 0));
+    box.finish_ghosts();
+
+    EXPECT_EQ(box.get_ghost_count(), 2) << "The number of ghost particles is wrong.";
+
+    size_t pairs = 0;
+
+    box.for_each_pair([&pairs](Particle& p1, Particle& p2) {
+        const Vec<double> diff = p2.getX() - p1.getX();
+        p1.setF(p1.getF() + diff);
+        p2.setF(p2.getF() - diff);
+        pairs++;
+    });
+
+    EXPECT_EQ(pairs, 2) << "Every own particle must interact with the neighboring remote ghost particle.";
+
+    box.fold_ghost_forces();
+
+    EXPECT_EQ(box.size(), 2) << "The ghost particles must be removed.";
+    EXPECT_LT((box[0].getF() - Vec<double>(-1.0, 0.0, 0.0)).len(), 1E-9) << "The force of the remote ghost must act on the own particle.";
+    EXPECT_LT((box[1].getF() - Vec<double>(1.0, 0.0, 0.0)).len(), 1E-9) << "The force of the remote ghost must act on the own particle.";
+}
+
+// Test if the pair traversals pass the displacement and the squared distance of their cutoff test, for the linked cells and the verlet lists
+TEST(BoxContainer, IteratePairsDisplacement) {
+    std::vector<Particle> particles;
+
+    for (size_t i = 0; i < 64; i++) {
+        particles.push_back(Particle({ 0.3 + 1.3 * (i % 4) + 0.1 * (i / 16), 0.4 + 1.1 * (i / 4 % 4), 0.5 + 0.9 * (i / 16) }, {}, 0));
+    }
+
+    // Count the pairs within the cutoff distance by comparing all pairs
+    size_t expected = 0;
+
+    for (size_t i = 0; i < particles.size(); i++) {
+        for (size_t j = i + 1; j < particles.size(); j++) {
+            expected += (particles[i].getX() - particles[j].getX()).len_squ() <= 4.0;
+        }
+    }
+
+    for (const double skin : { 0.0, 1.0 }) {
+        BoxContainer box = BoxContainer(particles, 2.0, { 6.0, 6.0, 4.0 }, {}, skin);
+
+        size_t count = 0;
+        box.iterate_pairs([&count](Particle& p1, Particle& p2, const Vec<double>& diff, const double dist_squ) {
+            EXPECT_EQ(diff, p1.getX() - p2.getX()) << "The displacement must point from the second to the first particle.";
+            EXPECT_EQ(dist_squ, diff.len_squ()) << "The squared distance must belong to the displacement.";
+            EXPECT_LE(dist_squ, 4.0) << "Only the pairs within the cutoff distance must be visited.";
+            count++;
+        });
+
+        EXPECT_EQ(count, expected) << "The displacement traversal must visit all pairs within the cutoff distance.";
+    }
+}
+
+// Test if the periodic pair traversal passes the displacement to the periodic image of the first particle
+TEST(BoxContainer, PeriodicDisplacement) {
+    std::vector<Particle> particles = {
+        Particle({ 0.5, 0.5, 0.5 }, {}, 0),
+        Particle({ 9.5, 9.5, 9.5 }, {}, 1),
+        Particle({ 5.0, 0.2, 5.0 }, {}, 2),
+        Particle({ 5.0, 9.9, 5.0 }, {}, 3),
+        Particle({ 0.1, 5.0, 9.7 }, {}, 4),
+        Particle({ 5.0, 5.0, 5.0 }, {}, 5),
+    };
+
+    BoxContainer box = BoxContainer(particles, 2.0, { 10.0, 10.0, 10.0 }, {});
+
+    size_t count = 0;
+    box.for_each_periodic_pair(
+        [&count](Particle& p1, Particle& p2, const Vec<double>& diff, const double dist_squ) {
+            const Vec<double> shift = diff - (p1.getX() - p2.getX());
+
+            for (int d = 0; d < 3; d++) {
+                EXPECT_NEAR(std::abs(shift[d]), shift[d] == 0.0 ? 0.0 : 10.0, 1E-9) << "The shift must move the first particle to its image.";
+            }
+
+            EXPECT_EQ(dist_squ, diff.len_squ()) << "The squared distance must belong to the displacement.";
+            count++;
+        },
+        { true, true, true });
+
+    EXPECT_EQ(count, 2) << "Only the corner particles and the y boundary particles interact through the periodic boundaries.";
+}
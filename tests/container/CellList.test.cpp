@@ -1,7 +1,9 @@
+#include <algorithm>
 #include <container/CellList.h>
 #include <gtest/gtest.h>
 #include <tuple>
 #include <utils/ArrayUtils.h>
+#include <utils/Threads.h>
 
 // Test if the loop pair method works correctly for a no particles
 TEST(CellList, LoopPairsNoParticle) {
@@ -148,6 +150,57 @@ TEST(CellList, ConstructorGetter) {
     EXPECT_LT((cells.get_corner_vector() - corner).len(), 1E-9) << "The corner vector must be computed correctly.";
 }
 
+// Test if no pair within the cutoff distance is missed, if the domain is not a multiple of the cutoff distance
+TEST(CellList, NonMultipleDomain) {
+    std::vector<Particle> particles;
+
+    for (size_t i = 0; i < 9; i++) {
+        for (size_t j = 0; j < 13; j++) {
+            for (size_t k = 0; k < 10; k++) {
+                particles.push_back(Particle({ 0.1 + 0.65 * i + 0.01 * j, 0.2 + 0.68 * j + 0.02 * k, 0.15 + 0.67 * k + 0.03 * i }, {}, 0));
+            }
+        }
+    }
+
+    // Rounding the number of cells up would place this pair into the first and the third cell along the x axis, which are not neighbors
+    particles.push_back(Particle({ 1.9, 4.45, 3.05 }, {}, 0));
+    particles.push_back(Particle({ 4.1, 4.45, 3.05 }, {}, 0));
+
+    size_t expected = 0;
+
+    for (size_t i = 0; i < particles.size(); i++) {
+        for (size_t j = i + 1; j < particles.size(); j++) {
+            if ((particles[i].getX() - particles[j].getX()).len_squ() <= 6.25) {
+                expected++;
+            }
+        }
+    }
+
+    for (const double skin : { 0.0, 0.3 }) {
+        for (size_t sub_cells = 1; sub_cells <= 2; sub_cells++) {
+            CellList cells(2.5, { 6.0, 9.0, 7.0 }, skin, sub_cells);
+            ASSERT_NO_THROW(cells.create_list(particles));
+
+            const Vec<double> cell_size = cells.get_cell_size();
+
+            for (size_t d = 0; d < 3; d++) {
+                EXPECT_GE(cell_size[d], (2.5 + skin) / static_cast<double>(sub_cells))
+                    << "The cells must not be smaller than the cutoff distance plus the skin divided by the number of sub cells.";
+            }
+
+            size_t visited = 0;
+
+            cells.for_each_candidate_pair([&particles, &visited](const size_t i, const size_t j) {
+                if ((particles[i].getX() - particles[j].getX()).len_squ() <= 6.25) {
+                    visited++;
+                }
+            });
+
+            EXPECT_EQ(visited, expected) << "The cells with " << sub_cells << " sub cells must visit every pair within the cutoff distance.";
+        }
+    }
+}
+
 // Test that the create list method works correctly
 TEST(CellList, CreateList) {
     CellList cells(2.0, { 40.0, 30.0, 31.0 });
@@ -923,3 +976,515 @@ TEST(CellList, IterateXYCell) {
 
     EXPECT_EQ(pairs.size(), 0) << "The pair size should be 0 but it was " << pairs.size();
 }
+
+// Test that the particles are stored contiguously in the order of their cells after reordering
+TEST(CellList, ReorderParticles) {
+    CellList cells(2.0, { 40.0, 30.0, 31.0 });
+    std::vector<Particle> particles = {
+        Particle({ 25.0, 25.0, 25.0 }, {}, 1),
+        Particle({ 1.0, 1.0, 1.0 }, {}, 2),
+        Particle({ 25.5, 25.0, 25.0 }, {}, 3),
+        Particle({ 1.0, 1.0, 25.0 }, {}, 4),
+        Particle({ 1.5, 1.0, 1.0 }, {}, 5),
+    };
+
+    ASSERT_NO_THROW(cells.create_list(particles));
+
+    const CellRange first = cells.cell(cells.get_cell_index(1, 1, 1));
+    ASSERT_EQ(first.size(), 2) << "The first cell must contain two particles.";
+    EXPECT_EQ(*first.begin(), 1) << "The order within a cell must be stable.";
+    EXPECT_EQ(*(first.begin() + 1), 4) << "The order within a cell must be stable.";
+
+    ASSERT_NO_THROW(cells.reorder_particles(particles));
+
+    const std::vector<int> expected = { 2, 5, 4, 1, 3 };
+
+    for (size_t i = 0; i < particles.size(); i++) {
+        EXPECT_EQ(particles[i].getType(), expected[i]) << "The particles must be stored in the order of their cells.";
+    }
+
+    const CellRange last = cells.cell(cells.get_cell_index(13, 13, 13));
+    ASSERT_EQ(last.size(), 2) << "The last cell must contain two particles.";
+    EXPECT_EQ(*last.begin(), 3) << "The cell must point to the reordered particles.";
+    EXPECT_EQ(*(last.begin() + 1), 4) << "The cell must point to the reordered particles.";
+
+    size_t count = 0;
+    cells.loop_cell_pairs(
+        [&count](Particle& p1, Particle& p2) {
+            const std::tuple<int, int> pair = { std::min(p1.getType(), p2.getType()), std::max(p1.getType(), p2.getType()) };
+            EXPECT_TRUE(pair == std::make_tuple(2, 5) || pair == std::make_tuple(1, 3)) << "Only the particles in the same cells are neighbors.";
+            count++;
+        },
+        particles);
+
+    EXPECT_EQ(count, 2) << "The reordering must not change the pairs.";
+}
+
+// Test if the incremental update moves the particles into their new cells
+TEST(CellList, UpdateListIncremental) {
+    CellList cells(1.0, { 5.0, 4.0, 3.0 });
+    std::vector<Particle> particles;
+
+    // Place a particle into every cell
+    for (size_t i = 0; i < 5; i++) {
+        for (size_t j = 0; j < 4; j++) {
+            for (size_t k = 0; k < 3; k++) {
+                particles.push_back(Particle({ i + 0.5, j + 0.5, k + 0.5 }, {}, particles.size()));
+            }
+        }
+    }
+
+    ASSERT_NO_THROW(cells.create_list(particles));
+    EXPECT_EQ(cells.get_full_builds(), 1) << "The cell list must be built once.";
+
+    EXPECT_FALSE(cells.update_list(particles)) << "No particle changed its cell.";
+
+    // Move a particle forwards and a particle backwards through multiple cells
+    particles[3].setX({ 4.2, 3.2, 2.9 });
+    particles[50].setX({ 0.1, 0.2, 0.3 });
+
+    EXPECT_TRUE(cells.update_list(particles)) << "Two particles changed their cell.";
+    EXPECT_EQ(cells.get_full_builds(), 1) << "Two movers must not trigger a full rebuild.";
+
+    CellList expected(1.0, { 5.0, 4.0, 3.0 });
+    expected.create_list(particles);
+
+    for (size_t i = 0; i < 7; i++) {
+        for (size_t j = 0; j < 6; j++) {
+            for (size_t k = 0; k < 5; k++) {
+                const CellRange updated = cells.cell(cells.get_cell_index(i, j, k));
+                const CellRange built = expected.cell(expected.get_cell_index(i, j, k));
+
+                std::vector<size_t> a(updated.begin(), updated.end());
+                std::vector<size_t> b(built.begin(), built.end());
+                std::sort(a.begin(), a.end());
+
+                EXPECT_EQ(a, b) << "The incremental update must match the full build in cell (" << i << ", " << j << ", " << k << ").";
+            }
+        }
+    }
+
+    // Move all particles into the next cell, which requires a full rebuild
+    for (Particle& p : particles) {
+        p.setX(p.getX() + Vec<double>(0.0, 0.0, 0.1 - p.getX()[2]));
+    }
+
+    EXPECT_TRUE(cells.update_list(particles)) << "Many particles changed their cell.";
+    EXPECT_EQ(cells.get_full_builds(), 2) << "Many movers must trigger a full rebuild.";
+}
+
+// Test if a few movers crossing many cells trigger a full rebuild, since they would be swapped through every cell in between
+TEST(CellList, UpdateListDistantMovers) {
+    CellList cells(1.0, { 20.0, 20.0, 20.0 });
+    std::vector<Particle> particles;
+
+    for (size_t i = 0; i < 100; i++) {
+        particles.push_back(Particle({ 0.5, 0.5 + 0.19 * i, 10.5 }, {}, 0));
+    }
+
+    ASSERT_NO_THROW(cells.create_list(particles));
+
+    // A single mover crossing the domain along the x axis passes fewer cells than a full build visits
+    particles[0].setX({ 19.5, 0.5, 10.5 });
+
+    EXPECT_TRUE(cells.update_list(particles)) << "A particle changed its cell.";
+    EXPECT_EQ(cells.get_full_builds(), 1) << "A single mover must be moved incrementally.";
+
+    // Five movers are below the fraction of movers, but pass more cells than a full build visits
+    for (size_t i = 1; i < 6; i++) {
+        particles[i].setX(particles[i].getX() + Vec<double>(19.0, 0.0, 0.0));
+    }
+
+    EXPECT_TRUE(cells.update_list(particles)) << "Five particles changed their cell.";
+    EXPECT_EQ(cells.get_full_builds(), 2) << "Movers crossing many cells must trigger a full rebuild.";
+
+    // The cells have the size of the cutoff distance, the first inner cell follows the halo cell
+    for (size_t i = 0; i < particles.size(); i++) {
+        const Vec<double>& x = particles[i].getX();
+        const CellRange updated = cells.cell(cells.get_cell_index(
+            static_cast<size_t>(x[0]) + 1, static_cast<size_t>(x[1]) + 1, static_cast<size_t>(x[2]) + 1));
+
+        EXPECT_TRUE(std::find(updated.begin(), updated.end(), i) != updated.end()) << "Particle " << i << " must be stored in its new cell.";
+    }
+}
+
+// Test if the sub cells visit exactly the particle pairs within the cutoff distance
+TEST(CellList, SubCells) {
+    std::vector<Particle> particles;
+
+    // Place the particles on a skewed lattice, such that the pairs have many different distances
+    for (size_t i = 0; i < 9; i++) {
+        for (size_t j = 0; j < 8; j++) {
+            for (size_t k = 0; k < 7; k++) {
+                particles.push_back(Particle({ 0.1 + 1.05 * i + 0.03 * j, 0.2 + 1.1 * j + 0.07 * k, 0.3 + 1.15 * k + 0.05 * i }, {}, particles.size()));
+            }
+        }
+    }
+
+    size_t expected = 0;
+
+    for (size_t i = 0; i < particles.size(); i++) {
+        for (size_t j = i + 1; j < particles.size(); j++) {
+            if ((particles[i].getX() - particles[j].getX()).len_squ() <= 2.5 * 2.5) {
+                expected++;
+            }
+        }
+    }
+
+    for (size_t sub_cells = 1; sub_cells <= 3; sub_cells++) {
+        CellList cells(2.5, { 10.0, 10.0, 10.0 }, 0.0, sub_cells);
+        ASSERT_NO_THROW(cells.create_list(particles));
+        EXPECT_EQ(cells.get_sub_cells(), sub_cells) << "The getter for the sub cells returned a wrong value.";
+
+        size_t count = 0;
+        size_t candidates = 0;
+
+        cells.loop_cell_pairs([&count](Particle& p1, Particle& p2) { count++; }, particles);
+        cells.for_each_candidate_pair([&candidates](const size_t i, const size_t j) { candidates++; });
+
+        EXPECT_EQ(count, expected) << "The cells with " << sub_cells << " sub cells must visit every pair within the cutoff exactly once.";
+        EXPECT_GE(candidates, count) << "The candidate pairs must contain all pairs within the cutoff.";
+
+        size_t halo = 0;
+        size_t inner = 0;
+        cells.loop_halo([&halo](Particle& p) { halo++; }, particles);
+        cells.loop_inner([&inner](Particle& p) { inner++; }, particles);
+
+        EXPECT_EQ(halo, 0) << "All particles are within the domain.";
+        EXPECT_EQ(inner, particles.size()) << "All particles are within the domain.";
+    }
+}
+
+// Test if the two dimensional cells visit exactly the particle pairs within the cutoff distance
+TEST(CellList, TwoDimensions) {
+    std::vector<Particle> particles;
+
+    for (size_t i = 0; i < 9; i++) {
+        for (size_t j = 0; j < 8; j++) {
+            particles.push_back(Particle({ 0.1 + 1.05 * i + 0.03 * j, 0.2 + 1.1 * j + 0.07 * i, 3.75 }, {}, particles.size()));
+        }
+    }
+
+    size_t expected = 0;
+
+    for (size_t i = 0; i < particles.size(); i++) {
+        for (size_t j = i + 1; j < particles.size(); j++) {
+            if ((particles[i].getX() - particles[j].getX()).len_squ() <= 2.5 * 2.5) {
+                expected++;
+            }
+        }
+    }
+
+    for (size_t sub_cells = 1; sub_cells <= 2; sub_cells++) {
+        CellList cells_3d(2.5, { 10.0, 10.0, 7.5 }, 0.0, sub_cells, 3);
+        CellList cells_2d(2.5, { 10.0, 10.0, 7.5 }, 0.0, sub_cells, 2);
+        ASSERT_NO_THROW(cells_3d.create_list(particles));
+        ASSERT_NO_THROW(cells_2d.create_list(particles));
+        EXPECT_EQ(cells_2d.get_dimensions(), 2) << "The getter for the dimensions returned a wrong value.";
+
+        size_t count = 0;
+        cells_2d.loop_cell_pairs([&count](Particle& p1, Particle& p2) { count++; }, particles);
+        EXPECT_EQ(count, expected) << "The two dimensional cells must visit every pair within the cutoff exactly once.";
+
+        size_t candidates_3d = 0;
+        size_t candidates_2d = 0;
+        cells_3d.for_each_candidate_pair([&candidates_3d](const size_t i, const size_t j) { candidates_3d++; });
+        cells_2d.for_each_candidate_pair([&candidates_2d](const size_t i, const size_t j) { candidates_2d++; });
+        EXPECT_LE(candidates_2d, candidates_3d) << "The two dimensional cells must not visit more candidates.";
+    }
+}
+
+// Test if the colored traversal visits the same pairs as the sequential traversal
+TEST(CellList, ColoredTraversal) {
+    std::vector<Particle> particles;
+
+    // Place some particles into the halo as well, such that the ghost traversal visits them
+    for (size_t i = 0; i < 12; i++) {
+        for (size_t j = 0; j < 11; j++) {
+            for (size_t k = 0; k < 10; k++) {
+                particles.push_back(Particle({ -0.4 + 0.9 * i + 0.03 * j, -0.3 + 0.95 * j + 0.07 * k, -0.2 + 1.05 * k + 0.05 * i }, {}, 0));
+            }
+        }
+    }
+
+    const auto sorted_pair = [](const size_t i, const size_t j) { return std::make_pair(std::min(i, j), std::max(i, j)); };
+
+    for (size_t dimensions = 2; dimensions <= 3; dimensions++) {
+        for (size_t sub_cells = 1; sub_cells <= 2; sub_cells++) {
+            CellList cells(2.5, { 10.0, 10.0, 10.0 }, 0.0, sub_cells, dimensions);
+            ASSERT_NO_THROW(cells.create_list(particles));
+
+            const size_t reach = 2 * sub_cells + 1;
+            EXPECT_EQ(cells.get_colors(), (sub_cells + 1) * reach * (dimensions == 2 ? 1 : reach)) << "The number of colors is wrong.";
+
+            for (const bool ghosts : { false, true }) {
+                std::vector<std::pair<size_t, size_t>> expected;
+                std::vector<std::pair<size_t, size_t>> visited;
+
+                const auto sequential = [&expected, &sorted_pair](const size_t i, const size_t j) { expected.push_back(sorted_pair(i, j)); };
+
+                if (ghosts) {
+                    cells.for_each_ghost_candidate_pair(sequential);
+                } else {
+                    cells.for_each_candidate_pair(sequential);
+                }
+
+                cells.for_each_colored_candidate_pair(
+                    [&visited, &sorted_pair](const size_t i, const size_t j) {
+#pragma omp critical
+                        visited.push_back(sorted_pair(i, j));
+                    },
+                    ghosts);
+
+                std::sort(expected.begin(), expected.end());
+                std::sort(visited.begin(), visited.end());
+                EXPECT_FALSE(expected.empty());
+                EXPECT_EQ(visited, expected) << "The colored traversal must visit the same pairs (dimensions " << dimensions << ", sub cells "
+                                             << sub_cells << ", ghosts " << ghosts << ").";
+            }
+        }
+    }
+}
+
+// Test if the task based traversals visit the same pairs as the sequential traversal
+TEST(CellList, TaskTraversal) {
+    std::vector<Particle> particles;
+
+    // Place a dense blob into a corner of an otherwise empty domain and some particles into the halo
+    for (size_t i = 0; i < 10; i++) {
+        for (size_t j = 0; j < 9; j++) {
+            for (size_t k = 0; k < 8; k++) {
+                particles.push_back(Particle({ -0.4 + 0.5 * i + 0.03 * j, -0.3 + 0.55 * j + 0.07 * k, -0.2 + 0.6 * k + 0.05 * i }, {}, 0));
+            }
+        }
+    }
+
+    particles.push_back(Particle({ 18.0, 18.0, 18.0 }, {}, 0));
+    particles.push_back(Particle({ 18.5, 18.5, 18.5 }, {}, 0));
+
+    const auto sorted_pair = [](const size_t i, const size_t j) { return std::make_pair(std::min(i, j), std::max(i, j)); };
+
+    for (size_t dimensions = 2; dimensions <= 3; dimensions++) {
+        CellList cells(2.5, { 20.0, 20.0, 20.0 }, 0.0, 1, dimensions);
+        ASSERT_NO_THROW(cells.create_list(particles));
+        cells.set_tasks(true);
+
+        for (const bool ghosts : { false, true }) {
+            std::vector<std::pair<size_t, size_t>> expected;
+            std::vector<std::pair<size_t, size_t>> colored;
+            std::vector<std::pair<size_t, size_t>> distributed;
+
+            const auto sequential = [&expected, &sorted_pair](const size_t i, const size_t j) { expected.push_back(sorted_pair(i, j)); };
+
+            if (ghosts) {
+                cells.for_each_ghost_candidate_pair(sequential);
+            } else {
+                cells.for_each_candidate_pair(sequential);
+            }
+
+            cells.for_each_colored_candidate_pair(
+                [&colored, &sorted_pair](const size_t i, const size_t j) {
+#pragma omp critical
+                    colored.push_back(sorted_pair(i, j));
+                },
+                ghosts);
+
+            EXPECT_GT(cells.get_task_blocks(), 0) << "The colored traversal must create blocks.";
+
+#pragma omp parallel
+            cells.for_each_distributed_candidate_pair(
+                [&distributed, &sorted_pair](const size_t i, const size_t j) {
+#pragma omp critical
+                    distributed.push_back(sorted_pair(i, j));
+                },
+                ghosts);
+
+            std::sort(expected.begin(), expected.end());
+            std::sort(colored.begin(), colored.end());
+            std::sort(distributed.begin(), distributed.end());
+            EXPECT_FALSE(expected.empty());
+            EXPECT_EQ(colored, expected) << "The colored tasks must visit the same pairs (dimensions " << dimensions << ", ghosts " << ghosts << ").";
+            EXPECT_EQ(distributed, expected) << "The distributed tasks must visit the same pairs (dimensions " << dimensions << ", ghosts " << ghosts
+                                             << ").";
+        }
+    }
+}
+
+// Test if the distributed tasks use the size of the team, if the maximum number of threads differs inside the parallel region
+TEST(CellList, TaskTraversalNestedThreads) {
+    std::vector<Particle> particles;
+
+    for (size_t i = 0; i < 8; i++) {
+        for (size_t j = 0; j < 8; j++) {
+            for (size_t k = 0; k < 8; k++) {
+                particles.push_back(Particle({ 0.5 + 1.2 * i + 0.03 * j, 0.5 + 1.2 * j + 0.07 * k, 0.5 + 1.2 * k + 0.05 * i }, {}, 0));
+            }
+        }
+    }
+
+    const auto sorted_pair = [](const size_t i, const size_t j) { return std::make_pair(std::min(i, j), std::max(i, j)); };
+
+    CellList cells(2.5, { 10.0, 10.0, 10.0 }, 0.0, 1, 3);
+    ASSERT_NO_THROW(cells.create_list(particles));
+    cells.set_tasks(true);
+
+    std::vector<std::pair<size_t, size_t>> expected;
+    cells.for_each_candidate_pair([&expected, &sorted_pair](const size_t i, const size_t j) { expected.push_back(sorted_pair(i, j)); });
+
+#ifdef _OPENMP
+    // Like OMP_NUM_THREADS=4,1, the team has four threads, while the maximum number of threads inside the region is one
+    const int max_threads = omp_get_max_threads();
+    omp_set_num_threads(1);
+#endif
+
+    std::vector<std::pair<size_t, size_t>> distributed;
+    size_t team = 1;
+
+#pragma omp parallel num_threads(4)
+    {
+#pragma omp single
+        team = Threads::get_num_threads();
+
+        cells.for_each_distributed_candidate_pair(
+            [&distributed, &sorted_pair](const size_t i, const size_t j) {
+#pragma omp critical
+                distributed.push_back(sorted_pair(i, j));
+            },
+            false);
+    }
+
+#ifdef _OPENMP
+    omp_set_num_threads(max_threads);
+    EXPECT_EQ(team, 4) << "The team must use the number of threads of the clause.";
+#endif
+
+    std::sort(expected.begin(), expected.end());
+    std::sort(distributed.begin(), distributed.end());
+    EXPECT_FALSE(expected.empty());
+    EXPECT_EQ(distributed, expected) << "The distributed tasks must visit the same pairs in a team larger than the maximum number of threads.";
+}
+
+// Test if the balanced traversal visits the same pairs as the sequential traversal, while the partition is cut again
+TEST(CellList, BalancedTraversal) {
+    std::vector<Particle> particles;
+
+    // Place a dense blob into a corner of an otherwise empty domain and some particles into the halo
+    for (size_t i = 0; i < 10; i++) {
+        for (size_t j = 0; j < 9; j++) {
+            for (size_t k = 0; k < 8; k++) {
+                particles.push_back(Particle({ -0.4 + 0.5 * i + 0.03 * j, -0.3 + 0.55 * j + 0.07 * k, -0.2 + 0.6 * k + 0.05 * i }, {}, 0));
+            }
+        }
+    }
+
+    particles.push_back(Particle({ 18.0, 18.0, 18.0 }, {}, 0));
+    particles.push_back(Particle({ 18.5, 18.5, 18.5 }, {}, 0));
+
+    const auto sorted_pair = [](const size_t i, const size_t j) { return std::make_pair(std::min(i, j), std::max(i, j)); };
+
+    for (size_t dimensions = 2; dimensions <= 3; dimensions++) {
+        CellList cells(2.5, { 20.0, 20.0, 20.0 }, 0.0, 1, dimensions);
+        ASSERT_NO_THROW(cells.create_list(particles));
+
+        // Any measured imbalance exceeds the threshold, such that every traversal cuts a new partition
+        cells.set_balance(1e-12);
+
+        for (const bool ghosts : { false, true }) {
+            std::vector<std::pair<size_t, size_t>> expected;
+
+            const auto sequential = [&expected, &sorted_pair](const size_t i, const size_t j) { expected.push_back(sorted_pair(i, j)); };
+
+            if (ghosts) {
+                cells.for_each_ghost_candidate_pair(sequential);
+            } else {
+                cells.for_each_candidate_pair(sequential);
+            }
+
+            std::sort(expected.begin(), expected.end());
+            EXPECT_FALSE(expected.empty());
+
+            for (size_t traversal = 0; traversal < 3; traversal++) {
+                std::vector<std::pair<size_t, size_t>> balanced;
+
+#pragma omp parallel num_threads(4)
+                cells.for_each_distributed_candidate_pair(
+                    [&balanced, &sorted_pair](const size_t i, const size_t j) {
+#pragma omp critical
+                        balanced.push_back(sorted_pair(i, j));
+                    },
+                    ghosts);
+
+                std::sort(balanced.begin(), balanced.end());
+                EXPECT_EQ(balanced, expected) << "The balanced traversal must visit the same pairs (dimensions " << dimensions << ", ghosts " << ghosts
+                                              << ", traversal " << traversal << ").";
+                EXPECT_GE(cells.get_imbalance(), 0.0);
+            }
+        }
+
+#ifdef _OPENMP
+        EXPECT_GT(cells.get_rebalances(), 0) << "The imbalanced traversals must cut new partitions.";
+#endif
+        EXPECT_GE(cells.get_mean_imbalance(), 0.0);
+    }
+}
+
+// Test if the batch iterators receive the same pairs as the index pair iterators
+TEST(CellList, BatchTraversal) {
+    std::vector<Particle> particles;
+
+    for (size_t i = 0; i < 12; i++) {
+        for (size_t j = 0; j < 11; j++) {
+            for (size_t k = 0; k < 10; k++) {
+                particles.push_back(Particle({ 0.3 + 0.8 * i + 0.03 * j, 0.2 + 0.85 * j + 0.07 * k, 0.4 + 0.9 * k + 0.05 * i }, {}, 0));
+            }
+        }
+    }
+
+    const auto sorted_pair = [](const size_t i, const size_t j) { return std::make_pair(std::min(i, j), std::max(i, j)); };
+
+    for (size_t dimensions = 2; dimensions <= 3; dimensions++) {
+        CellList cells(2.5, { 10.0, 10.0, 10.0 }, 0.0, 1, dimensions);
+        ASSERT_NO_THROW(cells.create_list(particles));
+
+        for (const bool tasks : { false, true }) {
+            cells.set_tasks(tasks);
+
+            std::vector<std::pair<size_t, size_t>> expected;
+            std::vector<std::pair<size_t, size_t>> colored;
+            std::vector<std::pair<size_t, size_t>> distributed;
+
+            cells.for_each_candidate_pair([&expected, &sorted_pair](const size_t i, const size_t j) { expected.push_back(sorted_pair(i, j)); });
+
+            // The batch iterators must accept single pairs as well, which the ghost traversal passes
+            struct BatchIterator {
+                std::vector<std::pair<size_t, size_t>>& pairs;
+
+                void operator()(const size_t, const size_t) const { ADD_FAILURE() << "The batch iterator must receive batches."; }
+
+                void operator()(const size_t i, const size_t* first, const size_t* last) const {
+                    EXPECT_LT(first, last) << "Empty batches must not be passed.";
+
+#pragma omp critical
+                    for (const size_t* j = first; j != last; j++) {
+                        pairs.push_back(std::make_pair(std::min(i, *j), std::max(i, *j)));
+                    }
+                }
+            };
+
+            const auto batch_iterator = [](std::vector<std::pair<size_t, size_t>>& pairs) { return BatchIterator { pairs }; };
+
+            cells.for_each_colored_candidate_pair(batch_iterator(colored));
+
+#pragma omp parallel
+            cells.for_each_distributed_candidate_pair(batch_iterator(distributed));
+
+            std::sort(expected.begin(), expected.end());
+            std::sort(colored.begin(), colored.end());
+            std::sort(distributed.begin(), distributed.end());
+            EXPECT_FALSE(expected.empty());
+            EXPECT_EQ(colored, expected) << "The colored batches must visit the same pairs (dimensions " << dimensions << ", tasks " << tasks << ").";
+            EXPECT_EQ(distributed, expected) << "The distributed batches must visit the same pairs (dimensions " << dimensions << ", tasks " << tasks
+                                             << ").";
+        }
+    }
+}
@@ -35,3 +35,51 @@ TEST(DSContainer, IteratePairs) {
 
     EXPECT_TRUE(pairs.size() == 0) << "The pair size should be 0 but it was " << pairs.size();
 }
+
+// Test if the displacement traversal passes the displacement from the second to the first particle and the squared distance for every pair
+TEST(DSContainer, IteratePairsDisplacement) {
+    DSContainer box = DSContainer(
+        {
+            Particle({ 0.5, 0.5, 0.5 }, {}, 0),
+            Particle({ 1.25, 0.5, 0.5 }, {}, 0),
+            Particle({ 0.5, 1.25, -3.0 }, {}, 0),
+        },
+        {});
+
+    size_t count = 0;
+    box.iterate_pairs([&count](Particle& p1, Particle& p2, const Vec<double>& diff, const double dist_squ) {
+        EXPECT_EQ(diff, p1.getX() - p2.getX()) << "The displacement must point from the second to the first particle.";
+        EXPECT_EQ(dist_squ, diff.len_squ()) << "The squared distance must belong to the displacement.";
+        count++;
+    });
+
+    EXPECT_EQ(count, 3) << "The direct sum must visit all pairs.";
+}
+
+// Test if the tiled traversal visits every pair exactly once, if the particles do not fill the last tile
+TEST(DSContainer, TileTraversal) {
+    std::vector<Particle> particles;
+
+    for (size_t i = 0; i < 600; i++) {
+        particles.push_back(Particle({ static_cast<double>(i), 0.0, 0.0 }, {}, 0));
+    }
+
+    DSContainer box = DSContainer(particles, {});
+    std::vector<std::pair<size_t, size_t>> expected;
+    std::vector<std::pair<size_t, size_t>> tiled;
+
+    box.for_each_candidate_pair([&expected](const size_t i, const size_t j) { expected.emplace_back(i, j); });
+
+#pragma omp parallel num_threads(3)
+    box.for_each_tile_pair([&tiled](const size_t i, const size_t first, const size_t last) {
+        EXPECT_GT(first, i) << "The range must only contain larger indices.";
+
+#pragma omp critical
+        for (size_t j = first; j < last; j++) {
+            tiled.emplace_back(i, j);
+        }
+    });
+
+    std::sort(tiled.begin(), tiled.end());
+    EXPECT_EQ(tiled, expected) << "The tiled traversal must visit every pair exactly once.";
+}
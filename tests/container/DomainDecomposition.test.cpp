@@ -0,0 +1,248 @@
+#include <ParticleGenerator.h>
+#include <algorithm>
+#include <boundaries/Stepper.h>
+#include <condition_variable>
+#include <container/DomainDecomposition.h>
+#include <deque>
+#include <gtest/gtest.h>
+#include <map>
+#include <mutex>
+#include <physicsCalculator/LJCalculator.h>
+#include <thread>
+
+/**
+ * Hand the buffers between the subdomains of a single process in the order they were sent, like the messages between two MPI ranks.
+ */
+class Mailbox {
+private:
+    /**
+     * Protect the queues of the messages.
+     */
+    std::mutex mutex;
+
+    /**
+     * Notify the receiving subdomains of a new message.
+     */
+    std::condition_variable arrived;
+
+    /**
+     * Store the queue of the messages for every pair of a sending and a receiving rank.
+     */
+    std::map<std::pair<int, int>, std::deque<std::vector<double>>> messages;
+
+public:
+    /**
+     * Send a buffer from one subdomain to another.
+     *
+     * @param source The rank sending the buffer.
+     * @param destination The rank receiving the buffer.
+     * @param buffer The buffer to send.
+     */
+    void send(const int source, const int destination, const std::vector<double>& buffer) {
+        {
+            const std::lock_guard<std::mutex> lock(mutex);
+            messages[{ source, destination }].push_back(buffer);
+        }
+
+        arrived.notify_all();
+    }
+
+    /**
+     * Wait for the next buffer sent from one subdomain to another.
+     *
+     * @param source The rank sending the buffer.
+     * @param destination The rank receiving the buffer.
+     *
+     * @return The received buffer.
+     */
+    std::vector<double> receive(const int source, const int destination) {
+        std::unique_lock<std::mutex> lock(mutex);
+        std::deque<std::vector<double>>& queue = messages[{ source, destination }];
+        arrived.wait(lock, [&queue]() { return !queue.empty(); });
+
+        std::vector<double> buffer = std::move(queue.front());
+        queue.pop_front();
+
+        return buffer;
+    }
+};
+
+/**
+ * Decompose the domain among the threads of a single process, which exchange their buffers using a mailbox instead of MPI.
+ */
+class LocalDecomposition : public DomainDecomposition {
+private:
+    /**
+     * Store the mailbox shared by all subdomains.
+     */
+    Mailbox& mailbox;
+
+protected:
+    /**
+     * Send a buffer to one rank using the mailbox, while receiving a buffer from another rank. Ranks of -1 are skipped.
+     *
+     * @param send The buffer to send.
+     * @param destination The rank receiving the buffer.
+     * @param source The rank sending the received buffer.
+     *
+     * @return The received buffer.
+     */
+    virtual std::vector<double> shift_buffer(const std::vector<double>& send, const int destination, const int source) const {
+        if (destination >= 0) {
+            mailbox.send(get_rank(), destination, send);
+        }
+
+        return source >= 0 ? mailbox.receive(source, get_rank()) : std::vector<double>();
+    }
+
+public:
+    /**
+     * Decompose the domain of the environment using the given grid.
+     *
+     * @param env The simulation environment storing the global domain.
+     * @param new_grid The number of subdomains in every direction.
+     * @param new_rank The rank of the own subdomain.
+     * @param new_mailbox The mailbox shared by all subdomains.
+     */
+    LocalDecomposition(const Environment& env, const std::array<int, 3>& new_grid, const int new_rank, Mailbox& new_mailbox)
+        : DomainDecomposition(env, new_grid, new_rank)
+        , mailbox(new_mailbox) { }
+};
+
+// Test if the subdomains, their neighbors and their boundaries are derived correctly from the grid.
+TEST(DomainDecomposition, Geometry) {
+    Environment env;
+    env.set_domain_size({ 10.0, 10.0, 10.0 });
+    env.set_boundary_type({ PERIODIC, HALO, OUTFLOW, PERIODIC, HALO, OUTFLOW });
+
+    // The upper right subdomain of a 2 x 2 grid
+    const DomainDecomposition decomposition(env, { 2, 2, 1 }, 3);
+
+    EXPECT_LT((decomposition.get_lower() - Vec<double>(5.0, 5.0, 0.0)).len(), 1E-9) << "The lower corner of the subdomain is wrong.";
+    EXPECT_LT((decomposition.get_upper() - Vec<double>(10.0, 10.0, 10.0)).len(), 1E-9) << "The upper corner of the subdomain is wrong.";
+
+    const std::array<int, 6> neighbors = { 2, 1, -1, 2, -1, -1 };
+    EXPECT_EQ(decomposition.get_neighbors(), neighbors) << "The periodic x direction must wrap around, the other global faces have no neighbor.";
+
+    const std::array<BoundaryType, 6> local = { INF_CONT, INF_CONT, OUTFLOW, INF_CONT, HALO, OUTFLOW };
+    EXPECT_EQ(decomposition.get_local_boundary_type(), local) << "Only the non periodic global faces keep their boundary.";
+
+    // A single subdomain keeps all boundaries
+    const DomainDecomposition single(env, { 1, 1, 1 }, 0);
+    EXPECT_EQ(single.get_local_boundary_type(), env.get_boundary_type()) << "A single subdomain must keep all boundaries.";
+    EXPECT_EQ(single.get_neighbors()[0], 0) << "A single periodic subdomain is its own neighbor.";
+}
+
+// Test if the container of a subdomain only stores its own particles relative to its lower corner.
+TEST(DomainDecomposition, CreateContainer) {
+    Environment env;
+    env.set_r_cutoff(2.0);
+    env.set_domain_size({ 10.0, 10.0, 10.0 });
+    env.set_boundary_type({ HALO, HALO, HALO, HALO, HALO, HALO });
+
+    std::vector<Particle> particles = {
+        Particle({ 1.0, 1.0, 1.0 }, {}, 0),
+        Particle({ 6.0, 1.0, 1.0 }, {}, 0),
+        Particle({ 9.0, 9.0, 9.0 }, {}, 0),
+    };
+
+    BoxContainer global(particles, 2.0, { 10.0, 10.0, 10.0 }, { TypeDesc { 1.0, 1.0, 5.0, 0.1, 0.0 } });
+    const DomainDecomposition decomposition(env, { 2, 1, 1 }, 1);
+    const std::shared_ptr<BoxContainer> local = decomposition.create_container(global, env);
+
+    ASSERT_EQ(local->size(), 2) << "The subdomain must only store the particles within its bounds.";
+    EXPECT_LT(((*local)[0].getX() - Vec<double>(1.0, 1.0, 1.0)).len(), 1E-9) << "The positions must be relative to the lower corner.";
+    EXPECT_LT(((*local)[1].getX() - Vec<double>(4.0, 9.0, 9.0)).len(), 1E-9) << "The positions must be relative to the lower corner.";
+    EXPECT_LT((local->get_corner_vector() - Vec<double>(5.0, 10.0, 10.0)).len(), 1E-9) << "The container must span the subdomain.";
+}
+
+// Test if two subdomains migrating their particles, exchanging their halos and folding the ghost forces reproduce the non distributed simulation.
+TEST(DomainDecomposition, TwoSubdomains) {
+    Environment env;
+    env.set_r_cutoff(2.5);
+    env.set_domain_size({ 10.0, 10.0, 10.0 });
+    env.set_delta_t(0.0005);
+    env.set_boundary_type({ PERIODIC, PERIODIC, HALO, PERIODIC, PERIODIC, HARD });
+    env.set_periodic_ghosts(true);
+
+    const size_t steps = 200;
+    ParticleGenerator gen;
+
+    // The drift moves every particle by 2.0 along the x axis, such that particles cross the face between the subdomains and the periodic face
+    physicsCalculator::LJCalculator calc(env, {}, {}, false, false);
+    calc.get_container().resize(512);
+    gen.generateCuboid(calc.get_container(), 0, { 0.6, 0.6, 0.6 }, { 20.0, 0.0, 0.0 }, 0, { 8, 8, 8 }, 1.1225, 2.0, 3);
+
+    const std::vector<Particle> particles(calc.get_container().begin(), calc.get_container().end());
+    const std::vector<TypeDesc> ptypes = { TypeDesc { 1.0, 1.0, 5.0, 0.0005, 0.0 } };
+
+    // The initial forces of the non distributed simulation include the periodic images like the forces of the steps
+    physicsCalculator::LJCalculator reference(env, particles, ptypes, false, false);
+    BoxContainer& reference_cont = dynamic_cast<BoxContainer&>(reference.get_container());
+    reference_cont.create_ghosts({ true, true, false });
+    reference.calculateF();
+    reference_cont.fold_ghost_forces();
+
+    Stepper stepper(env.get_boundary_type(), env.get_domain_size(), true);
+
+    for (size_t i = 0; i < steps; i++) {
+        stepper.step(reference);
+    }
+
+    // Every subdomain runs on its own thread like an MPI rank, since the exchanges block until the neighbor sent its buffer
+    BoxContainer global(particles, 2.5, env.get_domain_size(), ptypes);
+    Mailbox mailbox;
+    std::array<std::vector<Particle>, 2> results;
+    std::array<Vec<double>, 2> lower;
+    std::vector<std::thread> ranks;
+
+    for (int rank = 0; rank < 2; rank++) {
+        ranks.emplace_back([&, rank]() {
+            LocalDecomposition decomposition(env, { 2, 1, 1 }, rank, mailbox);
+            const std::shared_ptr<BoxContainer> cont = decomposition.create_container(global, env);
+            physicsCalculator::LJCalculator local_calc(decomposition.create_environment(env), cont, false);
+            Stepper local_stepper(decomposition);
+
+            for (auto& p : *cont) {
+                p.setF({ 0.0, 0.0, 0.0 });
+            }
+
+            decomposition.calculate_forces(local_calc);
+
+            for (size_t i = 0; i < steps; i++) {
+                local_stepper.step(local_calc);
+            }
+
+            lower[rank] = decomposition.get_lower();
+            decomposition.with_global_positions(*cont, [&]() { results[rank].assign(cont->begin(), cont->end()); });
+        });
+    }
+
+    for (auto& thread : ranks) {
+        thread.join();
+    }
+
+    for (int rank = 0; rank < 2; rank++) {
+        for (const Particle& p : results[rank]) {
+            EXPECT_GE(p.getX()[0], lower[rank][0]) << "Rank " << rank << " must hand the particles leaving its subdomain to its neighbor.";
+            EXPECT_LT(p.getX()[0], lower[rank][0] + 5.0) << "Rank " << rank << " must hand the particles leaving its subdomain to its neighbor.";
+        }
+    }
+
+    std::vector<Particle> distributed = results[0];
+    distributed.insert(distributed.end(), results[1].begin(), results[1].end());
+
+    ASSERT_EQ(distributed.size(), reference.get_container().size()) << "The subdomains must store the same number of particles.";
+
+    for (const Particle& p : reference.get_container()) {
+        // The subdomains store the particles in a different order, they are matched by their positions
+        const auto match = std::min_element(distributed.begin(), distributed.end(), [&p](const Particle& a, const Particle& b) {
+            return (a.getX() - p.getX()).len_squ() < (b.getX() - p.getX()).len_squ();
+        });
+
+        // The forces are summed up in a different order and the positions are shifted by the lower corners of the subdomains
+        EXPECT_LT((match->getX() - p.getX()).len(), 1E-9) << "The distributed simulation must move the particles in the same way.";
+        EXPECT_LT((match->getF() - p.getF()).len(), 1E-9 * std::max(p.getF().len(), 1.0))
+            << "The distributed simulation must compute the same forces.";
+    }
+}
@@ -305,3 +305,29 @@ TEST(ParticleContainer, RemoveOutsideDomainNo) {
 
     EXPECT_TRUE(expected.size() == 0) << "The pair size should be 0 but it was " << expected.size();
 }
+
+// Test if the particles are sorted along the Morton curve
+TEST(ParticleContainer, SortParticles) {
+    const std::vector<Particle> particles = {
+        Particle({ 1.5, 1.5, 0.5 }, { 1.0, -2.0, 1.0 }, 1),
+        Particle({ 0.5, 0.5, 0.5 }, { -2.0, 1.0, 1.0 }, 2),
+        Particle({ 0.5, 0.5, 1.5 }, { 1.0, 2.0, -3.0 }, 3),
+        Particle({ 1.5, 0.5, 0.5 }, { 3.0, -3.0, 2.0 }, 4),
+        Particle({ 0.5, 1.5, 0.5 }, { 3.0, -3.0, 2.0 }, 5),
+        Particle({ 2.5, 0.5, 0.5 }, { 3.0, -3.0, 2.0 }, 6),
+    };
+
+    TestContainer container(particles, { 6.0, 7.0, 5.0 }, {});
+
+    container.sort_particles(1.0);
+
+    const std::vector<int> expected = { 2, 3, 5, 4, 1, 6 };
+
+    ASSERT_EQ(container.size(), expected.size()) << "The sorting must not change the number of particles.";
+
+    for (size_t i = 0; i < expected.size(); i++) {
+        EXPECT_EQ(container[i].getType(), expected[i]) << "The particles must be sorted along the Morton curve.";
+    }
+
+    EXPECT_LT((container[0].getV() - Vec<double>(-2.0, 1.0, 1.0)).len(), 1E-9) << "The particles must be moved with their velocities.";
+}
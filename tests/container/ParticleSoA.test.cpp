@@ -0,0 +1,34 @@
+#include <container/ParticleSoA.h>
+#include <gtest/gtest.h>
+
+// Test if the particle data is gathered into the arrays and the forces are added back to the particles
+TEST(ParticleSoA, GatherScatter) {
+    std::vector<Particle> particles = {
+        Particle({ 1.0, 2.0, 3.0 }, { 1.0, 1.0, 1.0 }, 1),
+        Particle({ 4.0, 5.0, 6.0 }, { 2.0, 2.0, 2.0 }, 0),
+    };
+
+    particles[0].setF({ 1.0, 0.0, -1.0 });
+
+    ParticleSoA soa;
+    soa.gather(particles);
+
+    ASSERT_EQ(soa.size(), 2) << "The arrays must store all particles.";
+    EXPECT_DOUBLE_EQ(soa.x[1], 4.0) << "The x coordinate must be gathered.";
+    EXPECT_DOUBLE_EQ(soa.y[1], 5.0) << "The y coordinate must be gathered.";
+    EXPECT_DOUBLE_EQ(soa.z[1], 6.0) << "The z coordinate must be gathered.";
+    EXPECT_EQ(soa.type[0], 1) << "The type must be gathered.";
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(soa.x.data()) % 64, 0) << "The arrays must be aligned to a cache line.";
+
+    for (size_t i = 0; i < soa.size(); i++) {
+        EXPECT_DOUBLE_EQ(soa.f_x[i] + soa.f_y[i] + soa.f_z[i], 0.0) << "The forces must be reset.";
+    }
+
+    soa.f_x[0] = 2.0;
+    soa.f_z[1] = -3.0;
+    soa.scatter_forces(particles);
+
+    EXPECT_LT((particles[0].getF() - Vec<double>(3.0, 0.0, -1.0)).len(), 1E-9) << "The forces must be added to the particle forces.";
+    EXPECT_LT((particles[1].getF() - Vec<double>(0.0, 0.0, -3.0)).len(), 1E-9) << "The forces must be added to the particle forces.";
+    EXPECT_LT((particles[1].getV() - Vec<double>(2.0, 2.0, 2.0)).len(), 1E-9) << "The velocities must not change.";
+}
@@ -0,0 +1,99 @@
+#include <container/VerletList.h>
+#include <gtest/gtest.h>
+#include <tuple>
+
+// Test if the verlet lists visit the same pairs as the linked cells
+TEST(VerletList, LoopPairs) {
+    CellList cells(1.0, { 5.0, 4.0, 3.0 }, 0.5);
+    std::vector<Particle> particles = {
+        Particle({ 0.9, 2.9, 0.9 }, {}, 1),
+        Particle({ 1.1, 2.9, 0.9 }, {}, 2),
+        Particle({ 2.3, 2.9, 0.9 }, {}, 3),
+        Particle({ 3.4, 1.4, 2.3 }, {}, 4),
+        Particle({ 3.4, 1.6, 2.4 }, {}, 5),
+        Particle({ 4.8, 1.4, 2.3 }, {}, 6),
+    };
+
+    ASSERT_NO_THROW(cells.create_list(particles));
+
+    VerletList verlet(1.0, 0.5);
+    verlet.build(cells, particles);
+
+    std::list<std::tuple<int, int>> pairs = {
+        { 1, 2 },
+        { 4, 5 },
+    };
+
+    verlet.loop_pairs(
+        [&pairs](Particle& p1, Particle& p2) {
+            std::tuple<int, int> rm = {
+                static_cast<int>(std::min(p1.getType(), p2.getType())),
+                static_cast<int>(std::max(p1.getType(), p2.getType())),
+            };
+
+            EXPECT_TRUE(std::find(pairs.begin(), pairs.end(), rm) != pairs.end())
+                << "Iterated over an illegal pair: (" << std::get<0>(rm) << ", " << std::get<1>(rm) << ")";
+
+            pairs.remove(rm);
+        },
+        particles);
+
+    EXPECT_TRUE(pairs.size() == 0) << "The pair size should be 0 but it was " << pairs.size();
+    EXPECT_EQ(verlet.get_builds(), 1) << "The lists must have been built exactly once.";
+}
+
+// Test if pairs within the skin are picked up without rebuilding the lists
+TEST(VerletList, SkinPairs) {
+    CellList cells(1.0, { 5.0, 4.0, 3.0 }, 0.5);
+    std::vector<Particle> particles = {
+        Particle({ 1.0, 2.0, 1.0 }, {}, 1),
+        Particle({ 2.2, 2.0, 1.0 }, {}, 2),
+    };
+
+    ASSERT_NO_THROW(cells.create_list(particles));
+
+    VerletList verlet(1.0, 0.5);
+    verlet.build(cells, particles);
+
+    verlet.loop_pairs([](Particle& p1, Particle& p2) { EXPECT_TRUE(false) << "The particles are further apart than the cutoff."; }, particles);
+
+    // Move both particles by less than half the skin
+    particles[0].setX({ 1.2, 2.0, 1.0 });
+    particles[1].setX({ 2.0, 2.0, 1.0 });
+
+    EXPECT_FALSE(verlet.requires_rebuild(particles)) << "The lists must not be rebuilt for small displacements.";
+
+    size_t count = 0;
+    verlet.loop_pairs([&count](Particle& p1, Particle& p2) { count++; }, particles);
+
+    EXPECT_EQ(count, 1) << "The pair within the skin must be visited once it is within the cutoff.";
+}
+
+// Test if the rebuild criterion works correctly
+TEST(VerletList, RequiresRebuild) {
+    CellList cells(1.0, { 5.0, 4.0, 3.0 }, 0.4);
+    std::vector<Particle> particles = {
+        Particle({ 1.0, 2.0, 1.0 }, {}, 1),
+        Particle({ 3.0, 2.0, 1.0 }, {}, 2),
+    };
+
+    ASSERT_NO_THROW(cells.create_list(particles));
+
+    VerletList verlet(1.0, 0.4);
+
+    EXPECT_TRUE(verlet.requires_rebuild(particles)) << "Lists which were never built must be rebuilt.";
+
+    verlet.build(cells, particles);
+
+    EXPECT_FALSE(verlet.requires_rebuild(particles)) << "Freshly built lists must not be rebuilt.";
+
+    particles[1].setX({ 3.19, 2.0, 1.0 });
+    EXPECT_FALSE(verlet.requires_rebuild(particles)) << "A displacement below half the skin must not trigger a rebuild.";
+
+    particles[1].setX({ 3.21, 2.0, 1.0 });
+    EXPECT_TRUE(verlet.requires_rebuild(particles)) << "A displacement above half the skin must trigger a rebuild.";
+
+    particles[1].setX({ 3.0, 2.0, 1.0 });
+    particles.push_back(Particle({ 2.0, 2.0, 1.0 }, {}, 3));
+    EXPECT_TRUE(verlet.requires_rebuild(particles)) << "A changed number of particles must trigger a rebuild.";
+}
@@ -69,6 +69,8 @@ TEST(XMLTreeReader, TestNonDefaultValues) {
     EXPECT_EQ(environment.get_boundary_type(), boundaries);
     EXPECT_EQ(environment.get_delta_t(), 0.5);
     EXPECT_EQ(environment.get_t_end(), 500);
+    EXPECT_EQ(environment.get_sub_cells(), 2);
+    EXPECT_EQ(environment.get_threads(), 3);
     EXPECT_EQ(thermo, exp_thermo);
 }
 
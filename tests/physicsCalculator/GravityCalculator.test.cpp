@@ -347,3 +347,33 @@ TEST(Calculator, UpdateF2) {
         pi++;
     }
 }
+
+// Test if the tiled direct sum computes the same forces as the generic pair iteration
+TEST(GravityCalculator, TiledDirectSum) {
+    std::vector<Particle> particles;
+
+    // Place particles of two types on a distorted lattice, such that the tiles are filled unevenly
+    for (size_t i = 0; i < 700; i++) {
+        particles.push_back(Particle({ static_cast<double>(i % 9) + 0.01 * static_cast<double>(i % 7), static_cast<double>(i / 9 % 9),
+                                         static_cast<double>(i / 81) + 0.03 * static_cast<double>(i % 5) },
+            {}, static_cast<int>(i % 2)));
+    }
+
+    const std::vector<TypeDesc> ptypes = { TypeDesc { 1.0, 1.0, 1.0, 0.01, 0.0 }, TypeDesc { 2.5, 1.0, 1.0, 0.01, 0.0 } };
+    Environment env;
+
+    physicsCalculator::GravityCalculator tiled(env, particles, ptypes, false);
+    physicsCalculator::GravityCalculator generic(env, particles, ptypes, false);
+
+    tiled.calculateF();
+    generic.Calculator::calculateF();
+
+    for (size_t i = 0; i < particles.size(); i++) {
+        const Vec<double> expected = generic.get_container().begin()[i].getF();
+        const Vec<double> actual = tiled.get_container().begin()[i].getF();
+
+        for (size_t d = 0; d < 3; d++) {
+            EXPECT_NEAR(actual[d], expected[d], 1e-9 * (1.0 + std::abs(expected[d]))) << "The forces of particle " << i << " must match.";
+        }
+    }
+}
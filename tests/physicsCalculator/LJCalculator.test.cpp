@@ -288,6 +288,86 @@ TEST(Calculator, UpdateOldFNo) {
     EXPECT_EQ(calc.get_container().size(), 0) << "Calculating the velocity on an empty container should not add a particle.";
 }
 
+// Test if the fused position update applies the operation between the position update and the reset of the forces to the gravity
+TEST(Calculator, IntegrateX) {
+    // Set the margin for the maximum floatingpoint error
+    const double error_margin = 1E-9;
+
+    // Initialize the list of particles
+    std::vector<Particle> particles = {
+        Particle({ 1.0, 2.0, 3.0 }, { 2.0, 2.0, 0.0 }, 1),
+        Particle({ -2.0, -2.0, 1.0 }, { 1.0, -1.0, 2.0 }, 0),
+        Particle({ -1.0, -1.0, 2.0 }, { -2.0, 0.0, 1.0 }, 0),
+        Particle({ -2.0, 1.0, 1.0 }, { -1.0, -2.0, -1.0 }, 0),
+    };
+    // Initialise the list of type descriptors, the gravity differs between the types
+    std::vector<TypeDesc> ptypes = {
+        TypeDesc { 1.0, 1.0, 5.0, 0.1, -9.81 },
+        TypeDesc { 2.0, 1.0, 5.0, 0.1, -3.0 },
+    };
+
+    particles[0].setF({ 1.0, -1.0, 2.0 });
+    particles[0].setOldF({ 3.0, 1.0, -1.0 });
+
+    particles[1].setF({ 2.0, 0.0, -1.0 });
+    particles[1].setOldF({ 2.0, -1.0, -2.0 });
+
+    particles[2].setF({ 2.0, -1.0, 0.0 });
+    particles[2].setOldF({ -1.0, -1.0, 2.0 });
+
+    particles[3].setF({ 0.0, 1.0, 0.0 });
+    particles[3].setOldF({ 2.0, -1.0, -2.0 });
+
+    // Initialize the simulation environment
+    const char* argv[] = {
+        "./MolSim",
+        "path/to/input.txt",
+        "-delta_t=0.1",
+    };
+
+    constexpr int argc = sizeof(argv) / sizeof(argv[0]);
+    Environment env;
+
+    ASSERT_NO_THROW(env = Environment(argc, argv));
+
+    // Initialize the Calculator
+    physicsCalculator::LJCalculator calc(env, particles, ptypes, false);
+
+    // Initialize the positions to the expected values of the separate position update
+    const std::vector<Vec<double>> expected_x = {
+        { 1.2025, 2.1975, 3.005 },
+        { -1.89, -2.1, 1.195 },
+        { -1.19, -1.005, 2.1 },
+        { -2.1, 0.805, 0.9 },
+    };
+
+    // Record the state seen by the operation, which doubles the force afterwards
+    std::vector<Particle> seen(particles.size());
+    Particle* first = &calc.get_container()[0];
+
+    ASSERT_NO_THROW(calc.integrateX([&seen, first](Particle& p) {
+        seen[&p - first] = p;
+        p.setF(2.0 * p.getF());
+    }));
+
+    ASSERT_EQ(particles.size(), calc.get_container().size()) << "The number of particles must not change when updating the particles positions.";
+
+    for (size_t i = 0; i < particles.size(); i++) {
+        const Particle& p = calc.get_container()[i];
+
+        // The operation must see the new position, but the forces of the previous step
+        EXPECT_LT((seen[i].getX() - expected_x[i]).len(), error_margin) << "The operation must be applied after the position update.";
+        EXPECT_TRUE(seen[i].getF() == particles[i].getF()) << "The operation must be applied before the force is moved into the old force.";
+        EXPECT_TRUE(seen[i].getOldF() == particles[i].getOldF()) << "The operation must be applied before the old force is updated.";
+
+        // The modification of the operation must be moved into the old force, the force must be reset to the gravity of the type
+        EXPECT_LT((p.getX() - expected_x[i]).len(), error_margin) << "The position was not correct.";
+        EXPECT_TRUE(p.getV() == particles[i].getV()) << "The velocity must not change when updating the position.";
+        EXPECT_TRUE(p.getOldF() == 2.0 * particles[i].getF()) << "The old force must store the force modified by the operation.";
+        EXPECT_TRUE(p.getF() == ptypes[particles[i].getType()].get_G()) << "The force must be reset to the gravity of the type.";
+    }
+}
+
 // Test if update f works for handcrafted values
 TEST(LJCalculator, UpdateF1) {
     // Set the margin for the maximum floatingpoint error
@@ -636,3 +716,327 @@ TEST(LJCalculator, UpdateFSingle) {
     // Test if the new forces are correct
     EXPECT_TRUE(calc.get_container()[0].getF() == zero_v) << "The current force should remain zero.";
 }
+
+// Test if the inlined force calculation matches the type erased force calculation
+TEST(LJCalculator, UpdateFInlined) {
+    // Set the margin for the maximum floatingpoint error
+    const double error_margin = 1E-9;
+
+    // Initialize the list of particles
+    std::vector<Particle> particles = {
+        Particle({ 1.0, 1.0, 1.0 }, {}, 0),
+        Particle({ 2.1, 1.2, 1.0 }, {}, 1),
+        Particle({ 1.3, 2.0, 1.4 }, {}, 0),
+        Particle({ 2.0, 2.2, 2.1 }, {}, 1),
+        Particle({ 7.0, 7.0, 7.0 }, {}, 0),
+    };
+
+    std::vector<TypeDesc> ptypes = {
+        TypeDesc { 1.0, 1.0, 5.0, 0.1, 0.0 },
+        TypeDesc { 2.0, 1.2, 3.0, 0.1, 0.0 },
+    };
+
+    // Initialize the simulation environment
+    const char* argv[] = {
+        "./MolSim",
+        "path/to/input.txt",
+    };
+
+    constexpr int argc = sizeof(argv) / sizeof(argv[0]);
+    Environment env;
+
+    ASSERT_NO_THROW(env = Environment(argc, argv));
+    env.set_r_cutoff(2.5);
+    env.set_domain_size({ 10.0, 10.0, 10.0 });
+
+    // Test both the direct sum and the linked cells
+    for (const bool is_infinite : { true, false }) {
+        physicsCalculator::LJCalculator calc(env, particles, ptypes, false, is_infinite);
+        physicsCalculator::LJCalculator calc_erased(env, particles, ptypes, false, is_infinite);
+
+        ASSERT_NO_THROW(calc.calculateF());
+        ASSERT_NO_THROW(calc_erased.physicsCalculator::Calculator::calculateF());
+
+        for (size_t i = 0; i < particles.size(); i++) {
+            EXPECT_LT((calc.get_container()[i].getF() - calc_erased.get_container()[i].getF()).len(), error_margin)
+                << "The inlined force calculation must match the type erased force calculation.";
+        }
+
+        EXPECT_GT(calc.get_container()[0].getF().len(), error_margin) << "The force must be computed.";
+    }
+}
+
+// Test if the two dimensional specialization matches the three dimensional simulation of planar particles
+TEST(LJCalculator, TwoDimensions) {
+    // Set the margin for the maximum floatingpoint error
+    const double error_margin = 1E-9;
+
+    // Initialize the list of planar particles
+    std::vector<Particle> particles = {
+        Particle({ 1.0, 1.0, 1.5 }, { 0.5, 0.1, 0.0 }, 0),
+        Particle({ 2.1, 1.2, 1.5 }, { -0.2, 0.3, 0.0 }, 1),
+        Particle({ 1.3, 2.0, 1.5 }, { 0.0, -0.4, 0.0 }, 0),
+        Particle({ 2.0, 2.2, 1.5 }, { 0.1, 0.1, 0.0 }, 1),
+        Particle({ 7.0, 7.0, 1.5 }, { 0.0, 0.0, 0.0 }, 0),
+    };
+
+    std::vector<TypeDesc> ptypes = {
+        TypeDesc { 1.0, 1.0, 5.0, 0.1, -1.0 },
+        TypeDesc { 2.0, 1.2, 3.0, 0.1, -1.0 },
+    };
+
+    Environment env;
+    env.set_r_cutoff(2.5);
+    env.set_domain_size({ 10.0, 10.0, 3.0 });
+
+    Environment env_2d = env;
+    env_2d.set_dimensions(2);
+
+    // Test both the direct sum and the linked cells
+    for (const bool is_infinite : { true, false }) {
+        physicsCalculator::LJCalculator calc(env, particles, ptypes, false, is_infinite);
+        physicsCalculator::LJCalculator calc_2d(env_2d, particles, ptypes, false, is_infinite);
+
+        for (physicsCalculator::LJCalculator* c : { &calc, &calc_2d }) {
+            ASSERT_NO_THROW(c->calculateX());
+            ASSERT_NO_THROW(c->calculateOldF());
+            ASSERT_NO_THROW(c->calculateF());
+            ASSERT_NO_THROW(c->calculateV());
+        }
+
+        for (size_t i = 0; i < particles.size(); i++) {
+            const Particle& p = calc.get_container()[i];
+            const Particle& p_2d = calc_2d.get_container()[i];
+
+            EXPECT_LT((p.getX() - p_2d.getX()).len(), error_margin) << "The two dimensional positions must match.";
+            EXPECT_LT((p.getV() - p_2d.getV()).len(), error_margin) << "The two dimensional velocities must match.";
+            EXPECT_LT((p.getF() - p_2d.getF()).len(), error_margin) << "The two dimensional forces must match.";
+            EXPECT_EQ(p_2d.getX()[2], 1.5) << "The z coordinate must not change in two dimensions.";
+        }
+
+        EXPECT_GT(calc_2d.get_container()[0].getF().len(), error_margin) << "The force must be computed.";
+    }
+}
+
+// Test if the thread local force buffers compute the same forces as the cell coloring
+TEST(LJCalculator, ParallelStrategies) {
+    // Set the margin for the maximum floatingpoint error
+    const double error_margin = 1E-9;
+
+    // Initialize a distorted lattice of particles with two types
+    std::vector<Particle> particles;
+
+    for (size_t i = 0; i < 8; i++) {
+        for (size_t j = 0; j < 8; j++) {
+            for (size_t k = 0; k < 8; k++) {
+                particles.push_back(Particle({ 0.6 + 1.1 * i + 0.05 * j, 0.6 + 1.1 * j + 0.03 * k, 0.6 + 1.1 * k + 0.04 * i }, {}, (i + j + k) % 2));
+            }
+        }
+    }
+
+    std::vector<TypeDesc> ptypes = {
+        TypeDesc { 1.0, 1.0, 5.0, 0.01, 0.0 },
+        TypeDesc { 2.0, 1.2, 3.0, 0.01, 0.0 },
+    };
+
+    Environment env;
+    env.set_r_cutoff(2.5);
+    env.set_domain_size({ 10.0, 10.0, 10.0 });
+
+    // Test the linked cells and the verlet lists, with and without the cell tasks
+    for (const auto& [skin, cell_tasks] : { std::pair { 0.0, false }, std::pair { 0.5, false }, std::pair { 0.0, true } }) {
+        env.set_skin(skin);
+        env.set_cell_tasks(cell_tasks);
+        env.set_parallel_strategy(COLORING);
+        physicsCalculator::LJCalculator calc(env, particles, ptypes);
+
+        env.set_parallel_strategy(REDUCTION);
+        physicsCalculator::LJCalculator calc_reduction(env, particles, ptypes);
+        EXPECT_EQ(env.get_parallel_strategy(), REDUCTION) << "The getter for the parallel strategy returned a wrong value.";
+
+        for (physicsCalculator::LJCalculator* c : { &calc, &calc_reduction }) {
+            for (size_t step = 0; step < 5; step++) {
+                ASSERT_NO_THROW(c->calculateX());
+                ASSERT_NO_THROW(c->get_container().update_positions());
+                ASSERT_NO_THROW(c->calculateOldF());
+                ASSERT_NO_THROW(c->calculateF());
+                ASSERT_NO_THROW(c->calculateV());
+            }
+        }
+
+        for (size_t i = 0; i < particles.size(); i++) {
+            const Particle& p = calc.get_container()[i];
+            const Particle& p_reduction = calc_reduction.get_container()[i];
+
+            EXPECT_LT((p.getX() - p_reduction.getX()).len(), error_margin) << "The positions must match.";
+            EXPECT_LT((p.getF() - p_reduction.getF()).len(), error_margin) << "The forces must match.";
+        }
+
+        EXPECT_GT(calc_reduction.get_container()[0].getF().len(), error_margin) << "The force must be computed.";
+    }
+}
+
+// Test if the atomic force updates compute the same forces as the cell coloring
+TEST(LJCalculator, AtomicStrategy) {
+    // Set the margin for the maximum floatingpoint error
+    const double error_margin = 1E-9;
+
+    std::vector<TypeDesc> ptypes = {
+        TypeDesc { 1.0, 1.0, 5.0, 0.01, 0.0 },
+        TypeDesc { 2.0, 1.2, 3.0, 0.01, 0.0 },
+    };
+
+    Environment env;
+    env.set_r_cutoff(2.5);
+    env.set_domain_size({ 10.0, 10.0, 10.0 });
+
+    // Test the linked cells and the verlet lists, with and without the cell tasks, in two and three dimensions
+    for (const size_t dimensions : { 2, 3 }) {
+        // Initialize a distorted lattice of particles with two types, which is planar in two dimensions
+        std::vector<Particle> particles;
+
+        for (size_t i = 0; i < 8; i++) {
+            for (size_t j = 0; j < 8; j++) {
+                for (size_t k = 0; k < (dimensions == 2 ? 1 : 8); k++) {
+                    const double z = dimensions == 2 ? 5.0 : 0.6 + 1.1 * k + 0.04 * i;
+                    particles.push_back(Particle({ 0.6 + 1.1 * i + 0.05 * j, 0.6 + 1.1 * j + 0.03 * k, z }, {}, (i + j + k) % 2));
+                }
+            }
+        }
+
+        for (const auto& [skin, cell_tasks] : { std::pair { 0.0, false }, std::pair { 0.5, false }, std::pair { 0.0, true } }) {
+            env.set_dimensions(dimensions);
+            env.set_skin(skin);
+            env.set_cell_tasks(cell_tasks);
+            env.set_parallel_strategy(COLORING);
+            physicsCalculator::LJCalculator calc(env, particles, ptypes, true, false);
+
+            env.set_parallel_strategy(ATOMIC);
+            physicsCalculator::LJCalculator calc_atomic(env, particles, ptypes, true, false);
+
+            for (size_t i = 0; i < particles.size(); i++) {
+                EXPECT_LT((calc.get_container()[i].getF() - calc_atomic.get_container()[i].getF()).len(), error_margin) << "The forces must match.";
+            }
+
+            EXPECT_GT(calc_atomic.get_container()[0].getF().len(), error_margin) << "The force must be computed.";
+        }
+    }
+}
+
+// Test if the kernels specialized for a single type and for a few types compute the same forces as the general kernel
+TEST(LJCalculator, TypeSpecializations) {
+    // Set the margin for the maximum floatingpoint error
+    const double error_margin = 1E-9;
+
+    Environment env;
+    env.set_r_cutoff(2.5);
+    env.set_domain_size({ 10.0, 10.0, 10.0 });
+
+    // Initialize a distorted lattice of particles, whose types are assigned round robin
+    const auto make_particles = [](const size_t types) {
+        std::vector<Particle> particles;
+
+        for (size_t i = 0; i < 6; i++) {
+            for (size_t j = 0; j < 6; j++) {
+                for (size_t k = 0; k < 6; k++) {
+                    const int type = static_cast<int>((i + j + k) % types);
+                    particles.push_back(Particle({ 0.6 + 1.1 * i + 0.05 * j, 0.6 + 1.1 * j + 0.03 * k, 0.6 + 1.1 * k + 0.04 * i }, {}, type));
+                }
+            }
+        }
+
+        return particles;
+    };
+
+    // Identical types must not change the forces, such that the single type, packed and general kernels can be compared with each other
+    for (const bool is_infinite : { true, false }) {
+        const std::vector<TypeDesc> single_type = { TypeDesc { 1.0, 1.0, 5.0, 0.01, 0.0 } };
+        physicsCalculator::LJCalculator calc(env, make_particles(1), single_type, true, is_infinite);
+
+        for (const size_t types : { 3, 6 }) {
+            const std::vector<TypeDesc> ptypes(types, single_type[0]);
+            physicsCalculator::LJCalculator calc_types(env, make_particles(types), ptypes, true, is_infinite);
+
+            for (size_t i = 0; i < calc.get_container().size(); i++) {
+                EXPECT_LT((calc.get_container()[i].getF() - calc_types.get_container()[i].getF()).len(), error_margin)
+                    << "The forces of identical types must match.";
+            }
+        }
+
+        EXPECT_GT(calc.get_container()[0].getF().len(), error_margin) << "The force must be computed.";
+    }
+
+    // Distinct types must match the generic pair iteration of the direct sum, which reads the type pairs from the container
+    for (const size_t types : { 1, 3, 6 }) {
+        std::vector<TypeDesc> ptypes;
+
+        for (size_t t = 0; t < types; t++) {
+            ptypes.push_back(TypeDesc { 1.0 + t, 1.0 + 0.1 * t, 5.0 - 0.5 * t, 0.01, 0.0 });
+        }
+
+        physicsCalculator::LJCalculator calc(env, make_particles(types), ptypes);
+        physicsCalculator::LJCalculator calc_generic(env, make_particles(types), ptypes, false);
+
+        ASSERT_NO_THROW(calc_generic.calculateOldF());
+        ASSERT_NO_THROW(calc_generic.physicsCalculator::Calculator::calculateF());
+
+        for (size_t i = 0; i < calc.get_container().size(); i++) {
+            EXPECT_LT((calc.get_container()[i].getF() - calc_generic.get_container()[i].getF()).len(), error_margin)
+                << "The forces must match the generic pair iteration.";
+        }
+    }
+}
+
+// Test if the mixed precision kernels match the double precision kernels up to the single precision rounding
+TEST(LJCalculator, MixedPrecision) {
+    // Set the margin for the maximum relative error of the single precision pair forces
+    const double error_margin = 1E-4;
+
+    // Initialize a distorted lattice of particles with two types
+    std::vector<Particle> particles;
+
+    for (size_t i = 0; i < 6; i++) {
+        for (size_t j = 0; j < 6; j++) {
+            for (size_t k = 0; k < 6; k++) {
+                particles.push_back(Particle({ 0.6 + 1.1 * i + 0.05 * j, 0.6 + 1.1 * j + 0.03 * k, 0.6 + 1.1 * k + 0.04 * i }, {}, (i + j + k) % 2));
+            }
+        }
+    }
+
+    std::vector<TypeDesc> ptypes = {
+        TypeDesc { 1.0, 1.0, 5.0, 0.01, 0.0 },
+        TypeDesc { 2.0, 1.2, 3.0, 0.01, 0.0 },
+    };
+
+    Environment env;
+    env.set_r_cutoff(2.5);
+    env.set_domain_size({ 10.0, 10.0, 10.0 });
+
+    Environment env_mixed = env;
+    env_mixed.set_precision(MIXED_PRECISION);
+
+    // Test the direct sum, the linked cells and the verlet lists
+    for (const auto& [is_infinite, skin] : { std::pair { true, 0.0 }, std::pair { false, 0.0 }, std::pair { false, 0.5 } }) {
+        env.set_skin(skin);
+        env_mixed.set_skin(skin);
+
+        physicsCalculator::LJCalculator calc(env, particles, ptypes, true, is_infinite);
+        physicsCalculator::LJCalculator calc_mixed(env_mixed, particles, ptypes, true, is_infinite);
+
+        // The net forces cancel the much larger pair forces, such that the error is relative to the largest force
+        double max_force = 0.0;
+
+        for (size_t i = 0; i < particles.size(); i++) {
+            max_force = std::max(max_force, calc.get_container()[i].getF().len());
+        }
+
+        for (size_t i = 0; i < particles.size(); i++) {
+            const Vec<double>& f = calc.get_container()[i].getF();
+            const Vec<double>& f_mixed = calc_mixed.get_container()[i].getF();
+
+            EXPECT_LT((f - f_mixed).len(), error_margin * max_force) << "The mixed precision forces must match the double precision forces.";
+        }
+
+        EXPECT_GT(calc_mixed.get_container()[0].getF().len(), 1E-3) << "The force must be computed.";
+    }
+}
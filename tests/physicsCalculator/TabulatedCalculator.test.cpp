@@ -0,0 +1,134 @@
+#include <cmath>
+#include <gtest/gtest.h>
+#include <physicsCalculator/ForceTable.h>
+#include <physicsCalculator/LJCalculator.h>
+#include <physicsCalculator/TabulatedCalculator.h>
+
+// Test if the cubic spline reproduces a cubic polynomial exactly
+TEST(ForceTable, CubicPolynomial) {
+    // Set the margin for the maximum floatingpoint error
+    const double error_margin = 1E-9;
+
+    const auto cubic = [](const double x) { return 2.0 - x + 0.5 * x * x - 0.25 * x * x * x; };
+    const auto slope = [](const double x) { return -1.0 + x - 0.75 * x * x; };
+
+    std::vector<double> x = { 0.0, 0.5, 1.5, 2.0, 3.5 };
+    std::vector<double> y;
+
+    for (const double k : x) {
+        y.push_back(cubic(k));
+    }
+
+    // The spline clamped to the exact slopes is the cubic polynomial itself, such that its moments are its second derivatives
+    const double slopes[2] = { slope(x.front()), slope(x.back()) };
+    const std::vector<double> m = physicsCalculator::ForceTable::spline_moments(x, y, slopes);
+
+    for (size_t k = 0; k < x.size(); k++) {
+        EXPECT_NEAR(m[k], 1.0 - 1.5 * x[k], error_margin) << "The moments must match the second derivative.";
+    }
+
+    // The tabulated function is interpolated exactly between the grid points, apart from the one sided slopes at the ends
+    physicsCalculator::ForceTable table(2, 1.0, 2.0, 64);
+    table.tabulate(0, 1, [&](const double dist_squ) { return cubic(dist_squ); });
+
+    for (const double dist_squ : { 1.0, 1.3, 2.2, 3.05, 3.999 }) {
+        EXPECT_NEAR(table.evaluate(0, 1, dist_squ), cubic(dist_squ), error_margin) << "The spline must interpolate the cubic polynomial.";
+        EXPECT_NEAR(table.evaluate(1, 0, dist_squ), cubic(dist_squ), error_margin) << "The type pair must be stored for both orders.";
+        EXPECT_EQ(table.evaluate(0, 0, dist_squ), 0.0) << "The forces of the other type pairs must vanish.";
+    }
+
+    EXPECT_NEAR(table.evaluate(0, 1, 0.5), cubic(1.0), error_margin) << "The distances below the grid must be clamped.";
+    EXPECT_EQ(table.evaluate(0, 1, 4.0), 0.0) << "The forces must vanish beyond the grid.";
+}
+
+// Test if the tabulated Lenard-Jones forces match the Lenard-Jones calculator
+TEST(TabulatedCalculator, LennardJones) {
+    // Set the margin for the maximum relative error of the interpolation
+    const double error_margin = 1E-6;
+
+    // Initialize a distorted lattice of particles with two types
+    std::vector<Particle> particles;
+
+    for (size_t i = 0; i < 6; i++) {
+        for (size_t j = 0; j < 6; j++) {
+            for (size_t k = 0; k < 6; k++) {
+                particles.push_back(Particle({ 0.6 + 1.1 * i + 0.05 * j, 0.6 + 1.1 * j + 0.03 * k, 0.6 + 1.1 * k + 0.04 * i }, {}, (i + j + k) % 2));
+            }
+        }
+    }
+
+    std::vector<TypeDesc> ptypes = {
+        TypeDesc { 1.0, 1.0, 5.0, 0.01, 0.0 },
+        TypeDesc { 2.0, 1.2, 3.0, 0.01, 0.0 },
+    };
+
+    Environment env;
+    env.set_r_cutoff(2.5);
+    env.set_domain_size({ 10.0, 10.0, 10.0 });
+    env.set_calculator_type(TABULATED);
+
+    // Test the linked cells and the verlet lists, the direct sum is only equal for particles closer than the cutoff radius
+    for (const double skin : { 0.0, 0.5 }) {
+        env.set_skin(skin);
+        physicsCalculator::LJCalculator calc(env, particles, ptypes, true, false);
+        physicsCalculator::TabulatedCalculator calc_tabulated(env, particles, ptypes, true, false);
+
+        for (size_t i = 0; i < particles.size(); i++) {
+            const Vec<double>& f = calc.get_container()[i].getF();
+            const Vec<double>& f_tabulated = calc_tabulated.get_container()[i].getF();
+
+            EXPECT_LT((f - f_tabulated).len(), error_margin * std::max(f.len(), 1.0)) << "The tabulated forces must match the Lenard-Jones forces.";
+        }
+
+        EXPECT_GT(calc_tabulated.get_container()[0].getF().len(), 1E-3) << "The force must be computed.";
+    }
+
+    physicsCalculator::TabulatedCalculator calc_tabulated(env, particles, ptypes, false);
+
+    for (const double dist : { 0.9, 1.0, 1.12, 1.5, 2.0, 2.49 }) {
+        for (const int t : { 0, 1 }) {
+            const double force = calc_tabulated.physicsCalculator::LJCalculator::calculateFDist(dist * dist, 0, t);
+            EXPECT_NEAR(calc_tabulated.calculateFDist(dist * dist, 0, t), force, error_margin * std::abs(force))
+                << "The tabulated force must match the Lenard-Jones force.";
+        }
+    }
+
+    EXPECT_EQ(calc_tabulated.calculateFDist(2.6 * 2.6, 0, 1), 0.0) << "The tabulated forces must vanish beyond the cutoff radius.";
+}
+
+// Test if the forces of a table file are interpolated and the missing type pairs use the Lenard-Jones forces
+TEST(TabulatedCalculator, TableFile) {
+    // Set the margin for the maximum relative error of the interpolation
+    const double error_margin = 1E-4;
+
+    std::vector<TypeDesc> ptypes = {
+        TypeDesc { 1.0, 1.0, 5.0, 0.01, 0.0 },
+        TypeDesc { 2.0, 1.2, 3.0, 0.01, 0.0 },
+    };
+
+    Environment env;
+    env.set_r_cutoff(3.0);
+    env.set_calculator_type(TABULATED);
+    env.set_table_file("../tests/res/testMorseTable.txt");
+
+    physicsCalculator::TabulatedCalculator calc(env, {}, ptypes, false);
+
+    // The table file samples the Morse potential of the type pair 0 0
+    for (const double dist : { 0.8, 1.0, 1.1, 1.234, 1.9, 2.75 }) {
+        const double e = std::exp(-2.0 * (dist - 1.1));
+        const double force = 2.0 * 5.0 * 2.0 * e * (1.0 - e) / dist;
+        EXPECT_NEAR(calc.calculateFDist(dist * dist, 0, 0), force, error_margin * std::max(std::abs(force), 1.0))
+            << "The tabulated force must match the Morse force.";
+    }
+
+    for (const double dist : { 1.0, 1.5, 2.5 }) {
+        const double force = calc.physicsCalculator::LJCalculator::calculateFDist(dist * dist, 0, 1);
+        EXPECT_NEAR(calc.calculateFDist(dist * dist, 1, 0), force, error_margin * std::abs(force))
+            << "The type pairs missing in the file must use the Lenard-Jones force.";
+    }
+
+    // A missing table file must be recognized
+    env.set_table_file("../tests/res/missingTable.txt");
+
+    ASSERT_EXIT(physicsCalculator::TabulatedCalculator(env, {}, ptypes, false), testing::ExitedWithCode(EXIT_FAILURE), "");
+}
@@ -0,0 +1,59 @@
+#include <gtest/gtest.h>
+#include <utils/Numa.h>
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+// Test if the cpu lists of the sysfs are parsed correctly
+TEST(Numa, ParseCpuList) {
+    EXPECT_EQ(Numa::parse_cpu_list("0-3,8,10-11\n"), std::vector<size_t>({ 0, 1, 2, 3, 8, 10, 11 })) << "The ranges must be expanded.";
+    EXPECT_EQ(Numa::parse_cpu_list("5"), std::vector<size_t>({ 5 })) << "A single cpu must be parsed.";
+    EXPECT_TRUE(Numa::parse_cpu_list("").empty()) << "A node without cpus must not have any cpus.";
+}
+
+// Test if the topology is read from a sysfs like directory and ordered by the pinning strategies
+TEST(Numa, Topology) {
+    const std::filesystem::path sys = std::filesystem::temp_directory_path() / "molsim_numa_test";
+    std::filesystem::remove_all(sys);
+
+    // Without any node or cpu information the topology is unknown
+    EXPECT_TRUE(Numa::read_topology(sys.string()).empty());
+
+    // Without the nodes, the online cpus form a single node
+    std::filesystem::create_directories(sys / "cpu");
+    std::ofstream(sys / "cpu" / "online") << "0-3\n";
+
+    EXPECT_EQ(Numa::read_topology(sys.string()), std::vector<std::vector<size_t>>({ { 0, 1, 2, 3 } }));
+
+    // A node without cpus (e.g. memory only) is skipped
+    for (const auto& [node, list] : { std::make_pair("node0", "0-1,4-5\n"), std::make_pair("node1", "2-3,6\n"), std::make_pair("node2", "\n") }) {
+        std::filesystem::create_directories(sys / "node" / node);
+        std::ofstream(sys / "node" / node / "cpulist") << list;
+    }
+
+    const std::vector<std::vector<size_t>> topology = Numa::read_topology(sys.string());
+    std::filesystem::remove_all(sys);
+
+    ASSERT_EQ(topology, std::vector<std::vector<size_t>>({ { 0, 1, 4, 5 }, { 2, 3, 6 } })) << "The cpus of every node must be read.";
+    EXPECT_EQ(Numa::order_cpus(topology, COMPACT), std::vector<size_t>({ 0, 1, 4, 5, 2, 3, 6 })) << "The nodes must be filled one after another.";
+    EXPECT_EQ(Numa::order_cpus(topology, SCATTER), std::vector<size_t>({ 0, 2, 1, 3, 4, 6, 5 })) << "The nodes must be used in turn.";
+    EXPECT_TRUE(Numa::order_cpus(topology, NO_PINNING).empty()) << "The threads must not be pinned.";
+}
+
+// Test if moving the pages of a vector keeps its content
+TEST(Numa, FirstTouch) {
+    std::vector<size_t> values(1 << 20);
+
+    for (size_t i = 0; i < values.size(); i++) {
+        values[i] = 3 * i + 1;
+    }
+
+    for (const bool huge_pages : { false, true }) {
+        Numa::first_touch(values, huge_pages);
+
+        for (size_t i = 0; i < values.size(); i++) {
+            ASSERT_EQ(values[i], 3 * i + 1) << "The content must be restored after the pages were released (huge pages " << huge_pages << ").";
+        }
+    }
+}
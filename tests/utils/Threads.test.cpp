@@ -0,0 +1,34 @@
+#include <gtest/gtest.h>
+#include <utils/Threads.h>
+
+#include <cmath>
+
+// Test if the deterministic sum adds every term once and does not depend on the number of threads
+TEST(Threads, DeterministicSum) {
+    const size_t n = 10 * Threads::sum_block_size + 17;
+    const auto term = [](const size_t i) { return 1.0 / (1.0 + static_cast<double>(i)); };
+
+    double expected = 0.0;
+
+    for (size_t i = 0; i < n; i++) {
+        expected += term(i);
+    }
+
+    EXPECT_EQ(Threads::deterministic_sum(0, term), 0.0) << "An empty range must sum up to zero.";
+    EXPECT_NEAR(Threads::deterministic_sum(n, term), expected, 1e-12 * expected) << "The sum must contain every term.";
+
+#ifdef _OPENMP
+    const int max_threads = omp_get_max_threads();
+    std::vector<double> sums;
+
+    for (const int threads : { 1, 2, 3 }) {
+        omp_set_num_threads(threads);
+        sums.push_back(Threads::deterministic_sum(n, term));
+    }
+
+    omp_set_num_threads(max_threads);
+
+    EXPECT_EQ(sums[0], sums[1]) << "The sum must not depend on the number of threads.";
+    EXPECT_EQ(sums[0], sums[2]) << "The sum must not depend on the number of threads.";
+#endif
+}